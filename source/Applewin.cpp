@@ -33,6 +33,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "Debug.h"
 #include "Disk.h"
 #include "DiskImage.h"
+#include "DiskImageIndex.h"
 #include "Frame.h"
 #include "Harddisk.h"
 #include "Joystick.h"
@@ -102,6 +103,9 @@ DWORD       g_dwCyclesThisFrame = 0;
 bool		g_bDisableDirectInput = false;
 bool		g_bDisableDirectSound = false;
 bool		g_bDisableDirectSoundMockingboard = false;
+bool		g_bHeadless = false;
+static unsigned __int64 g_nHeadlessMaxCycles = 0;	// 0 = run until the emulated machine stops (eg. enters debugger)
+static bool	g_bVideoRenderThread = false;	// Cmd line switch: render video on a 2nd thread, a frame behind the CPU
 int			g_nMemoryClearType = MIP_FF_FF_00_00; // Note: -1 = random MIP in Memory.cpp MemReset()
 
 IPropertySheet&		sg_PropertySheet = * new CPropertySheet;
@@ -146,9 +150,9 @@ void LogFileTimeUntilFirstKeyRead(void)
 	if (!g_fh || bLogKeyReadDone)
 		return;
 
-	if ( (mem[regs.pc-3] != 0x2C)	// AZTEC: bit $c000
-		&& !((regs.pc-2) == 0xE797 && mem[regs.pc-2] == 0xB1 && mem[regs.pc-1] == 0x50)	// Phasor1: lda ($50),y
-		&& !((regs.pc-3) == 0x0895 && mem[regs.pc-3] == 0xAD)	// Rescue Raiders v1.3,v1.5: lda $c000
+	if ( (*MemGetReadPtr(regs.pc-3) != 0x2C)	// AZTEC: bit $c000
+		&& !((regs.pc-2) == 0xE797 && *MemGetReadPtr(regs.pc-2) == 0xB1 && *MemGetReadPtr(regs.pc-1) == 0x50)	// Phasor1: lda ($50),y
+		&& !((regs.pc-3) == 0x0895 && *MemGetReadPtr(regs.pc-3) == 0xAD)	// Rescue Raiders v1.3,v1.5: lda $c000
 		)
 		return;
 
@@ -272,11 +276,15 @@ static void ContinueExecution(void)
 	}
 
 	const bool bWasFullSpeed = g_bFullSpeed;
+	const bool bDiskFullSpeed = sg_Disk2Card.IsConditionForFullSpeed();
 	g_bFullSpeed =	 (g_dwSpeed == SPEED_MAX) || 
 					 bScrollLock_FullSpeed ||
-					 (sg_Disk2Card.IsConditionForFullSpeed() && !Spkr_IsActive() && !MB_IsActive()) ||
+					 (bDiskFullSpeed && !Spkr_IsActive() && !MB_IsActive()) ||
 					 IsDebugSteppingAtFullSpeed();
 
+	// Audio vetoed full-speed for the disk, so just speed up the disk's code (see CpuDiskAccel())
+	CpuSetDiskAccelActive(bDiskFullSpeed && !g_bFullSpeed && sg_Disk2Card.IsConditionForDiskAccel());
+
 	if (g_bFullSpeed)
 	{
 		if (!bWasFullSpeed)
@@ -298,7 +306,11 @@ static void ContinueExecution(void)
 	else
 	{
 		if (bWasFullSpeed)
+		{
 			VideoRedrawScreenAfterFullSpeed(g_dwCyclesThisFrame);
+			if (VideoGetFullSpeedFramesSkipped())
+				LogFileOutput("Full-speed: skipped redraw of %u video frames\n", VideoGetFullSpeedFramesSkipped());
+		}
 
 		// Don't call Spkr_Demute()
 		MB_Demute();
@@ -317,11 +329,15 @@ static void ContinueExecution(void)
 	const DWORD uCyclesToExecute = (g_nAppMode == MODE_RUNNING)		? uCyclesToExecuteWithFeedback
 												/* MODE_STEPPING */ : 0;
 
-	const bool bVideoUpdate = !g_bFullSpeed;
+	// Video pipeline: the CPU just logs the video mode changes & video page stores, and the frame is rendered by the render thread at the end of the frame
+	const bool bVideoPipeline = NTSC_VideoPipelineSetActive(g_bVideoRenderThread && !g_bFullSpeed && g_nAppMode == MODE_RUNNING);
+
+	const bool bVideoUpdate = !g_bFullSpeed && !bVideoPipeline;
 	const DWORD uActualCyclesExecuted = CpuExecute(uCyclesToExecute, bVideoUpdate);
 	g_dwCyclesThisFrame += uActualCyclesExecuted;
 
 	sg_Disk2Card.UpdateDriveState(uActualCyclesExecuted);
+	HD_UpdateDriveState(uActualCyclesExecuted);
 	JoyUpdateButtonLatch(nExecutionPeriodUsec);	// Button latch time is independent of CPU clock frequency
 	PrintUpdate(uActualCyclesExecuted);
 
@@ -354,7 +370,16 @@ static void ContinueExecution(void)
 	{
 		g_dwCyclesThisFrame -= dwClksPerFrame;
 
-		if (g_bFullSpeed)
+		if (bVideoPipeline)
+		{
+			NTSC_VideoPipelineWaitFrame();		// Previous frame has now been rendered...
+			if (!g_bHeadless)
+				VideoRefreshScreen();			// ... so copy it to the system Back Buffer
+			NTSC_VideoPipelineSubmitFrame();	// Render this frame while the next is emulated
+		}
+		else if (g_bHeadless)
+			;	// Null video: no frame window to copy the Apple framebuffer to
+		else if (g_bFullSpeed)
 			VideoRedrawScreenDuringFullSpeed(g_dwCyclesThisFrame);
 		else
 			VideoRefreshScreen(); // Just copy the output of our Apple framebuffer to the system Back Buffer
@@ -469,6 +494,56 @@ void EnterMessageLoop(void)
 	}
 }
 
+//===========================================================================
+
+// Headless: there's no frame window, so WM_CREATE/WM_DESTROY never happen.
+// . Do the subset of their init/teardown that the emulation core needs (ie. no GDI, DirectSound or DirectInput)
+static void HeadlessCreate(void)
+{
+	MB_Initialize();
+	SpkrInitialize();
+}
+
+static void HeadlessDestroy(void)
+{
+	Snapshot_Shutdown();
+	DebugDestroy();
+	sg_Disk2Card.Destroy();
+	ImageDestroy();
+	HD_Destroy();
+	PrintDestroy();
+	sg_SSC.CommDestroy();
+	CpuDestroy();
+	MemDestroy();
+	SpkrDestroy();
+	VideoDestroy();
+	MB_Destroy();
+}
+
+// Replaces EnterMessageLoop() for -headless: boot and run the emulation core flat-out (no message pump)
+static void EnterHeadlessLoop(void)
+{
+	sg_Disk2Card.Boot();
+	LogFileTimeUntilFirstKeyReadReset();
+	g_nAppMode = MODE_RUNNING;
+
+	const unsigned __int64 nStartCycles = g_nCumulativeCycles;
+	const DWORD dwStartTime = GetTickCount();
+
+	while (g_nAppMode == MODE_RUNNING)
+	{
+		ContinueExecution();
+
+		if (g_nHeadlessMaxCycles && (g_nCumulativeCycles - nStartCycles) >= g_nHeadlessMaxCycles)
+			break;
+	}
+
+	const unsigned __int64 nCycles = g_nCumulativeCycles - nStartCycles;
+	const DWORD dwElapsedTime = GetTickCount() - dwStartTime;
+	const double fMHz = dwElapsedTime ? (double)nCycles / ((double)dwElapsedTime * 1000.0) : 0.0;
+	LogFileOutput("Headless: executed %I64u cycles in %d msec (%.2f MHz)\n", nCycles, dwElapsedTime, fMHz);
+}
+
 //===========================================================================
 void GetProgramDirectory(void)
 {
@@ -550,8 +625,7 @@ void LoadConfiguration(void)
 
 			LogFileOutput("%s\n", sText);
 
-			MessageBox(
-				GetDesktopWindow(),		// NB. g_hFrameWindow is not yet valid
+			FrameMessageBox(		// NB. g_hFrameWindow is not yet valid
 				sText,
 				"Load Configuration",
 				MB_ICONSTOP | MB_SETFOREGROUND);
@@ -1076,6 +1150,14 @@ static std::string GetFullPath(LPCSTR szFileName)
 		strPathName.append(szFileName);
 	}
 
+	// No such file: so try it as a name in the image index (see -image-index)
+	if (GetFileAttributes(strPathName.c_str()) == INVALID_FILE_ATTRIBUTES)
+	{
+		std::vector<const ImageIndexEntry*> vecEntries;
+		if (ImageIndexFind(szFileName, vecEntries))
+			strPathName = vecEntries[0]->strPathname;
+	}
+
 	return strPathName;
 }
 
@@ -1119,7 +1201,7 @@ static void InsertFloppyDisks(LPSTR szImageName_drive[NUM_DRIVES], bool& bBoot)
 	}
 
 	if (!bRes)
-		MessageBox(g_hFrameWindow, "Failed to insert floppy disk(s) - see log file", "Warning", MB_ICONASTERISK | MB_OK);
+		FrameMessageBox("Failed to insert floppy disk(s) - see log file", "Warning", MB_ICONASTERISK | MB_OK);
 }
 
 static void InsertHardDisks(LPSTR szImageName_harddisk[NUM_HARDDISKS], bool& bBoot)
@@ -1157,7 +1239,7 @@ static void InsertHardDisks(LPSTR szImageName_harddisk[NUM_HARDDISKS], bool& bBo
 	}
 
 	if (!bRes)
-		MessageBox(g_hFrameWindow, "Failed to insert harddisk(s) - see log file", "Warning", MB_ICONASTERISK | MB_OK);
+		FrameMessageBox("Failed to insert harddisk(s) - see log file", "Warning", MB_ICONASTERISK | MB_OK);
 }
 
 static bool CheckOldAppleWinVersion(void)
@@ -1206,6 +1288,8 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 	int newVideoStyleDisableMask = 0;
 	VideoRefreshRate_e newVideoRefreshRate = VR_NONE;
 	LPSTR szScreenshotFilename = NULL;
+	LPSTR szScanImagesDirectory = NULL;
+	LPSTR szScanImagesIndex = NULL;
 
 	while (*lpCmdLine)
 	{
@@ -1296,6 +1380,87 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 		{
 			g_bDisableDirectSoundMockingboard = true;
 		}
+		else if (strcmp(lpCmdLine, "-headless") == 0)	// No window: null video/audio/input, run at full-speed
+		{
+			g_bHeadless = true;
+			g_bDisableDirectInput = true;
+			g_bDisableDirectSound = true;
+			g_bRegisterFileTypes = false;
+		}
+		else if (strcmp(lpCmdLine, "-headless-cycles") == 0)	// Exit after this many emulated cycles
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			g_nHeadlessMaxCycles = _strtoui64(lpCmdLine, NULL, 10);
+		}
+		else if (strcmp(lpCmdLine, "-cpu-predecode") == 0)	// Use the pre-decoded 6502/65C02 core
+		{
+			CpuSetPredecode(true);
+		}
+		else if (strcmp(lpCmdLine, "-cpu-predecode-blocks") == 0)	// ... and run basic blocks when at full-speed
+		{
+			CpuSetPredecode(true, true);
+		}
+		else if (strcmp(lpCmdLine, "-idle-loop-skip") == 0)	// Skip iterations of keyboard/VBL polling loops
+		{
+			CpuSetIdleLoopSkip(true);
+		}
+		else if (strcmp(lpCmdLine, "-video-thread") == 0)	// Render each video frame on a 2nd thread, while the next frame is emulated
+		{
+			g_bVideoRenderThread = true;
+		}
+		else if (strcmp(lpCmdLine, "-full-speed-fps") == 0)	// Max redraws per second when running at full-speed (0 = none until full-speed ends)
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			char* pEnd = NULL;
+			const long nValue = strtol(lpCmdLine, &pEnd, 10);
+			if (pEnd != lpCmdLine && *pEnd == 0 && nValue >= 0 && nValue <= 1000)
+				VideoSetFullSpeedMaxFps((UINT)nValue);
+			else
+				LogFileOutput("Invalid cmd-line parameter for -full-speed-fps switch (expected 0..1000)\n");
+		}
+		else if (strcmp(lpCmdLine, "-full-speed-frames") == 0)	// Redraw every Nth video frame when running at full-speed
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			char* pEnd = NULL;
+			const long nValue = strtol(lpCmdLine, &pEnd, 10);
+			if (pEnd != lpCmdLine && *pEnd == 0 && nValue >= 0 && nValue <= 1000)
+				VideoSetFullSpeedFrameInterval((UINT)nValue);
+			else
+				LogFileOutput("Invalid cmd-line parameter for -full-speed-frames switch (expected 0..1000)\n");
+		}
+		else if (strcmp(lpCmdLine, "-fast-disk") == 0)	// Satisfy DOS 3.3 RWTS & ProDOS Disk II driver requests at the sector level
+		{
+			CpuSetFastDisk(true);
+		}
+		else if (strcmp(lpCmdLine, "-fast-disk-cycles") == 0)	// Cycles charged per 256-byte sector in fast disk mode
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			CpuSetFastDiskCycles(atoi(lpCmdLine));
+		}
+		else if (strcmp(lpCmdLine, "-disk-accel") == 0)	// Speed up just the disk's code when audio prevents full-speed
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			CpuSetDiskAccel(atoi(lpCmdLine));
+		}
+		else if (strcmp(lpCmdLine, "-scan-images") == 0)	// Index a directory tree of images, then exit
+		{
+			szScanImagesDirectory = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			szScanImagesIndex = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+		}
+		else if (strcmp(lpCmdLine, "-image-index") == 0)	// Use an index from -scan-images
+		{
+			lpCmdLine = GetCurrArg(lpNextArg);
+			lpNextArg = GetNextArg(lpNextArg);
+			if (!ImageIndexLoad(lpCmdLine))
+				LogFileOutput("Failed to load image index: %s\n", lpCmdLine);
+		}
 		else if (strcmp(lpCmdLine, "-memclear") == 0)
 		{
 			lpCmdLine = GetCurrArg(lpNextArg);
@@ -1353,7 +1518,7 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 			{
 				std::string msg = "Failed to load video rom (not found or not exactly 2/4/8/16KiB)\n";
 				LogFileOutput("%s", msg.c_str());
-				MessageBox(g_hFrameWindow, msg.c_str(), TEXT("AppleWin Error"), MB_OK);
+				FrameMessageBox(msg.c_str(), TEXT("AppleWin Error"), MB_OK);
 			}
 			else
 			{
@@ -1469,6 +1634,14 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 
 	LogFileOutput("CmdLine: %s\n",  strCmdLine.c_str());
 
+	if (szScanImagesDirectory && *szScanImagesDirectory && *szScanImagesIndex)
+	{
+		const UINT uNumImages = ImageIndexScan(szScanImagesDirectory, szScanImagesIndex);
+		LogFileOutput("Scan images: indexed %d images\n", uNumImages);
+		LogDone();
+		return uNumImages ? 0 : 1;
+	}
+
 #if 0
 #ifdef RIFF_SPKR
 	RiffInitWriteFile("Spkr.wav", SPKR_SAMPLE_RATE, 1);
@@ -1585,6 +1758,9 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 			SetCurrentCLK6502();
 		}
 
+		if (g_bHeadless)
+			g_dwSpeed = SPEED_MAX;	// Nothing to pace against, so always run at full-speed
+
 		// Apply the memory expansion switches after loading the Apple II machine type
 #ifdef RAMWORKS
 		if (uRamWorksExPages)
@@ -1616,9 +1792,17 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 		VideoInitialize(); // g_pFramebufferinfo been created now
 		LogFileOutput("Main: VideoInitialize()\n");
 
-		LogFileOutput("Main: FrameCreateWindow() - pre\n");
-		FrameCreateWindow();	// g_hFrameWindow is now valid
-		LogFileOutput("Main: FrameCreateWindow() - post\n");
+		if (g_bHeadless)
+		{
+			HeadlessCreate();	// NB. g_hFrameWindow remains NULL
+			LogFileOutput("Main: HeadlessCreate()\n");
+		}
+		else
+		{
+			LogFileOutput("Main: FrameCreateWindow() - pre\n");
+			FrameCreateWindow();	// g_hFrameWindow is now valid
+			LogFileOutput("Main: FrameCreateWindow() - post\n");
+		}
 
 		// Pre: may need g_hFrameWindow for MessageBox errors
 		// Post: may enable HDD, required for MemInitialize()->MemInitializeIO()
@@ -1637,7 +1821,7 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 		LogFileOutput("Main: MemInitialize()\n");
 
 		// Show About dialog after creating main window (need g_hFrameWindow)
-		if (bShowAboutDlg)
+		if (bShowAboutDlg && !g_bHeadless)
 		{
 			if (!AboutDlg())
 				bShutdown = true;															// Close everything down
@@ -1645,13 +1829,13 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 				RegSaveString(TEXT(REG_CONFIG), TEXT(REGVALUE_VERSION), 1, VERSIONSTRING);	// Only save version after user accepts license
 		}
 
-		if (g_bCapturePrintScreenKey)
+		if (g_bCapturePrintScreenKey && !g_bHeadless)
 		{
 			RegisterHotKeys();		// needs valid g_hFrameWindow
 			LogFileOutput("Main: RegisterHotKeys()\n");
 		}
 
-		if (g_bHookSystemKey)
+		if (g_bHookSystemKey && !g_bHeadless)
 		{
 			if (InitHookThread())	// needs valid g_hFrameWindow (for message pump)
 				LogFileOutput("Main: HookFilterForKeyboard()\n");
@@ -1665,7 +1849,7 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 
 		if (!bSysClkOK)
 		{
-			MessageBox(g_hFrameWindow, "DirectX failed to create SystemClock instance", TEXT("AppleWin Error"), MB_OK);
+			FrameMessageBox("DirectX failed to create SystemClock instance", TEXT("AppleWin Error"), MB_OK);
 			bShutdown = true;
 		}
 
@@ -1673,7 +1857,7 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 		{
 			std::string msg = "Failed to load custom F8 rom (not found or not exactly 2KiB)\n";
 			LogFileOutput("%s", msg.c_str());
-			MessageBox(g_hFrameWindow, msg.c_str(), TEXT("AppleWin Error"), MB_OK);
+			FrameMessageBox(msg.c_str(), TEXT("AppleWin Error"), MB_OK);
 			bShutdown = true;
 		}
 
@@ -1715,46 +1899,61 @@ int APIENTRY WinMain(HINSTANCE passinstance, HINSTANCE, LPSTR lpCmdLine, int)
 			bShutdown = true;
 		}
 
-		if (bShutdown)
+		if (g_bHeadless)
 		{
-			PostMessage(g_hFrameWindow, WM_DESTROY, 0, 0);	// Close everything down
-			// NB. If shutting down, then don't post any other messages (GH#286)
+			if (!bShutdown)
+			{
+				LogFileOutput("Main: EnterHeadlessLoop()\n");
+				EnterHeadlessLoop();
+				LogFileOutput("Main: LeaveHeadlessLoop()\n");
+			}
+
+			HeadlessDestroy();
+			LogFileOutput("Main: HeadlessDestroy()\n");
 		}
 		else
 		{
-			if (bSetFullScreen)
+			if (bShutdown)
+			{
+				PostMessage(g_hFrameWindow, WM_DESTROY, 0, 0);	// Close everything down
+				// NB. If shutting down, then don't post any other messages (GH#286)
+			}
+			else
 			{
-				if (bestWidth && bestHeight)
+				if (bSetFullScreen)
 				{
-					DEVMODE devMode;
-					memset(&devMode, 0, sizeof(devMode));
-					devMode.dmSize = sizeof(devMode);
-					devMode.dmPelsWidth = bestWidth;
-					devMode.dmPelsHeight = bestHeight;
-					devMode.dmFields = DM_PELSWIDTH | DM_PELSHEIGHT;
-
-					DWORD dwFlags = 0;
-					LONG res = ChangeDisplaySettings(&devMode, dwFlags);
-					if (res == 0)
-						bChangedDisplayResolution = true;
+					if (bestWidth && bestHeight)
+					{
+						DEVMODE devMode;
+						memset(&devMode, 0, sizeof(devMode));
+						devMode.dmSize = sizeof(devMode);
+						devMode.dmPelsWidth = bestWidth;
+						devMode.dmPelsHeight = bestHeight;
+						devMode.dmFields = DM_PELSWIDTH | DM_PELSHEIGHT;
+
+						DWORD dwFlags = 0;
+						LONG res = ChangeDisplaySettings(&devMode, dwFlags);
+						if (res == 0)
+							bChangedDisplayResolution = true;
+					}
+
+					PostMessage(g_hFrameWindow, WM_USER_FULLSCREEN, 0, 0);
+					bSetFullScreen = false;
 				}
 
-				PostMessage(g_hFrameWindow, WM_USER_FULLSCREEN, 0, 0);
-				bSetFullScreen = false;
+				if (bBoot)
+				{
+					PostMessage(g_hFrameWindow, WM_USER_BOOT, 0, 0);
+					bBoot = false;
+				}
 			}
 
-			if (bBoot)
-			{
-				PostMessage(g_hFrameWindow, WM_USER_BOOT, 0, 0);
-				bBoot = false;
-			}
+			// ENTER THE MAIN MESSAGE LOOP
+			LogFileOutput("Main: EnterMessageLoop()\n");
+			EnterMessageLoop();
+			LogFileOutput("Main: LeaveMessageLoop()\n");
 		}
 
-		// ENTER THE MAIN MESSAGE LOOP
-		LogFileOutput("Main: EnterMessageLoop()\n");
-		EnterMessageLoop();
-		LogFileOutput("Main: LeaveMessageLoop()\n");
-
 		if (g_bRestart)
 		{
 			bSetFullScreen = g_bRestartFullScreen;
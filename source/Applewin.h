@@ -49,6 +49,7 @@ extern DWORD      g_dwCyclesThisFrame;
 extern bool       g_bDisableDirectInput;				// Cmd line switch: don't init DI (so no DIMouse support)
 extern bool       g_bDisableDirectSound;				// Cmd line switch: don't init DS (so no MB/Speaker support)
 extern bool       g_bDisableDirectSoundMockingboard;	// Cmd line switch: don't init MB support
+extern bool       g_bHeadless;							// Cmd line switch: no window (null video/audio/input), run at full-speed
 extern int        g_nMemoryClearType;					// Cmd line switch: use specific MIP (Memory Initialization Pattern)
 
 extern SS_CARDTYPE g_Slot0;	// LC or Saturn in slot0
@@ -88,7 +88,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #include "Applewin.h"
 #include "CPU.h"
+#include "Disk.h"
 #include "Frame.h"
+#include "Keyboard.h"
 #include "Memory.h"
 #include "Mockingboard.h"
 #include "MouseInterface.h"
@@ -143,6 +145,8 @@ static volatile UINT32 g_bmIRQ = 0;
 static volatile UINT32 g_bmNMI = 0;
 static volatile BOOL g_bNmiFlank = FALSE; // Positive going flank on NMI line
 
+static bool g_bCpuVideoLog = false;	// Log stores to the video pages for the video pipeline (see VIDEO_W)
+
 //
 
 static eCpuType g_MainCPU = CPU_65C02;
@@ -359,13 +363,8 @@ static __forceinline void Fetch(BYTE& iOpcode, ULONG uExecutedCycles)
 #endif
 
 	iOpcode = ((PC & 0xF000) == 0xC000)
-	    ? IORead[(PC>>4) & 0xFF](PC,PC,0,0,uExecutedCycles)	// Fetch opcode from I/O memory, but params are still from mem[]
-		: *(mem+PC);
-
-#ifdef USE_SPEECH_API
-	if (PC == COUT && g_Speech.IsEnabled() && !g_bFullSpeed)
-		CaptureCOUT();
-#endif
+	    ? IORead[(PC>>4) & 0xFF](PC,PC,0,0,uExecutedCycles)	// Fetch opcode from I/O memory, but params are still from memread[]
+		: MEMREAD8(PC);
 
 	regs.pc++;
 }
@@ -386,7 +385,7 @@ static __forceinline void NMI(ULONG& uExecutedCycles, BOOL& flagc, BOOL& flagn,
 		EF_TO_AF
 		PUSH(regs.ps & ~AF_BREAK)
 		regs.ps = regs.ps | AF_INTERRUPT & ~AF_DECIMAL;
-		regs.pc = * (WORD*) (mem+0xFFFA);
+		regs.pc = MEMREAD16(0xFFFA);
 		UINT uExtraCycles = 0;	// Needed for CYC(a) macro
 		CYC(7)
 	}
@@ -406,52 +405,276 @@ static __forceinline void IRQ(ULONG& uExecutedCycles, BOOL& flagc, BOOL& flagn,
 		EF_TO_AF
 		PUSH(regs.ps & ~AF_BREAK)
 		regs.ps = regs.ps | AF_INTERRUPT & ~AF_DECIMAL;
-		regs.pc = * (WORD*) (mem+0xFFFE);
+		regs.pc = MEMREAD16(0xFFFE);
 		UINT uExtraCycles = 0;	// Needed for CYC(a) macro
 		CYC(7)
 	}
 }
 
-const int IRQ_CHECK_OPCODE_FULL_SPEED = 40;	// ~128 cycles (assume 3 cycles per opcode)
-static int g_fullSpeedOpcodeCount = IRQ_CHECK_OPCODE_FULL_SPEED;
+// Event scheduler:
+// . Devices register the cycle (in g_nCumulativeCycles terms) that they next need updating at, instead of being polled
+// . The CPU loop only calls CheckInterruptSources()->CpuServiceEvents() when the earliest deadline has been reached
+// . Only a handful of events, so a linear scan is quicker than a priority queue
+
+static unsigned __int64 g_aEventCycle[NUM_CPU_EVENTS];
+static bool g_aEventScheduled[NUM_CPU_EVENTS] = {0};
+static ULONG g_uNextEventCycle = 0;	// Earliest deadline, relative to the start of this CpuExecute() (ie. comparable with uExecutedCycles)
+
+static void UpdateNextEventCycle(void)
+{
+	const unsigned __int64 uStartCycle = g_nCumulativeCycles - g_nCyclesExecuted;	// Cycle at the start of this CpuExecute()
+	unsigned __int64 uNextCycle = uStartCycle + 0xFFFFFFFF;
+
+	for (UINT i=0; i<NUM_CPU_EVENTS; i++)
+	{
+		if (g_aEventScheduled[i] && g_aEventCycle[i] < uNextCycle)
+			uNextCycle = g_aEventCycle[i];
+	}
+
+	g_uNextEventCycle = (uNextCycle > uStartCycle) ? (ULONG)(uNextCycle - uStartCycle) : 0;
+}
+
+void CpuScheduleEvent(eCpuEvent event, unsigned __int64 uCycle)
+{
+	g_aEventCycle[event] = uCycle;
+	g_aEventScheduled[event] = true;
+	UpdateNextEventCycle();
+}
+
+void CpuCancelEvent(eCpuEvent event)
+{
+	g_aEventScheduled[event] = false;
+	UpdateNextEventCycle();
+}
+
+// Mouse card's VBL interrupt: schedule the next change of VBL'
+static void ScheduleVblEvent(ULONG uExecutedCycles)
+{
+	if (!sg_Mouse.IsActive())
+	{
+		g_aEventScheduled[CPU_EVENT_VBL] = false;
+		return;
+	}
+
+	CpuCalcCycles(uExecutedCycles);
+	g_aEventCycle[CPU_EVENT_VBL] = g_nCumulativeCycles + VideoGetCyclesUntilVblChange(uExecutedCycles);
+	g_aEventScheduled[CPU_EVENT_VBL] = true;
+}
+
+static void CpuServiceEvents(ULONG uExecutedCycles)
+{
+	CpuCalcCycles(uExecutedCycles);
+
+	for (UINT i=0; i<NUM_CPU_EVENTS; i++)
+	{
+		if (!g_aEventScheduled[i] || g_aEventCycle[i] > g_nCumulativeCycles)
+			continue;
+
+		g_aEventScheduled[i] = false;
+
+		switch (i)
+		{
+		case CPU_EVENT_MOCKINGBOARD:
+			MB_UpdateCycles(uExecutedCycles);	// Reschedules itself
+			break;
+		case CPU_EVENT_VBL:
+			if (sg_Mouse.IsActive())
+				sg_Mouse.SetVBlank( !VideoGetVblBar(uExecutedCycles) );
+			ScheduleVblEvent(uExecutedCycles);
+			break;
+		}
+	}
+
+	UpdateNextEventCycle();
+}
+
+static __forceinline void CheckInterruptSources(ULONG uExecutedCycles)
+{
+	if (uExecutedCycles >= g_uNextEventCycle)
+		CpuServiceEvents(uExecutedCycles);
+}
+
+// Idle-loop detection (see CPU/cpu_idleloop.inl)
+
+static bool g_bIdleLoopSkip = false;	// cmd-line: -idle-loop-skip
+static ULONG g_uIdleLoopEndCycle = 0;	// uTotalCycles for this CpuExecute()
+
+void CpuSetIdleLoopSkip(const bool bEnable)
+{
+	g_bIdleLoopSkip = bEnable;
+}
+
+#include "CPU/cpu_idleloop.inl"
+
+// Fast disk:
+// . Once per CpuExecute(), the DOS 3.3 RWTS and ProDOS Disk II driver entry points are found (see Disk2InterfaceCard::GetFastDiskTraps())
+// . When the PC reaches one, the Disk II card satisfies the request from the image and the CPU returns (RTS) to the caller,
+//   charging a fixed cost per sector instead of the cycles for the 6502 code to step the head & (de)nibblize each sector
+// . The basic-block core only checks at block starts, which is fine since the entry points are only reached via JSR/JMP
+
+static bool g_bFastDisk = false;			// cmd-line: -fast-disk
+static UINT g_uFastDiskCycles = 1000;		// cmd-line: -fast-disk-cycles <n>
+static const UINT kMaxFastDiskTraps = 3;	// RWTS + ProDOS drive 1 & 2
+static WORD g_aFastDiskTrap[kMaxFastDiskTraps] = {0};
+static bool g_bFastDiskArmed = false;
+
+void CpuSetFastDisk(const bool bEnable)
+{
+	g_bFastDisk = bEnable;
+}
+
+void CpuSetFastDiskCycles(const UINT uCyclesPerSector)
+{
+	g_uFastDiskCycles = uCyclesPerSector;
+}
 
-static __forceinline void CheckInterruptSources(ULONG uExecutedCycles, const bool bVideoUpdate)
+static void CpuArmFastDiskTraps(void)
 {
-	if (!bVideoUpdate)
+	const UINT uNumTraps = g_bFastDisk ? sg_Disk2Card.GetFastDiskTraps(g_aFastDiskTrap) : 0;
+	g_bFastDiskArmed = uNumTraps != 0;
+
+	for (UINT i = uNumTraps; i < kMaxFastDiskTraps && g_bFastDiskArmed; i++)
+		g_aFastDiskTrap[i] = g_aFastDiskTrap[0];	// Unused entries mustn't match PC=$0000
+}
+
+static __forceinline bool IsFastDiskTrap(const WORD pc)
+{
+	return g_bFastDiskArmed && (pc == g_aFastDiskTrap[0] || pc == g_aFastDiskTrap[1] || pc == g_aFastDiskTrap[2]);
+}
+
+static bool CpuFastDiskTrap(ULONG& uExecutedCycles, BOOL& flagc, BOOL& flagn, BOOL& flagz)
+{
+	BYTE a;
+	bool bError;
+	UINT uSectors;
+	if (!sg_Disk2Card.FastDiskTrap(regs.pc, a, bError, uSectors))
+		return false;
+
+	// RTS
+	const WORD lo = POP;
+	const WORD hi = POP;
+	regs.pc = ((hi << 8) | lo) + 1;
+
+	regs.a = a;
+	flagc = bError ? 1 : 0;
+	SETNZ(a)
+
+	uExecutedCycles += uSectors * g_uFastDiskCycles;
+	return true;
+}
+
+// Disk-only acceleration:
+// . Full-speed is vetoed while the speaker or Mockingboard is active (eg. a title tune playing during loading),
+//   so instead only the disk's 6502 code is sped up, while everything else (eg. the music's IRQ handler) keeps real-time pacing
+// . While active, an opcode near (+/- kDiskAccelWindow/2) the code that last read the Disk II's data latch is charged 1/factor of its cycles
+//   (with the remainder carried forward), so the emulated clock - and so audio & video - advances less while the RWTS is (de)nibblizing
+// . NB. Only for nibble images (the latch just returns the next nibble) - not for WOZ, where the LSS timing must stay cycle-exact
+
+static UINT g_uDiskAccelFactor = 0;			// cmd-line: -disk-accel <factor> (0 = off)
+static const WORD kDiskAccelWindow = 0x400;
+static bool g_bDiskAccelActive = false;
+static WORD g_uDiskAccelPC = 0;
+static UINT g_uDiskAccelRemainder = 0;
+static bool g_bDiskAccelLatchSeen = false;	// Data latch accessed since last deactivated (so g_uDiskAccelPC is valid)
+
+void CpuSetDiskAccel(const UINT uFactor)
+{
+	g_uDiskAccelFactor = (uFactor >= 2) ? uFactor : 0;
+}
+
+void CpuSetDiskAccelActive(const bool bActive)
+{
+	g_bDiskAccelActive = bActive && g_uDiskAccelFactor;
+
+	if (!g_bDiskAccelActive)
 	{
-		g_fullSpeedOpcodeCount--;
-		if (g_fullSpeedOpcodeCount >= 0)
-			return;
-		g_fullSpeedOpcodeCount = IRQ_CHECK_OPCODE_FULL_SPEED;
+		g_uDiskAccelPC = 0;
+		g_uDiskAccelRemainder = 0;
+		g_bDiskAccelLatchSeen = false;
 	}
+}
 
-	MB_UpdateCycles(uExecutedCycles);
-	if (sg_Mouse.IsActive())
-		sg_Mouse.SetVBlank( !VideoGetVblBar(uExecutedCycles) );
+void CpuDiskAccelLatchAccess(const WORD pc)
+{
+	g_uDiskAccelPC = pc;
+	g_bDiskAccelLatchSeen = true;
 }
 
-// GH#608: IRQ needs to occur within 17 cycles (6 opcodes) of configuring the timer interrupt
-void CpuAdjustIrqCheck(UINT uCyclesUntilInterrupt)
+static __forceinline void CpuDiskAccel(ULONG& uExecutedCycles, const ULONG uPreviousCycles, const WORD uOpcodePC)
 {
-	const UINT opcodesUntilInterrupt = uCyclesUntilInterrupt/3;	// assume 3 cycles per opcode
-	if (g_bFullSpeed && opcodesUntilInterrupt < IRQ_CHECK_OPCODE_FULL_SPEED)
-		g_fullSpeedOpcodeCount = opcodesUntilInterrupt;
+	if (!g_bDiskAccelActive || !g_bDiskAccelLatchSeen || (WORD)(uOpcodePC - g_uDiskAccelPC + kDiskAccelWindow/2) >= kDiskAccelWindow)
+		return;
+
+	// NB. Never goes back before a cycle already seen by an I/O handler (ie. g_nCyclesExecuted), since that was <= uPreviousCycles
+	g_uDiskAccelRemainder += uExecutedCycles - uPreviousCycles;
+	uExecutedCycles = uPreviousCycles + g_uDiskAccelRemainder / g_uDiskAccelFactor;
+	g_uDiskAccelRemainder %= g_uDiskAccelFactor;
 }
 
 //===========================================================================
 
+#include "CPU/cpu_core.h"  // Policy-based 6502 & 65C02 core
 #include "CPU/cpu6502.h"  // MOS 6502
 #include "CPU/cpu65C02.h" // WDC 65C02
+#include "CPU/cpu_predecode.h" // Pre-decoded 6502 & 65C02
 #include "CPU/cpu65d02.h" // Debug CPU Memory Visualizer
 
 //===========================================================================
 
+static bool g_bCpuPredecode = false;		// Use the pre-decoded core (cmd-line: -cpu-predecode)
+static bool g_bCpuPredecodeBlocks = false;	// ... and run basic blocks at full-speed (cmd-line: -cpu-predecode-blocks)
+static bool g_bCpuPredecodeStale = true;	// memory may have been modified without setting memdirty[] (eg. by the debugger)
+
+void CpuSetPredecode(const bool bEnable, const bool bBlocks)
+{
+	g_bCpuPredecode = bEnable;
+	g_bCpuPredecodeBlocks = bEnable && bBlocks;
+	g_bCpuPredecodeStale = true;
+}
+
+void CpuPredecodeInvalidate(void)
+{
+	g_bCpuPredecodeStale = true;
+}
+
 static DWORD InternalCpuExecute(const DWORD uTotalCycles, const bool bVideoUpdate)
 {
-	if (GetMainCpu() == CPU_6502)
-		return Cpu6502(uTotalCycles, bVideoUpdate);		// Apple ][, ][+, //e, Clones
-	else
-		return Cpu65C02(uTotalCycles, bVideoUpdate);	// Enhanced Apple //e
+	// Video pipeline: the render thread replays the logged stores, instead of video being updated per opcode
+	const bool bVideoLog = !bVideoUpdate && NTSC_VideoPipelineIsActive();
+	g_bCpuVideoLog = bVideoLog;
+
+	// Only when running: the debugger (single-stepping, benchmark, etc) uses the switch cores
+	if (g_bCpuPredecode && g_nAppMode == MODE_RUNNING)
+	{
+		if (g_bCpuPredecodeStale)
+		{
+			PredecodeInvalidateAll();
+			g_bCpuPredecodeStale = false;
+		}
+
+		const PredecodeHandler* pHandlers = (GetMainCpu() == CPU_6502) ? Predecode6502::g_aHandlers : Predecode65C02::g_aHandlers;
+
+		if (g_bCpuPredecodeBlocks && g_bFullSpeed)	// NB. not just !bVideoUpdate, eg. VideoBenchmark() or the video pipeline at normal speed
+			return CpuPredecodedBlocks(uTotalCycles, pHandlers);
+		else
+			return CpuPredecoded(uTotalCycles, bVideoUpdate, pHandlers);
+	}
+
+	g_bCpuPredecodeStale = true;
+
+	// NB. GetActiveCpu() may be CPU_Z80 after a restore of a save-state
+	const bool bZ80 = (g_Slot4 == CT_Z80) || (g_Slot5 == CT_Z80) || (GetActiveCpu() == CPU_Z80);
+#ifdef USE_SPEECH_API
+	const bool bSpeech = g_Speech.IsEnabled() && !g_bFullSpeed;
+#else
+	const bool bSpeech = false;
+#endif
+
+	const CpuCoreFunc pfnCpuCore = (GetMainCpu() == CPU_6502)
+		? SelectCpuCore<CPU_6502>(bVideoUpdate, bZ80, bSpeech, bVideoLog)	// Apple ][, ][+, //e, Clones
+		: SelectCpuCore<CPU_65C02>(bVideoUpdate, bZ80, bSpeech, bVideoLog);	// Enhanced Apple //e
+
+	return pfnCpuCore(uTotalCycles);
 }
 
 //
@@ -518,8 +741,12 @@ ULONG CpuGetCyclesThisVideoFrame(const ULONG nExecutedCycles)
 DWORD CpuExecute(const DWORD uCycles, const bool bVideoUpdate)
 {
 	g_nCyclesExecuted =	0;
+	g_uIdleLoopEndCycle = uCycles;
+	CpuArmFastDiskTraps();
 
 	MB_StartOfCpuExecute();
+	ScheduleVblEvent(0);
+	UpdateNextEventCycle();
 
 	// uCycles:
 	//  =0  : Do single step
@@ -571,17 +798,18 @@ void CpuSetupBenchmark ()
 		int opcode = 0;
 		do
 		{
-			*(mem+addr++) = benchopcode[opcode];
-			*(mem+addr++) = benchopcode[opcode];
+			MemWriteByte(addr++, benchopcode[opcode]);
+			MemWriteByte(addr++, benchopcode[opcode]);
 
 			if (opcode >= SHORTOPCODES)
-				*(mem+addr++) = 0;
+				MemWriteByte(addr++, 0);
 
 			if ((++opcode >= BENCHOPCODES) || ((addr & 0x0F) >= 0x0B))
 			{
-				*(mem+addr++) = 0x4C;
-				*(mem+addr++) = (opcode >= BENCHOPCODES) ? 0x00 : ((addr >> 4)+1) << 4;
-				*(mem+addr++) = 0x03;
+				MemWriteByte(addr++, 0x4C);
+				MemWriteByte(addr, (opcode >= BENCHOPCODES) ? 0x00 : ((addr >> 4)+1) << 4);
+				addr++;
+				MemWriteByte(addr++, 0x03);
 				while (addr & 0x0F)
 					++addr;
 			}
@@ -650,7 +878,7 @@ void CpuReset()
 {
 	// 7 cycles
 	regs.ps = (regs.ps | AF_INTERRUPT) & ~AF_DECIMAL;
-	regs.pc = * (WORD*) (mem+0xFFFC);
+	regs.pc = MEMREAD16(0xFFFC);
 	regs.sp = 0x0100 | ((regs.sp - 3) & 0xFF);
 
 	regs.bJammed = 0;
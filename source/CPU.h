@@ -14,13 +14,20 @@ struct regsrec
 extern regsrec    regs;
 extern unsigned __int64 g_nCumulativeCycles;
 
-void    CpuAdjustIrqCheck(UINT uCyclesUntilInterrupt);
 void    CpuDestroy ();
 void    CpuCalcCycles(ULONG nExecutedCycles);
 DWORD   CpuExecute(const DWORD uCycles, const bool bVideoUpdate);
 ULONG   CpuGetCyclesThisVideoFrame(ULONG nExecutedCycles);
 void    CpuInitialize ();
 void    CpuSetupBenchmark ();
+void    CpuSetPredecode(const bool bEnable, const bool bBlocks = false);
+void    CpuSetIdleLoopSkip(const bool bEnable);
+void    CpuSetFastDisk(const bool bEnable);
+void    CpuSetFastDiskCycles(const UINT uCyclesPerSector);
+void    CpuSetDiskAccel(const UINT uFactor);
+void    CpuSetDiskAccelActive(const bool bActive);
+void    CpuDiskAccelLatchAccess(const WORD pc);
+void    CpuPredecodeInvalidate(void);
 void	CpuIrqReset();
 void	CpuIrqAssert(eIRQSRC Device);
 void	CpuIrqDeassert(eIRQSRC Device);
@@ -34,6 +41,11 @@ void    CpuLoadSnapshot(class YamlLoadHelper& yamlLoadHelper);
 BYTE	CpuRead(USHORT addr, ULONG uExecutedCycles);
 void	CpuWrite(USHORT addr, BYTE a, ULONG uExecutedCycles);
 
+enum eCpuEvent {CPU_EVENT_MOCKINGBOARD=0, CPU_EVENT_VBL, NUM_CPU_EVENTS};
+
+void	CpuScheduleEvent(eCpuEvent event, unsigned __int64 uCycle);
+void	CpuCancelEvent(eCpuEvent event);
+
 enum eCpuType {CPU_UNKNOWN=0, CPU_6502=1, CPU_65C02, CPU_Z80};	// Don't change! Persisted to Registry
 
 eCpuType GetMainCpu(void);
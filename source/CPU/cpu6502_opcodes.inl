@@ -0,0 +1,283 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2011, Tom Charlesworth, Michael Pohoreski
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+// MOS 6502 opcode table
+// . One OPCODE(opcode, [$] addressing-mode instruction, cycles) entry per opcode ($ = undocumented/invalid opcode)
+// . Define OPCODE() before including this file: see Cpu6502()
+
+OPCODE( 0x00,              BRK  , 7 )
+OPCODE( 0x01,   idx        ORA  , 6 )
+OPCODE( 0x02, $            HLT  , 2 )
+OPCODE( 0x03, $ idx        ASO  , 8 )
+OPCODE( 0x04, $ ZPG        NOP  , 3 )
+OPCODE( 0x05,   ZPG        ORA  , 3 )
+OPCODE( 0x06,   ZPG        ASLn , 5 )
+OPCODE( 0x07, $ ZPG        ASO  , 5 )
+OPCODE( 0x08,              PHP  , 3 )
+OPCODE( 0x09,   IMM        ORA  , 2 )
+OPCODE( 0x0A,              asl  , 2 )
+OPCODE( 0x0B, $ IMM        ANC  , 2 )
+OPCODE( 0x0C, $ ABSX_OPT   NOP  , 4 )
+OPCODE( 0x0D,   ABS        ORA  , 4 )
+OPCODE( 0x0E,   ABS        ASLn , 6 )
+OPCODE( 0x0F, $ ABS        ASO  , 6 )
+OPCODE( 0x10,   REL        BPL  , 2 )
+OPCODE( 0x11,   INDY_OPT   ORA  , 5 )
+OPCODE( 0x12, $            HLT  , 2 )
+OPCODE( 0x13, $ INDY_CONST ASO  , 8 )
+OPCODE( 0x14, $ zpx        NOP  , 4 )
+OPCODE( 0x15,   zpx        ORA  , 4 )
+OPCODE( 0x16,   zpx        ASLn , 6 )
+OPCODE( 0x17, $ zpx        ASO  , 6 )
+OPCODE( 0x18,              CLC  , 2 )
+OPCODE( 0x19,   ABSY_OPT   ORA  , 4 )
+OPCODE( 0x1A, $            NOP  , 2 )
+OPCODE( 0x1B, $ ABSY_CONST ASO  , 7 )
+OPCODE( 0x1C, $ ABSX_OPT   NOP  , 4 )
+OPCODE( 0x1D,   ABSX_OPT   ORA  , 4 )
+OPCODE( 0x1E,   ABSX_CONST ASLn , 7 )
+OPCODE( 0x1F, $ ABSX_CONST ASO  , 7 )
+OPCODE( 0x20,   ABS        JSR  , 6 )
+OPCODE( 0x21,   idx        AND  , 6 )
+OPCODE( 0x22, $            HLT  , 2 )
+OPCODE( 0x23, $ idx        RLA  , 8 )
+OPCODE( 0x24,   ZPG        BIT  , 3 )
+OPCODE( 0x25,   ZPG        AND  , 3 )
+OPCODE( 0x26,   ZPG        ROLn , 5 )
+OPCODE( 0x27, $ ZPG        RLA  , 5 )
+OPCODE( 0x28,              PLP  , 4 )
+OPCODE( 0x29,   IMM        AND  , 2 )
+OPCODE( 0x2A,              rol  , 2 )
+OPCODE( 0x2B, $ IMM        ANC  , 2 )
+OPCODE( 0x2C,   ABS        BIT  , 4 )
+OPCODE( 0x2D,   ABS        AND  , 4 )
+OPCODE( 0x2E,   ABS        ROLn , 6 )
+OPCODE( 0x2F, $ ABS        RLA  , 6 )
+OPCODE( 0x30,   REL        BMI  , 2 )
+OPCODE( 0x31,   INDY_OPT   AND  , 5 )
+OPCODE( 0x32, $            HLT  , 2 )
+OPCODE( 0x33, $ INDY_CONST RLA  , 8 )
+OPCODE( 0x34, $ zpx        NOP  , 4 )
+OPCODE( 0x35,   zpx        AND  , 4 )
+OPCODE( 0x36,   zpx        ROLn , 6 )
+OPCODE( 0x37, $ zpx        RLA  , 6 )
+OPCODE( 0x38,              SEC  , 2 )
+OPCODE( 0x39,   ABSY_OPT   AND  , 4 )
+OPCODE( 0x3A, $            NOP  , 2 )
+OPCODE( 0x3B, $ ABSY_CONST RLA  , 7 )
+OPCODE( 0x3C, $ ABSX_OPT   NOP  , 4 )
+OPCODE( 0x3D,   ABSX_OPT   AND  , 4 )
+OPCODE( 0x3E,   ABSX_CONST ROLn , 6 )
+OPCODE( 0x3F, $ ABSX_CONST RLA  , 7 )
+OPCODE( 0x40,              RTI  , 6 )
+OPCODE( 0x41,   idx        EOR  , 6 )
+OPCODE( 0x42, $            HLT  , 2 )
+OPCODE( 0x43, $ idx        LSE  , 8 )
+OPCODE( 0x44, $ ZPG        NOP  , 3 )
+OPCODE( 0x45,   ZPG        EOR  , 3 )
+OPCODE( 0x46,   ZPG        LSRn , 5 )
+OPCODE( 0x47, $ ZPG        LSE  , 5 )
+OPCODE( 0x48,              PHA  , 3 )
+OPCODE( 0x49,   IMM        EOR  , 2 )
+OPCODE( 0x4A,              lsr  , 2 )
+OPCODE( 0x4B, $ IMM        ALR  , 2 )
+OPCODE( 0x4C,   ABS        JMP  , 3 )
+OPCODE( 0x4D,   ABS        EOR  , 4 )
+OPCODE( 0x4E,   ABS        LSRn , 6 )
+OPCODE( 0x4F, $ ABS        LSE  , 6 )
+OPCODE( 0x50,   REL        BVC  , 2 )
+OPCODE( 0x51,   INDY_OPT   EOR  , 5 )
+OPCODE( 0x52, $            HLT  , 2 )
+OPCODE( 0x53, $ INDY_CONST LSE  , 8 )
+OPCODE( 0x54, $ zpx        NOP  , 4 )
+OPCODE( 0x55,   zpx        EOR  , 4 )
+OPCODE( 0x56,   zpx        LSRn , 6 )
+OPCODE( 0x57, $ zpx        LSE  , 6 )
+OPCODE( 0x58,              CLI  , 2 )
+OPCODE( 0x59,   ABSY_OPT   EOR  , 4 )
+OPCODE( 0x5A, $            NOP  , 2 )
+OPCODE( 0x5B, $ ABSY_CONST LSE  , 7 )
+OPCODE( 0x5C, $ ABSX_OPT   NOP  , 4 )
+OPCODE( 0x5D,   ABSX_OPT   EOR  , 4 )
+OPCODE( 0x5E,   ABSX_CONST LSRn , 6 )
+OPCODE( 0x5F, $ ABSX_CONST LSE  , 7 )
+OPCODE( 0x60,              RTS  , 6 )
+OPCODE( 0x61,   idx        ADCn , 6 )
+OPCODE( 0x62, $            HLT  , 2 )
+OPCODE( 0x63, $ idx        RRA  , 8 )
+OPCODE( 0x64, $ ZPG        NOP  , 3 )
+OPCODE( 0x65,   ZPG        ADCn , 3 )
+OPCODE( 0x66,   ZPG        RORn , 5 )
+OPCODE( 0x67, $ ZPG        RRA  , 5 )
+OPCODE( 0x68,              PLA  , 4 )
+OPCODE( 0x69,   IMM        ADCn , 2 )
+OPCODE( 0x6A,              ror  , 2 )
+OPCODE( 0x6B, $ IMM        ARR  , 2 )
+OPCODE( 0x6C,   IABS_NMOS  JMP  , 5 ) // GH#264
+OPCODE( 0x6D,   ABS        ADCn , 4 )
+OPCODE( 0x6E,   ABS        RORn , 6 )
+OPCODE( 0x6F, $ ABS        RRA  , 6 )
+OPCODE( 0x70,   REL        BVS  , 2 )
+OPCODE( 0x71,   INDY_OPT   ADCn , 5 )
+OPCODE( 0x72, $            HLT  , 2 )
+OPCODE( 0x73, $ INDY_CONST RRA  , 8 )
+OPCODE( 0x74, $ zpx        NOP  , 4 )
+OPCODE( 0x75,   zpx        ADCn , 4 )
+OPCODE( 0x76,   zpx        RORn , 6 )
+OPCODE( 0x77, $ zpx        RRA  , 6 )
+OPCODE( 0x78,              SEI  , 2 )
+OPCODE( 0x79,   ABSY_OPT   ADCn , 4 )
+OPCODE( 0x7A, $            NOP  , 2 )
+OPCODE( 0x7B, $ ABSY_CONST RRA  , 7 )
+OPCODE( 0x7C, $ ABSX_OPT   NOP  , 4 )
+OPCODE( 0x7D,   ABSX_OPT   ADCn , 4 )
+OPCODE( 0x7E,   ABSX_CONST RORn , 6 )
+OPCODE( 0x7F, $ ABSX_CONST RRA  , 7 )
+OPCODE( 0x80, $ IMM        NOP  , 2 )
+OPCODE( 0x81,   idx        STA  , 6 )
+OPCODE( 0x82, $ IMM        NOP  , 2 )
+OPCODE( 0x83, $ idx        AXS  , 6 )
+OPCODE( 0x84,   ZPG        STY  , 3 )
+OPCODE( 0x85,   ZPG        STA  , 3 )
+OPCODE( 0x86,   ZPG        STX  , 3 )
+OPCODE( 0x87, $ ZPG        AXS  , 3 )
+OPCODE( 0x88,              DEY  , 2 )
+OPCODE( 0x89, $ IMM        NOP  , 2 )
+OPCODE( 0x8A,              TXA  , 2 )
+OPCODE( 0x8B, $ IMM        XAA  , 2 )
+OPCODE( 0x8C,   ABS        STY  , 4 )
+OPCODE( 0x8D,   ABS        STA  , 4 )
+OPCODE( 0x8E,   ABS        STX  , 4 )
+OPCODE( 0x8F, $ ABS        AXS  , 4 )
+OPCODE( 0x90,   REL        BCC  , 2 )
+OPCODE( 0x91,   INDY_CONST STA  , 6 )
+OPCODE( 0x92, $            HLT  , 2 )
+OPCODE( 0x93, $ INDY_CONST AXA  , 6 )
+OPCODE( 0x94,   zpx        STY  , 4 )
+OPCODE( 0x95,   zpx        STA  , 4 )
+OPCODE( 0x96,   zpy        STX  , 4 )
+OPCODE( 0x97, $ zpy        AXS  , 4 )
+OPCODE( 0x98,              TYA  , 2 )
+OPCODE( 0x99,   ABSY_CONST STA  , 5 )
+OPCODE( 0x9A,              TXS  , 2 )
+OPCODE( 0x9B, $ ABSY_CONST TAS  , 5 )
+OPCODE( 0x9C, $ ABSX_CONST SAY  , 5 )
+OPCODE( 0x9D,   ABSX_CONST STA  , 5 )
+OPCODE( 0x9E, $ ABSY_CONST XAS  , 5 )
+OPCODE( 0x9F, $ ABSY_CONST AXA  , 5 )
+OPCODE( 0xA0,   IMM        LDY  , 2 )
+OPCODE( 0xA1,   idx        LDA  , 6 )
+OPCODE( 0xA2,   IMM        LDX  , 2 )
+OPCODE( 0xA3, $ idx        LAX  , 6 )
+OPCODE( 0xA4,   ZPG        LDY  , 3 )
+OPCODE( 0xA5,   ZPG        LDA  , 3 )
+OPCODE( 0xA6,   ZPG        LDX  , 3 )
+OPCODE( 0xA7, $ ZPG        LAX  , 3 )
+OPCODE( 0xA8,              TAY  , 2 )
+OPCODE( 0xA9,   IMM        LDA  , 2 )
+OPCODE( 0xAA,              TAX  , 2 )
+OPCODE( 0xAB, $ IMM        OAL  , 2 )
+OPCODE( 0xAC,   ABS        LDY  , 4 )
+OPCODE( 0xAD,   ABS        LDA  , 4 )
+OPCODE( 0xAE,   ABS        LDX  , 4 )
+OPCODE( 0xAF, $ ABS        LAX  , 4 )
+OPCODE( 0xB0,   REL        BCS  , 2 )
+OPCODE( 0xB1,   INDY_OPT   LDA  , 5 )
+OPCODE( 0xB2, $            HLT  , 2 )
+OPCODE( 0xB3, $ INDY_OPT   LAX  , 5 )
+OPCODE( 0xB4,   zpx        LDY  , 4 )
+OPCODE( 0xB5,   zpx        LDA  , 4 )
+OPCODE( 0xB6,   zpy        LDX  , 4 )
+OPCODE( 0xB7, $ zpy        LAX  , 4 )
+OPCODE( 0xB8,              CLV  , 2 )
+OPCODE( 0xB9,   ABSY_OPT   LDA  , 4 )
+OPCODE( 0xBA,              TSX  , 2 )
+OPCODE( 0xBB, $ ABSY_OPT   LAS  , 4 )
+OPCODE( 0xBC,   ABSX_OPT   LDY  , 4 )
+OPCODE( 0xBD,   ABSX_OPT   LDA  , 4 )
+OPCODE( 0xBE,   ABSY_OPT   LDX  , 4 )
+OPCODE( 0xBF, $ ABSY_OPT   LAX  , 4 )
+OPCODE( 0xC0,   IMM        CPY  , 2 )
+OPCODE( 0xC1,   idx        CMP  , 6 )
+OPCODE( 0xC2, $ IMM        NOP  , 2 )
+OPCODE( 0xC3, $ idx        DCM  , 8 )
+OPCODE( 0xC4,   ZPG        CPY  , 3 )
+OPCODE( 0xC5,   ZPG        CMP  , 3 )
+OPCODE( 0xC6,   ZPG        DEC  , 5 )
+OPCODE( 0xC7, $ ZPG        DCM  , 5 )
+OPCODE( 0xC8,              INY  , 2 )
+OPCODE( 0xC9,   IMM        CMP  , 2 )
+OPCODE( 0xCA,              DEX  , 2 )
+OPCODE( 0xCB, $ IMM        SAX  , 2 )
+OPCODE( 0xCC,   ABS        CPY  , 4 )
+OPCODE( 0xCD,   ABS        CMP  , 4 )
+OPCODE( 0xCE,   ABS        DEC  , 6 )
+OPCODE( 0xCF, $ ABS        DCM  , 6 )
+OPCODE( 0xD0,   REL        BNE  , 2 )
+OPCODE( 0xD1,   INDY_OPT   CMP  , 5 )
+OPCODE( 0xD2, $            HLT  , 2 )
+OPCODE( 0xD3, $ INDY_CONST DCM  , 8 )
+OPCODE( 0xD4, $ zpx        NOP  , 4 )
+OPCODE( 0xD5,   zpx        CMP  , 4 )
+OPCODE( 0xD6,   zpx        DEC  , 6 )
+OPCODE( 0xD7, $ zpx        DCM  , 6 )
+OPCODE( 0xD8,              CLD  , 2 )
+OPCODE( 0xD9,   ABSY_OPT   CMP  , 4 )
+OPCODE( 0xDA, $            NOP  , 2 )
+OPCODE( 0xDB, $ ABSY_CONST DCM  , 7 )
+OPCODE( 0xDC, $ ABSX_OPT   NOP  , 4 )
+OPCODE( 0xDD,   ABSX_OPT   CMP  , 4 )
+OPCODE( 0xDE,   ABSX_CONST DEC  , 7 )
+OPCODE( 0xDF, $ ABSX_CONST DCM  , 7 )
+OPCODE( 0xE0,   IMM        CPX  , 2 )
+OPCODE( 0xE1,   idx        SBCn , 6 )
+OPCODE( 0xE2, $ IMM        NOP  , 2 )
+OPCODE( 0xE3, $ idx        INS  , 8 )
+OPCODE( 0xE4,   ZPG        CPX  , 3 )
+OPCODE( 0xE5,   ZPG        SBCn , 3 )
+OPCODE( 0xE6,   ZPG        INC  , 5 )
+OPCODE( 0xE7, $ ZPG        INS  , 5 )
+OPCODE( 0xE8,              INX  , 2 )
+OPCODE( 0xE9,   IMM        SBCn , 2 )
+OPCODE( 0xEA,              NOP  , 2 )
+OPCODE( 0xEB, $ IMM        SBCn , 2 )
+OPCODE( 0xEC,   ABS        CPX  , 4 )
+OPCODE( 0xED,   ABS        SBCn , 4 )
+OPCODE( 0xEE,   ABS        INC  , 6 )
+OPCODE( 0xEF, $ ABS        INS  , 6 )
+OPCODE( 0xF0,   REL        BEQ  , 2 )
+OPCODE( 0xF1,   INDY_OPT   SBCn , 5 )
+OPCODE( 0xF2, $            HLT  , 2 )
+OPCODE( 0xF3, $ INDY_CONST INS  , 8 )
+OPCODE( 0xF4, $ zpx        NOP  , 4 )
+OPCODE( 0xF5,   zpx        SBCn , 4 )
+OPCODE( 0xF6,   zpx        INC  , 6 )
+OPCODE( 0xF7, $ zpx        INS  , 6 )
+OPCODE( 0xF8,              SED  , 2 )
+OPCODE( 0xF9,   ABSY_OPT   SBCn , 4 )
+OPCODE( 0xFA, $            NOP  , 2 )
+OPCODE( 0xFB, $ ABSY_CONST INS  , 7 )
+OPCODE( 0xFC, $ ABSX_OPT   NOP  , 4 )
+OPCODE( 0xFD,   ABSX_OPT   SBCn , 4 )
+OPCODE( 0xFE,   ABSX_CONST INC  , 7 )
+OPCODE( 0xFF, $ ABSX_CONST INS  , 7 )
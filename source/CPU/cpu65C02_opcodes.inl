@@ -0,0 +1,283 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2011, Tom Charlesworth, Michael Pohoreski
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+// WDC 65C02 opcode table
+// . One OPCODE(opcode, [$] addressing-mode instruction, cycles) entry per opcode ($ = undocumented/invalid opcode)
+// . Define OPCODE() before including this file: see Cpu65C02()
+
+OPCODE( 0x00,              BRK  , 7 )
+OPCODE( 0x01,   idx        ORA  , 6 )
+OPCODE( 0x02, $ IMM        NOP  , 2 )
+OPCODE( 0x03, $            NOP  , 1 )
+OPCODE( 0x04,   ZPG        TSB  , 5 )
+OPCODE( 0x05,   ZPG        ORA  , 3 )
+OPCODE( 0x06,   ZPG        ASLc , 5 )
+OPCODE( 0x07, $            NOP  , 1 )
+OPCODE( 0x08,              PHP  , 3 )
+OPCODE( 0x09,   IMM        ORA  , 2 )
+OPCODE( 0x0A,              asl  , 2 )
+OPCODE( 0x0B, $            NOP  , 1 )
+OPCODE( 0x0C,   ABS        TSB  , 6 )
+OPCODE( 0x0D,   ABS        ORA  , 4 )
+OPCODE( 0x0E,   ABS        ASLc , 6 )
+OPCODE( 0x0F, $            NOP  , 1 )
+OPCODE( 0x10,   REL        BPL  , 2 )
+OPCODE( 0x11,   INDY_OPT   ORA  , 5 )
+OPCODE( 0x12,   izp        ORA  , 5 )
+OPCODE( 0x13, $            NOP  , 1 )
+OPCODE( 0x14,   ZPG        TRB  , 5 )
+OPCODE( 0x15,   zpx        ORA  , 4 )
+OPCODE( 0x16,   zpx        ASLc , 6 )
+OPCODE( 0x17, $            NOP  , 1 )
+OPCODE( 0x18,              CLC  , 2 )
+OPCODE( 0x19,   ABSY_OPT   ORA  , 4 )
+OPCODE( 0x1A,              INA  , 2 )
+OPCODE( 0x1B, $            NOP  , 1 )
+OPCODE( 0x1C,   ABS        TRB  , 6 )
+OPCODE( 0x1D,   ABSX_OPT   ORA  , 4 )
+OPCODE( 0x1E,   ABSX_OPT   ASLc , 6 )
+OPCODE( 0x1F, $            NOP  , 1 )
+OPCODE( 0x20,   ABS        JSR  , 6 )
+OPCODE( 0x21,   idx        AND  , 6 )
+OPCODE( 0x22, $ IMM        NOP  , 2 )
+OPCODE( 0x23, $            NOP  , 1 )
+OPCODE( 0x24,   ZPG        BIT  , 3 )
+OPCODE( 0x25,   ZPG        AND  , 3 )
+OPCODE( 0x26,   ZPG        ROLc , 5 )
+OPCODE( 0x27, $            NOP  , 1 )
+OPCODE( 0x28,              PLP  , 4 )
+OPCODE( 0x29,   IMM        AND  , 2 )
+OPCODE( 0x2A,              rol  , 2 )
+OPCODE( 0x2B, $            NOP  , 1 )
+OPCODE( 0x2C,   ABS        BIT  , 4 )
+OPCODE( 0x2D,   ABS        AND  , 4 )
+OPCODE( 0x2E,   ABS        ROLc , 6 )
+OPCODE( 0x2F, $            NOP  , 1 )
+OPCODE( 0x30,   REL        BMI  , 2 )
+OPCODE( 0x31,   INDY_OPT   AND  , 5 )
+OPCODE( 0x32,   izp        AND  , 5 )
+OPCODE( 0x33, $            NOP  , 1 )
+OPCODE( 0x34,   zpx        BIT  , 4 )
+OPCODE( 0x35,   zpx        AND  , 4 )
+OPCODE( 0x36,   zpx        ROLc , 6 )
+OPCODE( 0x37, $            NOP  , 1 )
+OPCODE( 0x38,              SEC  , 2 )
+OPCODE( 0x39,   ABSY_OPT   AND  , 4 )
+OPCODE( 0x3A,              DEA  , 2 )
+OPCODE( 0x3B, $            NOP  , 1 )
+OPCODE( 0x3C,   ABSX_OPT   BIT  , 4 )
+OPCODE( 0x3D,   ABSX_OPT   AND  , 4 )
+OPCODE( 0x3E,   ABSX_OPT   ROLc , 6 )
+OPCODE( 0x3F, $            NOP  , 1 )
+OPCODE( 0x40,              RTI  , 6 )
+OPCODE( 0x41,   idx        EOR  , 6 )
+OPCODE( 0x42, $ IMM        NOP  , 2 )
+OPCODE( 0x43, $            NOP  , 1 )
+OPCODE( 0x44, $ ZPG        NOP  , 3 )
+OPCODE( 0x45,   ZPG        EOR  , 3 )
+OPCODE( 0x46,   ZPG        LSRc , 5 )
+OPCODE( 0x47, $            NOP  , 1 )
+OPCODE( 0x48,              PHA  , 3 )
+OPCODE( 0x49,   IMM        EOR  , 2 )
+OPCODE( 0x4A,              lsr  , 2 )
+OPCODE( 0x4B, $            NOP  , 1 )
+OPCODE( 0x4C,   ABS        JMP  , 3 )
+OPCODE( 0x4D,   ABS        EOR  , 4 )
+OPCODE( 0x4E,   ABS        LSRc , 6 )
+OPCODE( 0x4F, $            NOP  , 1 )
+OPCODE( 0x50,   REL        BVC  , 2 )
+OPCODE( 0x51,   INDY_OPT   EOR  , 5 )
+OPCODE( 0x52,   izp        EOR  , 5 )
+OPCODE( 0x53, $            NOP  , 1 )
+OPCODE( 0x54, $ zpx        NOP  , 4 )
+OPCODE( 0x55,   zpx        EOR  , 4 )
+OPCODE( 0x56,   zpx        LSRc , 6 )
+OPCODE( 0x57, $            NOP  , 1 )
+OPCODE( 0x58,              CLI  , 2 )
+OPCODE( 0x59,   ABSY_OPT   EOR  , 4 )
+OPCODE( 0x5A,              PHY  , 3 )
+OPCODE( 0x5B, $            NOP  , 1 )
+OPCODE( 0x5C, $ ABS        NOP  , 8 )
+OPCODE( 0x5D,   ABSX_OPT   EOR  , 4 )
+OPCODE( 0x5E,   ABSX_OPT   LSRc , 6 )
+OPCODE( 0x5F, $            NOP  , 1 )
+OPCODE( 0x60,              RTS  , 6 )
+OPCODE( 0x61,   idx        ADCc , 6 )
+OPCODE( 0x62, $ IMM        NOP  , 2 )
+OPCODE( 0x63, $            NOP  , 1 )
+OPCODE( 0x64,   ZPG        STZ  , 3 )
+OPCODE( 0x65,   ZPG        ADCc , 3 )
+OPCODE( 0x66,   ZPG        RORc , 5 )
+OPCODE( 0x67, $            NOP  , 1 )
+OPCODE( 0x68,              PLA  , 4 )
+OPCODE( 0x69,   IMM        ADCc , 2 )
+OPCODE( 0x6A,              ror  , 2 )
+OPCODE( 0x6B, $            NOP  , 1 )
+OPCODE( 0x6C,   IABS_CMOS  JMP  , 6 )
+OPCODE( 0x6D,   ABS        ADCc , 4 )
+OPCODE( 0x6E,   ABS        RORc , 6 )
+OPCODE( 0x6F, $            NOP  , 1 )
+OPCODE( 0x70,   REL        BVS  , 2 )
+OPCODE( 0x71,   INDY_OPT   ADCc , 5 )
+OPCODE( 0x72,   izp        ADCc , 5 )
+OPCODE( 0x73, $            NOP  , 1 )
+OPCODE( 0x74,   zpx        STZ  , 4 )
+OPCODE( 0x75,   zpx        ADCc , 4 )
+OPCODE( 0x76,   zpx        RORc , 6 )
+OPCODE( 0x77, $            NOP  , 1 )
+OPCODE( 0x78,              SEI  , 2 )
+OPCODE( 0x79,   ABSY_OPT   ADCc , 4 )
+OPCODE( 0x7A,              PLY  , 4 )
+OPCODE( 0x7B, $            NOP  , 1 )
+OPCODE( 0x7C,   IABSX      JMP  , 6 )
+OPCODE( 0x7D,   ABSX_OPT   ADCc , 4 )
+OPCODE( 0x7E,   ABSX_OPT   RORc , 6 )
+OPCODE( 0x7F, $            NOP  , 1 )
+OPCODE( 0x80,   REL        BRA  , 2 )
+OPCODE( 0x81,   idx        STA  , 6 )
+OPCODE( 0x82, $ IMM        NOP  , 2 )
+OPCODE( 0x83, $            NOP  , 1 )
+OPCODE( 0x84,   ZPG        STY  , 3 )
+OPCODE( 0x85,   ZPG        STA  , 3 )
+OPCODE( 0x86,   ZPG        STX  , 3 )
+OPCODE( 0x87, $            NOP  , 1 )
+OPCODE( 0x88,              DEY  , 2 )
+OPCODE( 0x89,   IMM        BITI , 2 )
+OPCODE( 0x8A,              TXA  , 2 )
+OPCODE( 0x8B, $            NOP  , 1 )
+OPCODE( 0x8C,   ABS        STY  , 4 )
+OPCODE( 0x8D,   ABS        STA  , 4 )
+OPCODE( 0x8E,   ABS        STX  , 4 )
+OPCODE( 0x8F, $            NOP  , 1 )
+OPCODE( 0x90,   REL        BCC  , 2 )
+OPCODE( 0x91,   INDY_CONST STA  , 6 )
+OPCODE( 0x92,   izp        STA  , 5 )
+OPCODE( 0x93, $            NOP  , 1 )
+OPCODE( 0x94,   zpx        STY  , 4 )
+OPCODE( 0x95,   zpx        STA  , 4 )
+OPCODE( 0x96,   zpy        STX  , 4 )
+OPCODE( 0x97, $            NOP  , 1 )
+OPCODE( 0x98,              TYA  , 2 )
+OPCODE( 0x99,   ABSY_CONST STA  , 5 )
+OPCODE( 0x9A,              TXS  , 2 )
+OPCODE( 0x9B, $            NOP  , 1 )
+OPCODE( 0x9C,   ABS        STZ  , 4 )
+OPCODE( 0x9D,   ABSX_CONST STA  , 5 )
+OPCODE( 0x9E,   ABSX_CONST STZ  , 5 )
+OPCODE( 0x9F, $            NOP  , 1 )
+OPCODE( 0xA0,   IMM        LDY  , 2 )
+OPCODE( 0xA1,   idx        LDA  , 6 )
+OPCODE( 0xA2,   IMM        LDX  , 2 )
+OPCODE( 0xA3, $            NOP  , 1 )
+OPCODE( 0xA4,   ZPG        LDY  , 3 )
+OPCODE( 0xA5,   ZPG        LDA  , 3 )
+OPCODE( 0xA6,   ZPG        LDX  , 3 )
+OPCODE( 0xA7, $            NOP  , 1 )
+OPCODE( 0xA8,              TAY  , 2 )
+OPCODE( 0xA9,   IMM        LDA  , 2 )
+OPCODE( 0xAA,              TAX  , 2 )
+OPCODE( 0xAB, $            NOP  , 1 )
+OPCODE( 0xAC,   ABS        LDY  , 4 )
+OPCODE( 0xAD,   ABS        LDA  , 4 )
+OPCODE( 0xAE,   ABS        LDX  , 4 )
+OPCODE( 0xAF, $            NOP  , 1 )
+OPCODE( 0xB0,   REL        BCS  , 2 )
+OPCODE( 0xB1,   INDY_OPT   LDA  , 5 )
+OPCODE( 0xB2,   izp        LDA  , 5 )
+OPCODE( 0xB3, $            NOP  , 1 )
+OPCODE( 0xB4,   zpx        LDY  , 4 )
+OPCODE( 0xB5,   zpx        LDA  , 4 )
+OPCODE( 0xB6,   zpy        LDX  , 4 )
+OPCODE( 0xB7, $            NOP  , 1 )
+OPCODE( 0xB8,              CLV  , 2 )
+OPCODE( 0xB9,   ABSY_OPT   LDA  , 4 )
+OPCODE( 0xBA,              TSX  , 2 )
+OPCODE( 0xBB, $            NOP  , 1 )
+OPCODE( 0xBC,   ABSX_OPT   LDY  , 4 )
+OPCODE( 0xBD,   ABSX_OPT   LDA  , 4 )
+OPCODE( 0xBE,   ABSY_OPT   LDX  , 4 )
+OPCODE( 0xBF, $            NOP  , 1 )
+OPCODE( 0xC0,   IMM        CPY  , 2 )
+OPCODE( 0xC1,   idx        CMP  , 6 )
+OPCODE( 0xC2, $ IMM        NOP  , 2 )
+OPCODE( 0xC3, $            NOP  , 1 )
+OPCODE( 0xC4,   ZPG        CPY  , 3 )
+OPCODE( 0xC5,   ZPG        CMP  , 3 )
+OPCODE( 0xC6,   ZPG        DEC  , 5 )
+OPCODE( 0xC7, $            NOP  , 1 )
+OPCODE( 0xC8,              INY  , 2 )
+OPCODE( 0xC9,   IMM        CMP  , 2 )
+OPCODE( 0xCA,              DEX  , 2 )
+OPCODE( 0xCB, $            NOP  , 1 )
+OPCODE( 0xCC,   ABS        CPY  , 4 )
+OPCODE( 0xCD,   ABS        CMP  , 4 )
+OPCODE( 0xCE,   ABS        DEC  , 6 )
+OPCODE( 0xCF, $            NOP  , 1 )
+OPCODE( 0xD0,   REL        BNE  , 2 )
+OPCODE( 0xD1,   INDY_OPT   CMP  , 5 )
+OPCODE( 0xD2,   izp        CMP  , 5 )
+OPCODE( 0xD3, $            NOP  , 1 )
+OPCODE( 0xD4, $ zpx        NOP  , 4 )
+OPCODE( 0xD5,   zpx        CMP  , 4 )
+OPCODE( 0xD6,   zpx        DEC  , 6 )
+OPCODE( 0xD7, $            NOP  , 1 )
+OPCODE( 0xD8,              CLD  , 2 )
+OPCODE( 0xD9,   ABSY_OPT   CMP  , 4 )
+OPCODE( 0xDA,              PHX  , 3 )
+OPCODE( 0xDB, $            NOP  , 1 )
+OPCODE( 0xDC, $ ABS        LDD  , 4 )
+OPCODE( 0xDD,   ABSX_OPT   CMP  , 4 )
+OPCODE( 0xDE,   ABSX_CONST DEC  , 7 )
+OPCODE( 0xDF, $            NOP  , 1 )
+OPCODE( 0xE0,   IMM        CPX  , 2 )
+OPCODE( 0xE1,   idx        SBCc , 6 )
+OPCODE( 0xE2, $ IMM        NOP  , 2 )
+OPCODE( 0xE3, $            NOP  , 1 )
+OPCODE( 0xE4,   ZPG        CPX  , 3 )
+OPCODE( 0xE5,   ZPG        SBCc , 3 )
+OPCODE( 0xE6,   ZPG        INC  , 5 )
+OPCODE( 0xE7, $            NOP  , 1 )
+OPCODE( 0xE8,              INX  , 2 )
+OPCODE( 0xE9,   IMM        SBCc , 2 )
+OPCODE( 0xEA,              NOP  , 2 )
+OPCODE( 0xEB, $            NOP  , 1 )
+OPCODE( 0xEC,   ABS        CPX  , 4 )
+OPCODE( 0xED,   ABS        SBCc , 4 )
+OPCODE( 0xEE,   ABS        INC  , 6 )
+OPCODE( 0xEF, $            NOP  , 1 )
+OPCODE( 0xF0,   REL        BEQ  , 2 )
+OPCODE( 0xF1,   INDY_OPT   SBCc , 5 )
+OPCODE( 0xF2,   izp        SBCc , 5 )
+OPCODE( 0xF3, $            NOP  , 1 )
+OPCODE( 0xF4, $ zpx        NOP  , 4 )
+OPCODE( 0xF5,   zpx        SBCc , 4 )
+OPCODE( 0xF6,   zpx        INC  , 6 )
+OPCODE( 0xF7, $            NOP  , 1 )
+OPCODE( 0xF8,              SED  , 2 )
+OPCODE( 0xF9,   ABSY_OPT   SBCc , 4 )
+OPCODE( 0xFA,              PLX  , 4 )
+OPCODE( 0xFB, $            NOP  , 1 )
+OPCODE( 0xFC, $ ABS        LDD  , 4 )
+OPCODE( 0xFD,   ABSX_OPT   SBCc , 4 )
+OPCODE( 0xFE,   ABSX_CONST INC  , 7 )
+OPCODE( 0xFF, $            NOP  , 1 )
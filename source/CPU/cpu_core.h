@@ -0,0 +1,203 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2011, Tom Charlesworth, Michael Pohoreski
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/*
+ * CPU core:
+ * . One instruction loop, specialised at compile-time by policy parameters:
+ *   - cpu          : CPU_6502 or CPU_65C02 (selects the opcode table)
+ *   - bVideoUpdate : update NTSC video after each opcode
+ *   - bZ80         : a Z80 SoftCard is present, so check for an active Z80 per opcode
+ *   - bSpeech      : capture COUT for the Speech API
+ *   - bHeatmap     : update the memory heatmap (see cpu65d02.h)
+ *   - bVideoLog    : log stores to the video pages for the render thread (see NTSC_VideoPipelineWrite()), instead of bVideoUpdate
+ * . SelectCpuCore() picks the instantiation once per call of InternalCpuExecute()
+ */
+
+// TODO: Verify: RGBA or BGRA (.bmp format)
+// 0 A n/a
+// 1 B Exec
+// 2 G Read
+// 3 R Write
+//
+// 0xAARRGGBB
+// [0] B Exec
+// [1] G Load
+// [2] R Store
+// [3] A n/a
+// RGBA r = write, g = read, b = Program Counter
+const int HEATMAP_W_MASK = 0x00FF0000; // Red   Store
+const int HEATMAP_R_MASK = 0x0000FF00; // Green Load
+const int HEATMAP_X_MASK = 0x000000FF; // Blue  Exec
+
+// This is a memory heatmap
+// FF = accessed on this clock cycle
+// FE = accessed 1 clock cycles ago
+// FD = accessed 2 clock cycles ago
+// etc.
+// Displayed as 256x256 64K memory access
+int g_aMemoryHeatmap[ 65536 ]; // TODO: Change to <stdint.h> int32_t
+
+//===========================================================================
+
+// Redefine cpu_general.inl's no-op heatmap hooks & run-time video log hook for this core (restored below)
+#undef HEATMAP_R
+#undef HEATMAP_W
+#undef HEATMAP_X
+#undef VIDEO_W
+#define HEATMAP_R(addr) (bHeatmap ? (void)(g_aMemoryHeatmap[ addr ] |= HEATMAP_R_MASK) : (void)0)
+#define HEATMAP_W(addr) (bHeatmap ? (void)(g_aMemoryHeatmap[ addr ] |= HEATMAP_W_MASK) : (void)0)
+#define HEATMAP_X(addr) (bHeatmap ? (void)(g_aMemoryHeatmap[ addr ] |= HEATMAP_X_MASK) : (void)0)
+#define VIDEO_W(addr, a, page) VIDEO_LOG_W(bVideoLog, addr, a, page)
+
+template <eCpuType cpu, bool bVideoUpdate, bool bZ80, bool bSpeech, bool bHeatmap, bool bVideoLog>
+static DWORD CpuCore(DWORD uTotalCycles)
+{
+	// Optimisation:
+	// . Copy the global /regs/ vars to stack-based local vars
+	//   (Oliver Schmidt says this gives a performance gain, see email - The real deal: "1.10.5")
+	WORD addr;
+	BOOL flagc; // must always be 0 or 1, no other values allowed
+	BOOL flagn; // read via FLAGN (see LAZY_FLAGS)
+	BOOL flagv; // any value allowed
+	BOOL flagz; // read via FLAGZ (see LAZY_FLAGS)
+	WORD temp;
+	WORD temp2;
+	WORD val;
+	AF_TO_EF
+	ULONG uExecutedCycles = 0;
+	WORD base;
+
+	do
+	{
+		UINT uExtraCycles = 0;
+		BYTE iOpcode;
+
+// NTSC_BEGIN
+		ULONG uPreviousCycles = uExecutedCycles;
+// NTSC_END
+
+		if (bZ80 && GetActiveCpu() == CPU_Z80)
+		{
+			const UINT uZ80Cycles = z80_mainloop(uTotalCycles, uExecutedCycles); CYC(uZ80Cycles)
+		}
+		else if (IsFastDiskTrap(regs.pc) && CpuFastDiskTrap(uExecutedCycles, flagc, flagn, flagz))
+		{
+			// Sector/block request satisfied by the Disk II card, and returned to the caller
+		}
+		else
+		{
+#ifdef USE_SPEECH_API
+			if (bSpeech && regs.pc == COUT)
+				CaptureCOUT();
+#endif
+			HEATMAP_X(regs.pc);
+
+			const WORD uOpcodePC = regs.pc;
+			Fetch(iOpcode, uExecutedCycles);
+
+//#define $ INV // INV = Invalid -> Debugger Break
+#define $
+#define OPCODE(op, code, cycles) case op: code CYC(cycles) IRQ_PROFILING(op) break;
+			if (cpu == CPU_6502)
+			{
+				switch (iOpcode)
+				{
+#include "cpu6502_opcodes.inl"
+				}
+			}
+			else
+			{
+				switch (iOpcode)
+				{
+#include "cpu65C02_opcodes.inl"
+				}
+			}
+#undef OPCODE
+#undef $
+
+			CpuDiskAccel(uExecutedCycles, uPreviousCycles, uOpcodePC);
+		}
+
+		CheckInterruptSources(uExecutedCycles);
+		NMI(uExecutedCycles, flagc, flagn, flagv, flagz);
+		IRQ(uExecutedCycles, flagc, flagn, flagv, flagz);
+
+// NTSC_BEGIN
+		if (bVideoUpdate)
+		{
+			ULONG uElapsedCycles = uExecutedCycles - uPreviousCycles;
+			NTSC_VideoUpdateCycles( uElapsedCycles );
+		}
+// NTSC_END
+
+	} while (uExecutedCycles < uTotalCycles);
+
+	EF_TO_AF
+
+	return uExecutedCycles;
+}
+
+#undef HEATMAP_R
+#undef HEATMAP_W
+#undef HEATMAP_X
+#undef VIDEO_W
+#define HEATMAP_R(addr) ((void)0)
+#define HEATMAP_W(addr) ((void)0)
+#define HEATMAP_X(addr) ((void)0)
+#define VIDEO_W(addr, a, page) VIDEO_LOG_W(g_bCpuVideoLog, addr, a, page)
+
+//===========================================================================
+
+typedef DWORD (*CpuCoreFunc)(DWORD uTotalCycles);
+
+// NB. Speech capture is only enabled when not running at full-speed, but video may still not be updated per opcode (eg. VideoBenchmark())
+template <eCpuType cpu>
+static CpuCoreFunc SelectCpuCore(const bool bVideoUpdate, const bool bZ80, const bool bSpeech, const bool bVideoLog)
+{
+	if (bVideoLog)
+	{
+		if (bSpeech)
+			return bZ80 ? &CpuCore<cpu, false, true,  true,  false, true>
+			            : &CpuCore<cpu, false, false, true,  false, true>;
+
+		return bZ80 ? &CpuCore<cpu, false, true,  false, false, true>
+		            : &CpuCore<cpu, false, false, false, false, true>;
+	}
+
+	if (!bVideoUpdate)
+	{
+		if (bSpeech)
+			return bZ80 ? &CpuCore<cpu, false, true,  true,  false, false>
+			            : &CpuCore<cpu, false, false, true,  false, false>;
+
+		return bZ80 ? &CpuCore<cpu, false, true,  false, false, false>
+		            : &CpuCore<cpu, false, false, false, false, false>;
+	}
+
+	if (bSpeech)
+		return bZ80 ? &CpuCore<cpu, true,  true,  true,  false, false>
+		            : &CpuCore<cpu, true,  false, true,  false, false>;
+
+	return bZ80 ? &CpuCore<cpu, true,  true,  false, false, false>
+	            : &CpuCore<cpu, true,  false, false, false, false>;
+}
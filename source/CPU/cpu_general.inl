@@ -34,41 +34,88 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #undef AF_TO_EF
 #undef EF_TO_AF
-
-
+#undef FLAGN
+#undef FLAGZ
+#undef SETN
+#undef SETNZ
+#undef SETZ
+
+// Lazy N & Z flags:
+// . flagn & flagz just hold the last result (byte), which is only evaluated (by FLAGN & FLAGZ) when needed by a
+//   branch, PHP, BRK or an interrupt - most results are overwritten before then
+// . Comment out to evaluate N & Z eagerly for every instruction (flagn = 0 or 0x80, flagz = 0 or 1)
+#define LAZY_FLAGS
+
+#ifdef LAZY_FLAGS
+#define FLAGN	 ((flagn) & 0x80)
+#define FLAGZ	 (!((flagz) & 0xFF))
+#define SETN(a)	 flagn = (a);
+#define SETNZ(a) {							    \
+		   flagn = flagz = ((a) & 0xFF);			    \
+		 }
+#define SETZ(a)	 flagz = ((a) & 0xFF);
+#else
+#define FLAGN	 (flagn)
+#define FLAGZ	 (flagz)
+#define SETN(a)	 flagn = ((a) & 0x80);
+#define SETNZ(a) {							    \
+		   flagn = ((a) & 0x80);				    \
+		   flagz = !((a) & 0xFF);					    \
+		 }
+#define SETZ(a)	 flagz = !((a) & 0xFF);
+#endif
 
 #define AF_TO_EF  flagc = (regs.ps & AF_CARRY);				    \
-		  flagn = (regs.ps & AF_SIGN);				    \
+		  SETN(regs.ps & AF_SIGN)				    \
 		  flagv = (regs.ps & AF_OVERFLOW);			    \
-		  flagz = (regs.ps & AF_ZERO);
+		  SETZ(~regs.ps & AF_ZERO)
 #define EF_TO_AF  regs.ps = (regs.ps & ~(AF_CARRY | AF_SIGN |		    \
 					 AF_OVERFLOW | AF_ZERO))	    \
 			      | flagc 					    \
-			      | flagn					    \
+			      | FLAGN					    \
 			      | (flagv ? AF_OVERFLOW : 0)		    \
-			      | (flagz ? AF_ZERO     : 0)		    \
+			      | (FLAGZ ? AF_ZERO     : 0)		    \
 			      | AF_RESERVED | AF_BREAK;
+// RTI: end of IRQ handler (for IRQ profiling)
+#define IRQ_PROFILING(op) if ((op) == 0x40) DoIrqProfiling(uExecutedCycles);
 // CYC(a): This can be optimised, as only certain opcodes will affect uExtraCycles
 #define CYC(a)	 uExecutedCycles += (a)+uExtraCycles;
-#define POP	 (*(mem+((regs.sp >= 0x1FF) ? (regs.sp = 0x100) : ++regs.sp)))
-#define PUSH(a)	 *(mem+regs.sp--) = (a);				    \
+// Memory heatmap hooks: no-ops, except in the heatmap CPU core (see cpu_core.h)
+#undef HEATMAP_R
+#undef HEATMAP_W
+#undef HEATMAP_X
+#define HEATMAP_R(addr) ((void)0)
+#define HEATMAP_W(addr) ((void)0)
+#define HEATMAP_X(addr) ((void)0)
+// Video pipeline hook: log stores to the text/lores ($0400-$0BFF) & hires ($2000-$5FFF) pages for the render thread (see NTSC.cpp)
+// . before the store, so the previous contents are logged too
+// . g_bCpuVideoLog is set per CpuExecute(), except the policy-based core decides at compile-time (see cpu_core.h)
+#define IS_VIDEO_ADDR(a) ((WORD)((a) - 0x0400) < 0x0800 || (WORD)((a) - 0x2000) < 0x4000)
+#define VIDEO_LOG_W(bLog, addr, a, page) (((bLog) && IS_VIDEO_ADDR(addr)) ? NTSC_VideoPipelineWrite(addr, (BYTE)(a), page, g_dwCyclesThisFrame+uExecutedCycles) : (void)0)
+#undef VIDEO_W
+#define VIDEO_W(addr, a, page) VIDEO_LOG_W(g_bCpuVideoLog, addr, a, page)
+// Read via the paging tables (there's no 64K memory image): [$0000..$01FF] is always RAM
+#define MEMREAD8(a)	 (*(memread[(WORD)(a) >> 8]+((a) & 0xFF)))
+#define MEMREAD16(a)	 (MEMREAD8(a) | ((WORD)MEMREAD8((WORD)((a)+1)) << 8))
+#define POP	 (*(memread[0x01]+(((regs.sp >= 0x1FF) ? (regs.sp = 0x100) : ++regs.sp) & 0xFF)))
+#define PUSH(a)	 *(memwrite[0x01]+(regs.sp-- & 0xFF)) = (a);		    \
 		 if (regs.sp < 0x100)					    \
 		   regs.sp = 0x1FF;
 #define READ	 (							    \
+		    HEATMAP_R(addr),					    \
 		    ((addr & 0xF000) == 0xC000)				    \
 		    ? IORead[(addr>>4) & 0xFF](regs.pc,addr,0,0,uExecutedCycles) \
-			: *(mem+addr)					    \
+			: MEMREAD8(addr)					    \
 		 )
-#define SETNZ(a) {							    \
-		   flagn = ((a) & 0x80);				    \
-		   flagz = !((a) & 0xFF);					    \
-		 }
-#define SETZ(a)	 flagz = !((a) & 0xFF);
 #define WRITE(a) {							    \
+		   HEATMAP_W(addr);					    \
 		   memdirty[addr >> 8] = 0xFF;				    \
 		   LPBYTE page = memwrite[addr >> 8];		    \
 		   if (page)						    \
+		   {							    \
+		     VIDEO_W(addr, a, page);				    \
 		     *(page+(addr & 0xFF)) = (BYTE)(a);			    \
+		   }							    \
 		   else if ((addr & 0xF000) == 0xC000)			    \
 		     IOWrite[(addr>>4) & 0xFF](regs.pc,addr,1,(BYTE)(a),uExecutedCycles); \
 		 }
@@ -80,6 +127,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 // ExtraCycles:
 // +1 if branch taken
 // +1 if page boundary crossed
+// Short backward branches may be to an idle (polling) loop (see CpuIdleLoopSkip())
 #define BRANCH_TAKEN {					\
 			 base = regs.pc;		\
 			 regs.pc += addr;		\
@@ -87,6 +135,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 			     uExtraCycles=2;		\
 			 else				\
 			     uExtraCycles=1;		\
+			 if (addr == 0xFFFB || addr == 0xFFF5) \
+			     CpuIdleLoopSkip(uExecutedCycles, uExtraCycles); \
 		     }
 
 //
@@ -101,69 +151,76 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 *
 ***/
 
-#define ABS	 addr = *(LPWORD)(mem+regs.pc);	 regs.pc += 2;
-#define IABSX    addr = *(LPWORD)(mem+(*(LPWORD)(mem+regs.pc))+(WORD)regs.x); regs.pc += 2;
+// Operand byte/word following the opcode (regs.pc already points past the opcode)
+// . Redefined by the pre-decoded core to use the operand cached at decode time (see cpu_predecode.h)
+#undef OPERAND8
+#undef OPERAND16
+#define OPERAND8	MEMREAD8(regs.pc)
+#define OPERAND16	MEMREAD16(regs.pc)
+
+#define ABS	 addr = OPERAND16;	 regs.pc += 2;
+#define IABSX    base = OPERAND16+(WORD)regs.x; addr = MEMREAD16(base); regs.pc += 2;
 
 // Optimised for page-cross
-#define ABSX_OPT base = *(LPWORD)(mem+regs.pc); addr = base+(WORD)regs.x; regs.pc += 2; CHECK_PAGE_CHANGE;
+#define ABSX_OPT base = OPERAND16; addr = base+(WORD)regs.x; regs.pc += 2; CHECK_PAGE_CHANGE;
 // Not optimised for page-cross
-#define ABSX_CONST base = *(LPWORD)(mem+regs.pc); addr = base+(WORD)regs.x; regs.pc += 2;
+#define ABSX_CONST base = OPERAND16; addr = base+(WORD)regs.x; regs.pc += 2;
 
 // Optimised for page-cross
-#define ABSY_OPT base = *(LPWORD)(mem+regs.pc); addr = base+(WORD)regs.y; regs.pc += 2; CHECK_PAGE_CHANGE;
+#define ABSY_OPT base = OPERAND16; addr = base+(WORD)regs.y; regs.pc += 2; CHECK_PAGE_CHANGE;
 // Not optimised for page-cross
-#define ABSY_CONST base = *(LPWORD)(mem+regs.pc); addr = base+(WORD)regs.y; regs.pc += 2;
+#define ABSY_CONST base = OPERAND16; addr = base+(WORD)regs.y; regs.pc += 2;
 
 // TODO Optimization Note (just for IABSCMOS): uExtraCycles = ((base & 0xFF) + 1) >> 8;
-#define IABS_CMOS base = *(LPWORD)(mem+regs.pc);	                          \
-		 addr = *(LPWORD)(mem+base);		                  \
+#define IABS_CMOS base = OPERAND16;	                          \
+		 addr = MEMREAD16(base);		                  \
 		 if ((base & 0xFF) == 0xFF) uExtraCycles=1;		  \
 		 regs.pc += 2;
-#define IABS_NMOS base = *(LPWORD)(mem+regs.pc);	                          \
+#define IABS_NMOS base = OPERAND16;	                          \
 		 if ((base & 0xFF) == 0xFF)				  \
-		       addr = *(mem+base)+((WORD)*(mem+(base&0xFF00))<<8);\
+		       addr = MEMREAD8(base)+((WORD)MEMREAD8(base&0xFF00)<<8);\
 		 else                                                   \
-		       addr = *(LPWORD)(mem+base);                        \
+		       addr = MEMREAD16(base);                            \
 		 regs.pc += 2;
 
 #define IMM	 addr = regs.pc++;
 
-#define INDX	 base = ((*(mem+regs.pc++))+regs.x) & 0xFF;          \
+#define INDX	 base = (OPERAND8+regs.x) & 0xFF; regs.pc++;          \
 		 if (base == 0xFF)                                   \
-		     addr = *(mem+0xFF)+(((WORD)*mem)<<8);           \
+		     addr = *(memread[0x00]+0xFF)+(((WORD)*memread[0x00])<<8);\
 		 else                                                \
-		     addr = *(LPWORD)(mem+base);
+		     addr = *(LPWORD)(memread[0x00]+base);
 
 // Optimised for page-cross
-#define INDY_OPT	 if (*(mem+regs.pc) == 0xFF)             /*incurs an extra cycle for page-crossing*/ \
-		     base = *(mem+0xFF)+(((WORD)*mem)<<8);           \
+#define INDY_OPT	 if (OPERAND8 == 0xFF)                   /*incurs an extra cycle for page-crossing*/ \
+		     base = *(memread[0x00]+0xFF)+(((WORD)*memread[0x00])<<8);\
 		 else                                                \
-		     base = *(LPWORD)(mem+*(mem+regs.pc));           \
+		     base = *(LPWORD)(memread[0x00]+OPERAND8);         \
 		 regs.pc++;                                          \
 		 addr = base+(WORD)regs.y;                           \
 		 CHECK_PAGE_CHANGE;
 // Not optimised for page-cross
-#define INDY_CONST	 if (*(mem+regs.pc) == 0xFF)             /*no extra cycle for page-crossing*/ \
-		     base = *(mem+0xFF)+(((WORD)*mem)<<8);           \
+#define INDY_CONST	 if (OPERAND8 == 0xFF)                   /*no extra cycle for page-crossing*/ \
+		     base = *(memread[0x00]+0xFF)+(((WORD)*memread[0x00])<<8);\
 		 else                                                \
-		     base = *(LPWORD)(mem+*(mem+regs.pc));           \
+		     base = *(LPWORD)(memread[0x00]+OPERAND8);         \
 		 regs.pc++;                                          \
 		 addr = base+(WORD)regs.y;
 
-#define IZPG	 base = *(mem+regs.pc++);                            \
+#define IZPG	 base = OPERAND8; regs.pc++;                         \
 		 if (base == 0xFF)                                   \
-		     addr = *(mem+0xFF)+(((WORD)*mem)<<8);           \
+		     addr = *(memread[0x00]+0xFF)+(((WORD)*memread[0x00])<<8);\
 		 else                                                \
-		     addr = *(LPWORD)(mem+base);
+		     addr = *(LPWORD)(memread[0x00]+base);
 
-#define REL	 addr = (signed char)*(mem+regs.pc++);
+#define REL	 addr = (signed char)OPERAND8; regs.pc++;
 
 // TODO Optimization Note:
 // . Opcodes that generate zero-page addresses can't be accessing $C000..$CFFF
 //   so they could be paired with special READZP/WRITEZP macros (instead of READ/WRITE)
-#define ZPG 	 addr =   *(mem+regs.pc++);
-#define ZPGX	 addr = ((*(mem+regs.pc++))+regs.x) & 0xFF;
-#define ZPGY	 addr = ((*(mem+regs.pc++))+regs.y) & 0xFF;
+#define ZPG 	 addr =   OPERAND8; regs.pc++;
+#define ZPGX	 addr = (OPERAND8+regs.x) & 0xFF; regs.pc++;
+#define ZPGY	 addr = (OPERAND8+regs.y) & 0xFF; regs.pc++;
 
 // Tidy 3 char addressing modes to keep the opcode table visually aligned, clean, and readable.
 #undef asl
@@ -0,0 +1,113 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2019, Tom Charlesworth, Michael Pohoreski, Nick Westgate
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Description: Idle-loop detection (opt-in: -idle-loop-skip)
+ *
+ * . Called by BRANCH_TAKEN for a short backward branch (regs.pc = branch target), to recognise these polling loops:
+ *   (a) LDA|LDX|LDY|BIT abs ; Bxx (a)                    - eg. LDA $C000 / BPL, or a //e VBL wait on $C019
+ *   (b) INC zp ; BNE +2 ; INC zp+1 ; LDA|BIT abs ; Bxx (b) - eg. the Monitor's KEYIN (incrementing RNDL/RNDH)
+ * . where abs is a side-effect free soft switch, which can't change before the next scheduled event or the end of this CpuExecute():
+ *   - $C00x : keyboard data (only when no key is waiting - keypresses are queued between calls to CpuExecute())
+ *   - $C019 : //e VBL' (changes at the cycle given by VideoGetCyclesUntilVblChange())
+ *             Only with BPL/BMI: bits 0-6 are the floating bus, so any other Bxx (or its flags) could differ per iteration
+ * . Whole iterations are skipped by adding their cycles (and, for (b), advancing zp), so the loop exits at the same cycle as before
+ * . Shared with TestCPU6502, which provides: g_bIdleLoopSkip, g_uIdleLoopEndCycle, g_uNextEventCycle, g_bmIRQ, g_bNmiFlank,
+ *   KeybIsIdle() & VideoGetCyclesUntilVblChange()
+ */
+
+static void CpuIdleLoopSkip(ULONG& uExecutedCycles, const UINT uExtraCycles)
+{
+	const WORD pc = regs.pc;
+	if (!g_bIdleLoopSkip || (pc & 0xF000) == 0xC000 || (pc & 0xFF) > 0xF0)	// NB. Loop can't be in I/O space, nor span a page
+		return;
+
+	if ((g_bmIRQ && !(regs.ps & AF_INTERRUPT)) || g_bNmiFlank)
+		return;
+
+	// Match the loop's code (the Bxx has already been matched by its offset: -5 for (a), -11 for (b))
+	UINT uIterationCycles = 2 + uExtraCycles;	// Bxx (taken)
+	WORD readPC = pc;
+	bool bCounter = false;
+
+	if (MEMREAD8(pc+0) == 0xE6 && MEMREAD8(pc+2) == 0xD0 && MEMREAD8(pc+3) == 0x02 &&
+		MEMREAD8(pc+4) == 0xE6 && MEMREAD8(pc+5) == (BYTE)(MEMREAD8(pc+1)+1) && MEMREAD8(pc+10) == 0xF5)	// (b)
+	{
+		bCounter = true;
+		readPC = pc+6;
+		uIterationCycles += 5 + 3;	// INC zp ; BNE (taken, and the loop is within a page)
+	}
+	else if (MEMREAD8(pc+4) != 0xFB)	// Not (a)
+	{
+		return;
+	}
+
+	const BYTE iOpcode = MEMREAD8(readPC);
+	if (iOpcode != 0xAD && iOpcode != 0xAE && iOpcode != 0xAC && iOpcode != 0x2C)	// LDA|LDX|LDY|BIT abs
+		return;
+	uIterationCycles += 4;
+
+	// Determine the cycle by which the soft switch may next change
+	ULONG uEndCycle = (g_uNextEventCycle < g_uIdleLoopEndCycle) ? g_uNextEventCycle : g_uIdleLoopEndCycle;
+
+	const WORD uIoAddr = MEMREAD16(readPC+1);
+	if ((uIoAddr & 0xFFF0) == 0xC000)
+	{
+		if (!KeybIsIdle())
+			return;
+	}
+	else if (uIoAddr == 0xC019 && !IS_APPLE2)
+	{
+		const BYTE iBranchOpcode = MEMREAD8(readPC+3);
+		if (iBranchOpcode != 0x10 && iBranchOpcode != 0x30)	// Only BPL|BMI: just bit 7 (VBL') is deterministic
+			return;
+
+		const ULONG uVblChangeCycle = uExecutedCycles + VideoGetCyclesUntilVblChange(uExecutedCycles);
+		if (uVblChangeCycle < uEndCycle)
+			uEndCycle = uVblChangeCycle;
+	}
+	else
+	{
+		return;
+	}
+
+	// Skip whole iterations: NB. CYC() adds this Bxx's cycles afterwards
+	const ULONG uCycleAfterBranch = uExecutedCycles + 2 + uExtraCycles;
+	if (uCycleAfterBranch >= uEndCycle)
+		return;
+
+	UINT uIterations = (uEndCycle - uCycleAfterBranch) / uIterationCycles;
+
+	if (bCounter)
+	{
+		// Only skip while INC zp doesn't wrap (the wrapping iteration also does INC zp+1)
+		const BYTE zp = MEMREAD8(pc+1);
+		const UINT uMaxIterations = 0xFF - *(memread[0x00]+zp);
+		if (uIterations > uMaxIterations)
+			uIterations = uMaxIterations;
+
+		*(memwrite[0x00]+zp) += (BYTE)uIterations;
+		memdirty[0x00] = 0xFF;
+	}
+
+	uExecutedCycles += uIterations * uIterationCycles;
+}
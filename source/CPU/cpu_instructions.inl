@@ -177,8 +177,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 		     val = (val & 0x0F) + (regs.a & 0xF0) + (temp & 0xF0);  \
 		   else							    \
 		     val = (val & 0x0F) + (regs.a & 0xF0) + (temp & 0xF0) + 0x10;\
-		   flagz = !((regs.a + temp + flagc) & 0xFF);		    \
-		   flagn = (val & 0x80);				    \
+		   SETZ(regs.a + temp + flagc)			    \
+		   SETN(val)					    \
 		   flagv = ((regs.a ^ val) & 0x80) && !((regs.a ^ temp) & 0x80);\
 		   if ((val & 0x1F0) > 0x90)				    \
 		     val += 0x60;					    \
@@ -229,7 +229,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 		 SETNZ(regs.a)
 #define ALR	 regs.a &= READ;					    \
 		 flagc = (regs.a & 1);					    \
-		 flagn = 0;						    \
+		 SETN(0)						    \
 		 regs.a >>= 1;						    \
 		 SETZ(regs.a)
 #define AND	 /*bSlowerOnPagecross = 1;*/						    \
@@ -237,13 +237,13 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 		 SETNZ(regs.a)
 #define ANC	 regs.a &= READ;					    \
 		 SETNZ(regs.a)						    \
-		 flagc = !!flagn;
+		 flagc = !!FLAGN;
 #define ARR	 temp = regs.a & READ; /* Yes, this is sick */		    \
 		 if (regs.ps & AF_DECIMAL) {				    \
 		   val = temp;						    \
 		   val |= (flagc ? 0x100 : 0);				    \
 		   val >>= 1;						    \
-		   flagn = (flagc ? 0x80 : 0);					    \
+		   SETN(flagc ? 0x80 : 0)				    \
 		   SETZ(val)						    \
 		   flagv = ((val ^ temp) & 0x40);			    \
 		   if (((val & 0x0F) + (val & 0x01)) > 0x05)                \
@@ -292,16 +292,16 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 		 WRITE(regs.a & regs.x)
 #define BCC	 if (!flagc) BRANCH_TAKEN;
 #define BCS	 if ( flagc) BRANCH_TAKEN;
-#define BEQ	 if ( flagz) BRANCH_TAKEN;
+#define BEQ	 if ( FLAGZ) BRANCH_TAKEN;
 #define BIT	 /*bSlowerOnPagecross = 1;*/						    \
 		 val   = READ;						    \
-		 flagz = !(regs.a & val);				    \
-		 flagn = val & 0x80;					    \
+		 SETZ(regs.a & val)				    \
+		 SETN(val)					    \
 		 flagv = val & 0x40;
-#define BITI	 flagz = !(regs.a & READ);
-#define BMI	 if ( flagn) BRANCH_TAKEN;
-#define BNE	 if (!flagz) BRANCH_TAKEN;
-#define BPL	 if (!flagn) BRANCH_TAKEN;
+#define BITI	 SETZ(regs.a & READ)
+#define BMI	 if ( FLAGN) BRANCH_TAKEN;
+#define BNE	 if (!FLAGZ) BRANCH_TAKEN;
+#define BPL	 if (!FLAGN) BRANCH_TAKEN;
 #define BRA	 BRANCH_TAKEN;
 #define BRK	 regs.pc++;						    \
 		 PUSH(regs.pc >> 8)					    \
@@ -309,7 +309,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 		 EF_TO_AF						    \
 		 PUSH(regs.ps);						    \
 		 regs.ps |= AF_INTERRUPT;				    \
-		 regs.pc = *(LPWORD)(mem+0xFFFE);
+		 regs.pc = MEMREAD16(0xFFFE);
 #define BVC	 if (!flagv) BRANCH_TAKEN;
 #define BVS	 if ( flagv) BRANCH_TAKEN;
 #define CLC	 flagc = 0;
@@ -420,19 +420,19 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #define LSR_NMOS /*bSlowerOnPagecross = 0;*/						    \
 		 val   = READ;						    \
 		 flagc = (val & 1);					    \
-		 flagn = 0;						    \
+		 SETN(0)						    \
 		 val >>= 1;						    \
 		 SETZ(val)						    \
 		 WRITE(val)
 #define LSR_CMOS /*bSlowerOnPagecross = 1;*/						    \
 		 val   = READ;						    \
 		 flagc = (val & 1);					    \
-		 flagn = 0;						    \
+		 SETN(0)						    \
 		 val >>= 1;						    \
 		 SETZ(val)						    \
 		 WRITE(val)
 #define LSRA	 flagc = (regs.a & 1);					    \
-		 flagn = 0;						    \
+		 SETN(0)						    \
 		 regs.a >>= 1;						    \
 		 SETZ(regs.a)
 #define NOP	 /*bSlowerOnPagecross = 1;*/
@@ -506,8 +506,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 		     val = (val & 0x0F) + (regs.a & 0xF0) + (temp & 0xF0);  \
 		   else							    \
 		     val = (val & 0x0F) + (regs.a & 0xF0) + (temp & 0xF0) + 0x10;\
-		   flagz = !((regs.a + temp + flagc) & 0xFF);		    \
-		   flagn = (val & 0x80);				    \
+		   SETZ(regs.a + temp + flagc)			    \
+		   SETN(val)					    \
 		   flagv = ((regs.a ^ val) & 0x80) && !((regs.a ^ temp) & 0x80);\
 		   if ((val & 0x1F0) > 0x90)				    \
 		     val += 0x60;					    \
@@ -628,12 +628,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 		 SETNZ(regs.y)
 #define TRB	 /*bSlowerOnPagecross = 0;*/						    \
 		 val   = READ;						    \
-		 flagz = !(regs.a & val);				    \
+		 SETZ(regs.a & val)				    \
 		 val  &= ~regs.a;					    \
 		 WRITE(val)
 #define TSB	 /*bSlowerOnPagecross = 0;*/						    \
 		 val   = READ;						    \
-		 flagz = !(regs.a & val);				    \
+		 SETZ(regs.a & val)				    \
 		 val   |= regs.a;					    \
 		 WRITE(val)
 #define TSX	 regs.x = regs.sp & 0xFF;				    \
@@ -0,0 +1,378 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 2006-2019, Tom Charlesworth, Michael Pohoreski, Nick Westgate
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Description: Pre-decoded (threaded-code) 6502/65C02 core
+ *
+ * . Each opcode is a handler function, generated from the same opcode tables as the switch cores
+ * . Memory (via memread[]) is decoded lazily into per-address {handler, operand} records
+ * . A page's records are discarded when memdirty[page] has MEMDIRTY_PREDECODE set:
+ *   - set by every CPU write (WRITE macro sets all memdirty bits)
+ *   - set by UpdatePaging() when a page of memread[] is re-mapped to a different bank
+ * . Never cached (always decoded from memread[]):
+ *   - $00xx & $01xx : ZP/stack writes by PUSH/JSR/BRK don't go via WRITE (see also UpdatePaging())
+ *   - $Cxxx         : opcode fetch may be from I/O space
+ *   - $xxFE & $xxFF : operand spans the next page
+ * . Basic-block mode (only when there's no video update, ie. full-speed):
+ *   - g_aBlockLength[PC] = number of opcodes in the straight-line block starting at PC (0 = not yet recorded)
+ *   - a block is recorded the first time it's run, and ends at a control-flow opcode or at the end of the page's cached range
+ *   - a block runs without the per-opcode Z80 and interrupt checks
+ *   - a block is exited early on a $Cxxx access (eg. a bank switch or IRQ) or on a write to its own page
+ *
+ * Author: Various
+ */
+
+struct PredecodeState
+{
+	ULONG uExecutedCycles;
+	BOOL flagc; // must always be 0 or 1, no other values allowed
+	BOOL flagn; // read via FLAGN (see LAZY_FLAGS)
+	BOOL flagv; // any value allowed
+	BOOL flagz; // read via FLAGZ (see LAZY_FLAGS)
+	WORD operand;
+	WORD addr;
+	WORD base;
+	WORD temp;
+	WORD temp2;
+	WORD val;
+};
+
+typedef void (*PredecodeHandler)(PredecodeState& cs);
+
+struct PredecodedOp
+{
+	PredecodeHandler pfnHandler;	// NULL = not yet decoded
+	WORD operand;
+};
+
+static PredecodedOp g_aPredecoded[0x10000];
+static BYTE g_aBlockLength[0x10000];
+static const UINT kMaxBlockOpcodes = 32;
+static PredecodedOp g_predecodedUncached;
+static const PredecodeHandler* g_pPredecodedHandlers = NULL;	// Handler table that g_aPredecoded[] was decoded with
+
+//===========================================================================
+
+// Handlers use the same macros as the switch cores, but with locals aliased to the PredecodeState
+#define PREDECODE_LOCALS							\
+		ULONG& uExecutedCycles = cs.uExecutedCycles;	\
+		BOOL& flagc = cs.flagc;						\
+		BOOL& flagn = cs.flagn;						\
+		BOOL& flagv = cs.flagv;						\
+		BOOL& flagz = cs.flagz;						\
+		WORD& addr = cs.addr;						\
+		WORD& base = cs.base;						\
+		WORD& temp = cs.temp;						\
+		WORD& temp2 = cs.temp2;						\
+		WORD& val = cs.val;							\
+		UINT uExtraCycles = 0;
+
+#undef OPERAND8
+#undef OPERAND16
+#define OPERAND8	((BYTE)cs.operand)
+#define OPERAND16	(cs.operand)
+
+#define $
+#define OPCODE(op, code, cycles) static void Op_##op(PredecodeState& cs) { PREDECODE_LOCALS code CYC(cycles) IRQ_PROFILING(op) }
+
+namespace Predecode6502
+{
+#include "cpu6502_opcodes.inl"
+}
+
+namespace Predecode65C02
+{
+#include "cpu65C02_opcodes.inl"
+}
+
+#undef OPCODE
+#define OPCODE(op, code, cycles) Op_##op,
+
+namespace Predecode6502
+{
+	static const PredecodeHandler g_aHandlers[256] =
+	{
+#include "cpu6502_opcodes.inl"
+	};
+}
+
+namespace Predecode65C02
+{
+	static const PredecodeHandler g_aHandlers[256] =
+	{
+#include "cpu65C02_opcodes.inl"
+	};
+}
+
+#undef OPCODE
+#undef $
+
+#undef PREDECODE_LOCALS
+#undef OPERAND8
+#undef OPERAND16
+#define OPERAND8	MEMREAD8(regs.pc)
+#define OPERAND16	MEMREAD16(regs.pc)
+
+//===========================================================================
+
+// Discard all records (eg. the debugger has modified memory)
+static void PredecodeInvalidateAll(void)
+{
+	for (UINT page = 0; page < 0x100; page++)
+		memdirty[page] |= MEMDIRTY_PREDECODE;
+}
+
+static __forceinline void PredecodeInvalidatePage(const BYTE page)
+{
+	memdirty[page] &= ~MEMDIRTY_PREDECODE;
+	memset(&g_aPredecoded[page << 8], 0, 256*sizeof(PredecodedOp));
+	memset(&g_aBlockLength[page << 8], 0, 256);
+}
+
+static __forceinline bool IsPredecodeCached(const USHORT PC)
+{
+	return (PC >> 8) > 0x01 && (PC & 0xF000) != 0xC000 && (PC & 0xFF) < 0xFE;
+}
+
+static void PredecodeBegin(const PredecodeHandler* pHandlers)
+{
+	if (g_pPredecodedHandlers != pHandlers)	// CPU type changed
+	{
+		PredecodeInvalidateAll();
+		g_pPredecodedHandlers = pHandlers;
+	}
+}
+
+static __forceinline const PredecodedOp& PredecodeFetch(ULONG uExecutedCycles, const PredecodeHandler* pHandlers)
+{
+	const USHORT PC = regs.pc;
+	const BYTE page = PC >> 8;
+
+	if (!IsPredecodeCached(PC))
+	{
+		BYTE iOpcode;
+		Fetch(iOpcode, uExecutedCycles);
+		g_predecodedUncached.pfnHandler = pHandlers[iOpcode];
+		g_predecodedUncached.operand = MEMREAD16(regs.pc);
+		return g_predecodedUncached;
+	}
+
+	if (memdirty[page] & MEMDIRTY_PREDECODE)
+		PredecodeInvalidatePage(page);
+
+	PredecodedOp& op = g_aPredecoded[PC];
+	if (!op.pfnHandler)
+	{
+		op.pfnHandler = pHandlers[MEMREAD8(PC)];
+		op.operand = MEMREAD16(PC+1);
+	}
+
+#ifdef USE_SPEECH_API
+	if (PC == COUT && g_Speech.IsEnabled() && !g_bFullSpeed)
+		CaptureCOUT();
+#endif
+
+	regs.pc++;
+	return op;
+}
+
+//===========================================================================
+
+static DWORD CpuPredecoded(DWORD uTotalCycles, const bool bVideoUpdate, const PredecodeHandler* pHandlers)
+{
+	PredecodeBegin(pHandlers);
+
+	PredecodeState cs;
+	ULONG& uExecutedCycles = cs.uExecutedCycles;
+	BOOL& flagc = cs.flagc;
+	BOOL& flagn = cs.flagn;
+	BOOL& flagv = cs.flagv;
+	BOOL& flagz = cs.flagz;
+	AF_TO_EF
+	uExecutedCycles = 0;
+
+	do
+	{
+		UINT uExtraCycles = 0;
+
+// NTSC_BEGIN
+		ULONG uPreviousCycles = uExecutedCycles;
+// NTSC_END
+
+		if (GetActiveCpu() == CPU_Z80)
+		{
+			const UINT uZ80Cycles = z80_mainloop(uTotalCycles, uExecutedCycles); CYC(uZ80Cycles)
+		}
+		else if (IsFastDiskTrap(regs.pc) && CpuFastDiskTrap(uExecutedCycles, flagc, flagn, flagz))
+		{
+			// Sector/block request satisfied by the Disk II card, and returned to the caller
+		}
+		else
+		{
+			const WORD uOpcodePC = regs.pc;
+			const PredecodedOp& op = PredecodeFetch(uExecutedCycles, pHandlers);
+			cs.operand = op.operand;
+			op.pfnHandler(cs);
+
+			CpuDiskAccel(uExecutedCycles, uPreviousCycles, uOpcodePC);
+		}
+
+		CheckInterruptSources(uExecutedCycles);
+		NMI(uExecutedCycles, flagc, flagn, flagv, flagz);
+		IRQ(uExecutedCycles, flagc, flagn, flagv, flagz);
+
+// NTSC_BEGIN
+		if (bVideoUpdate)
+		{
+			ULONG uElapsedCycles = uExecutedCycles - uPreviousCycles;
+			NTSC_VideoUpdateCycles( uElapsedCycles );
+		}
+// NTSC_END
+
+	} while (uExecutedCycles < uTotalCycles);
+
+	EF_TO_AF
+
+	return uExecutedCycles;
+}
+
+//===========================================================================
+
+static __forceinline bool IsBlockEnd(const BYTE iOpcode)
+{
+	if ((iOpcode & 0x1F) == 0x10)	// Bcc
+		return true;
+
+	switch (iOpcode)
+	{
+	case 0x00:	// BRK
+	case 0x20:	// JSR
+	case 0x40:	// RTI
+	case 0x4C:	// JMP abs
+	case 0x60:	// RTS
+	case 0x6C:	// JMP (abs)
+	case 0x7C:	// JMP (abs,X) (65C02)
+	case 0x80:	// BRA (65C02)
+		return true;
+	}
+
+	return false;
+}
+
+// Pre: IsPredecodeCached(regs.pc) and the page's records are valid
+// Returns the number of opcodes executed
+static __forceinline UINT PredecodeRunBlock(PredecodeState& cs, const PredecodeHandler* pHandlers)
+{
+	const USHORT PC = regs.pc;
+	const BYTE page = PC >> 8;
+	const UINT nBlockLength = g_aBlockLength[PC];	// 0 = record this block
+	const UINT nMaxOpcodes = nBlockLength ? nBlockLength : kMaxBlockOpcodes;
+	UINT nOpcodes = 0;
+
+	cs.addr = 0;
+
+	while (1)
+	{
+		const USHORT opcodePC = regs.pc;
+		PredecodedOp& op = g_aPredecoded[opcodePC];
+		const BYTE iOpcode = MEMREAD8(opcodePC);
+		if (!op.pfnHandler)
+		{
+			op.pfnHandler = pHandlers[iOpcode];
+			op.operand = MEMREAD16(opcodePC+1);
+		}
+
+		regs.pc++;
+		cs.operand = op.operand;
+		op.pfnHandler(cs);
+		nOpcodes++;
+
+		if (nOpcodes == nMaxOpcodes)
+			break;
+
+		if ((cs.addr & 0xF000) == 0xC000 || (memdirty[page] & MEMDIRTY_PREDECODE))
+			break;
+
+		if (!nBlockLength)
+		{
+			const USHORT opcodeLength = regs.pc - opcodePC;
+			if (IsBlockEnd(iOpcode) || opcodeLength > 3 || (regs.pc >> 8) != page || !IsPredecodeCached(regs.pc))
+				break;
+		}
+	}
+
+	if (!nBlockLength)
+		g_aBlockLength[PC] = (BYTE) nOpcodes;
+
+	return nOpcodes;
+}
+
+// Only for when there's no video update (ie. full-speed): interrupts & Z80 are only checked between blocks
+static DWORD CpuPredecodedBlocks(DWORD uTotalCycles, const PredecodeHandler* pHandlers)
+{
+	PredecodeBegin(pHandlers);
+
+	PredecodeState cs;
+	ULONG& uExecutedCycles = cs.uExecutedCycles;
+	BOOL& flagc = cs.flagc;
+	BOOL& flagn = cs.flagn;
+	BOOL& flagv = cs.flagv;
+	BOOL& flagz = cs.flagz;
+	AF_TO_EF
+	uExecutedCycles = 0;
+
+	do
+	{
+		UINT uExtraCycles = 0;
+
+		if (GetActiveCpu() == CPU_Z80)
+		{
+			const UINT uZ80Cycles = z80_mainloop(uTotalCycles, uExecutedCycles); CYC(uZ80Cycles)
+		}
+		else if (IsFastDiskTrap(regs.pc) && CpuFastDiskTrap(uExecutedCycles, flagc, flagn, flagz))
+		{
+			// Sector/block request satisfied by the Disk II card, and returned to the caller
+		}
+		else if (IsPredecodeCached(regs.pc))
+		{
+			const BYTE page = regs.pc >> 8;
+			if (memdirty[page] & MEMDIRTY_PREDECODE)
+				PredecodeInvalidatePage(page);
+
+			PredecodeRunBlock(cs, pHandlers);
+		}
+		else
+		{
+			const PredecodedOp& op = PredecodeFetch(uExecutedCycles, pHandlers);
+			cs.operand = op.operand;
+			op.pfnHandler(cs);
+		}
+
+		CheckInterruptSources(uExecutedCycles);
+		NMI(uExecutedCycles, flagc, flagn, flagv, flagz);
+		IRQ(uExecutedCycles, flagc, flagn, flagv, flagz);
+
+	} while (uExecutedCycles < uTotalCycles);
+
+	EF_TO_AF
+
+	return uExecutedCycles;
+}
+
+//===========================================================================
@@ -1962,7 +1962,7 @@ Update_t CmdStepOver (int nArgs)
 
 	while (nDebugSteps -- > 0)
 	{
-		int nOpcode = *(mem + regs.pc); // g_nDisasmCurAddress
+		int nOpcode = *MemGetReadPtr(regs.pc); // g_nDisasmCurAddress
 	//	int eMode = g_aOpcodes[ nOpcode ].addrmode;
 	//	int nByte = g_aOpmodes[eMode]._nBytes;
 	//	if ((eMode ==  AM_A) && 
@@ -2122,14 +2122,11 @@ Update_t CmdJSR (int nArgs)
 
 	WORD nAddress = g_aArgs[1].nValue & _6502_MEM_END;
 
-	// Mark Stack Page as dirty
-	*(memdirty+(regs.sp >> 8)) = 1;
-
-	// Push PC onto stack
-	*(mem + regs.sp) = ((regs.pc >> 8) & 0xFF);
+	// Push PC onto stack (MemWriteByte() marks the stack page as dirty)
+	MemWriteByte(regs.sp, ((regs.pc >> 8) & 0xFF));
 	regs.sp--;
 
-	*(mem + regs.sp) = ((regs.pc >> 0) - 1) & 0xFF;
+	MemWriteByte(regs.sp, ((regs.pc >> 0) - 1) & 0xFF);
 	regs.sp--;
 
 
@@ -2151,7 +2148,7 @@ Update_t CmdNOP (int nArgs)
 
 	while (nOpbytes--)
 	{
-		*(mem+regs.pc + nOpbytes) = 0xEA;
+		MemWriteByte(regs.pc + nOpbytes, 0xEA);
 	}
 
 	return UPDATE_ALL;
@@ -3831,27 +3828,27 @@ bool MemoryDumpCheck (int nArgs, WORD * pAddress_ )
 #ifdef SUPPORT_Z80_EMU
 	else if(strcmp(g_aArgs[1].sArg, "*AF") == 0)
 	{
-		nAddress = *(WORD*)(mem + REG_AF);
+		nAddress = MemReadWord(REG_AF);
 		bUpdate = true;
 	}
 	else if(strcmp(g_aArgs[1].sArg, "*BC") == 0)
 	{
-		nAddress = *(WORD*)(mem + REG_BC);
+		nAddress = MemReadWord(REG_BC);
 		bUpdate = true;
 	}
 	else if(strcmp(g_aArgs[1].sArg, "*DE") == 0)
 	{
-		nAddress = *(WORD*)(mem + REG_DE);
+		nAddress = MemReadWord(REG_DE);
 		bUpdate = true;
 	}
 	else if(strcmp(g_aArgs[1].sArg, "*HL") == 0)
 	{
-		nAddress = *(WORD*)(mem + REG_HL);
+		nAddress = MemReadWord(REG_HL);
 		bUpdate = true;
 	}
 	else if(strcmp(g_aArgs[1].sArg, "*IX") == 0)
 	{
-		nAddress = *(WORD*)(mem + REG_IX);
+		nAddress = MemReadWord(REG_IX);
 		bUpdate = true;
 	}
 #endif
@@ -4006,14 +4003,13 @@ Update_t CmdMemoryEnterByte (int nArgs)
 		WORD nData = g_aArgs[nArgs].nValue;
 		if( nData > 0xFF)
 		{
-			*(mem + nAddress + nArgs - 2)  = (BYTE)(nData >> 0);
-			*(mem + nAddress + nArgs - 1)  = (BYTE)(nData >> 8);
+			MemWriteByte(nAddress + nArgs - 2, (BYTE)(nData >> 0));
+			MemWriteByte(nAddress + nArgs - 1, (BYTE)(nData >> 8));
 		}
 		else
 		{
-			*(mem + nAddress+nArgs-2)  = (BYTE)nData;
+			MemWriteByte(nAddress+nArgs-2, (BYTE)nData);
 		}
-		*(memdirty+(nAddress >> 8)) = 1;
 		nArgs--;
 	}
 
@@ -4036,25 +4032,15 @@ Update_t CmdMemoryEnterWord (int nArgs)
 		WORD nData = g_aArgs[nArgs].nValue;
 
 		// Little Endian
-		*(mem + nAddress + nArgs - 2)  = (BYTE)(nData >> 0);
-		*(mem + nAddress + nArgs - 1)  = (BYTE)(nData >> 8);
+		MemWriteByte(nAddress + nArgs - 2, (BYTE)(nData >> 0));
+		MemWriteByte(nAddress + nArgs - 1, (BYTE)(nData >> 8));
 
-		*(memdirty+(nAddress >> 8)) |= 1;
 		nArgs--;
 	}
 
 	return UPDATE_ALL;
 }
 
-//===========================================================================
-void MemMarkDirty( WORD nAddressStart, WORD nAddressEnd )
-{
-	for( int iPage = (nAddressStart >> 8); iPage <= (nAddressEnd >> 8); iPage++ )
-	{
-		*(memdirty+iPage) = 1;
-	}
-}
-
 //===========================================================================
 Update_t CmdMemoryFill (int nArgs)
 {
@@ -4090,15 +4076,13 @@ Update_t CmdMemoryFill (int nArgs)
 
 	if ((nAddressLen > 0) && (nAddressEnd <= _6502_MEM_END))
 	{
-		MemMarkDirty( nAddressStart, nAddressEnd );
-
 		nValue = g_aArgs[nArgs].nValue & 0xFF;
 		while( nAddressLen-- ) // v2.7.0.22
 		{
 			// TODO: Optimize - split into pre_io, and post_io
 			if ((nAddress2 < _6502_IO_BEGIN) || (nAddress2 > _6502_IO_END))
 			{
-				*(mem + nAddressStart) = nValue;
+				MemWriteByte(nAddressStart, nValue);
 			}
 			nAddressStart++;
 		}
@@ -4246,8 +4230,6 @@ Update_t CmdMemoryLoad (int nArgs)
 		}
 		
 		BYTE *pMemory = new BYTE [ _6502_MEM_END + 1 ]; // default 64K buffer
-		BYTE *pDst = mem + nAddressStart;
-		BYTE *pSrc = pMemory;
 
 		if (bHaveFileName)
 		{
@@ -4272,11 +4254,7 @@ Update_t CmdMemoryLoad (int nArgs)
 			size_t nRead = fread( pMemory, nAddressLen, 1, hFile );
 			if (nRead == 1) // (size_t)nLen)
 			{
-				int iByte;
-				for( iByte = 0; iByte < nAddressLen; iByte++ )
-				{
-					*pDst++ = *pSrc++;
-				}
+				MemWriteBlock( nAddressStart, pMemory, nAddressLen );
 				ConsoleBufferPush( TEXT( "Loaded." ) );
 			}
 			fclose( hFile );
@@ -4447,8 +4425,8 @@ Update_t CmdMemoryLoad (int nArgs)
 	}
 	_tcscat( sLoadSaveFilePath, g_sMemoryLoadSaveFileName );
 	
-	BYTE * const pMemBankBase = bBankSpecified ? MemGetBankPtr(nBank) : mem;
-	if (!pMemBankBase)
+	BYTE * const pMemBankBase = bBankSpecified ? MemGetBankPtr(nBank) : NULL;
+	if (bBankSpecified && !pMemBankBase)
 	{
 		ConsoleBufferPush( TEXT( "Error: Bank out of range." ) );
 		return ConsoleUpdate();
@@ -4468,7 +4446,16 @@ Update_t CmdMemoryLoad (int nArgs)
 			nAddressLen = nFileBytes;
 		}
 
-		size_t nRead = fread( pMemBankBase+nAddressStart, nAddressLen, 1, hFile );
+		// No bank: load into the CPU's view of memory (via a temp buffer, as it may span differently paged-in pages)
+		BYTE * const pDst = bBankSpecified ? pMemBankBase+nAddressStart : new BYTE [ nAddressLen ];
+		size_t nRead = fread( pDst, nAddressLen, 1, hFile );
+		if (!bBankSpecified)
+		{
+			if (nRead == 1)
+				MemWriteBlock( nAddressStart, pDst, nAddressLen );
+			delete [] pDst;
+		}
+
 		if (nRead == 1)
 		{
 			char text[ 128 ];
@@ -4534,18 +4521,12 @@ Update_t CmdMemoryMove (int nArgs)
 
 	if ((nAddressLen > 0) && (nAddressEnd <= _6502_MEM_END))
 	{
-		MemMarkDirty( nAddressStart, nAddressEnd );
-
-//			BYTE *pSrc = mem + nAddressStart;
-//			BYTE *pDst = mem + nDst;
-//			BYTE *pEnd = pSrc + nAddressLen;
-
 		while( nAddressLen-- ) // v2.7.0.23
 		{
 			// TODO: Optimize - split into pre_io, and post_io
 			if ((nDst < _6502_IO_BEGIN) || (nDst > _6502_IO_END))
 			{
-				*(mem + nDst) = *(mem + nAddressStart);
+				MemWriteByte(nDst, *MemGetReadPtr(nAddressStart));
 			}
 			nDst++;
 			nAddressStart++;
@@ -4640,15 +4621,9 @@ Update_t CmdMemorySave (int nArgs)
 //				if (nArgs == 2)
 			{
 				BYTE *pMemory = new BYTE [ nAddressLen ];
-				BYTE *pDst = pMemory;
-				BYTE *pSrc = mem + nAddressStart;
-				
+
 				// memcpy -- copy out of active memory bank
-				int iByte;
-				for( iByte = 0; iByte < nAddressLen; iByte++ )
-				{
-					*pDst++ = *pSrc++;
-				}
+				MemReadBlock( pMemory, nAddressStart, nAddressLen );
 
 				FILE *hFile = fopen( sLoadSaveFilePath, "rb" );
 				if (hFile)
@@ -4793,8 +4768,8 @@ Update_t CmdMemorySave (int nArgs)
 			}
 			_tcscat( sLoadSaveFilePath, g_sMemoryLoadSaveFileName );
 
-			const BYTE * const pMemBankBase = bBankSpecified ? MemGetBankPtr(nBank) : mem;
-			if (!pMemBankBase)
+			const BYTE * const pMemBankBase = bBankSpecified ? MemGetBankPtr(nBank) : NULL;
+			if (bBankSpecified && !pMemBankBase)
 			{
 				ConsoleBufferPush( TEXT( "Error: Bank out of range." ) );
 				return ConsoleUpdate();
@@ -4811,7 +4786,13 @@ Update_t CmdMemorySave (int nArgs)
 			hFile = fopen( sLoadSaveFilePath, "wb" );
 			if (hFile)
 			{
-				size_t nWrote = fwrite( pMemBankBase+nAddressStart, nAddressLen, 1, hFile );
+				// No bank: save the CPU's view of memory (via a temp buffer, as it may span differently paged-in pages)
+				BYTE * const pSrc = bBankSpecified ? NULL : new BYTE [ nAddressLen ];
+				if (!bBankSpecified)
+					MemReadBlock( pSrc, nAddressStart, nAddressLen );
+
+				size_t nWrote = fwrite( bBankSpecified ? pMemBankBase+nAddressStart : pSrc, nAddressLen, 1, hFile );
+				delete [] pSrc;
 				if (nWrote == 1)
 				{
 					ConsoleBufferPush( TEXT( "Saved." ) );
@@ -5703,7 +5684,7 @@ int _SearchMemoryFind(
 				(ms.m_iType == MEM_SEARCH_NIB_HIGH_EXACT) ||
 				(ms.m_iType == MEM_SEARCH_NIB_LOW_EXACT ))
 			{
-				BYTE nTarget = *(mem + nAddress2);
+				BYTE nTarget = *MemGetReadPtr(nAddress2);
 	
 				if (ms.m_iType == MEM_SEARCH_NIB_LOW_EXACT)
 					nTarget &= 0x0F;
@@ -5743,7 +5724,7 @@ int _SearchMemoryFind(
 						(ms.m_iType == MEM_SEARCH_NIB_HIGH_EXACT) ||
 						(ms.m_iType == MEM_SEARCH_NIB_LOW_EXACT ))
 					{
-						BYTE nTarget = *(mem + nAddress3);
+						BYTE nTarget = *MemGetReadPtr(nAddress3);
 			
 						if (ms.m_iType == MEM_SEARCH_NIB_LOW_EXACT)
 							nTarget &= 0x0F;
@@ -6657,7 +6638,7 @@ bool ParseAssemblyListing( bool bBytesToMemory, bool bAddSymbols )
 					if (TextIsHexByte( pStart ))
 					{
 						BYTE nByte = TextConvert2CharsToByte( pStart );
-						*(mem + ((WORD)nAddress) + iByte ) = nByte;
+						MemWriteByte(((WORD)nAddress) + iByte, nByte);
 					}
 				}
 				g_nSourceAssembleBytes += iByte;
@@ -8088,7 +8069,7 @@ void OutputTraceLine ()
 	if (g_bTraceFileWithVideoScanner)
 	{
 		uint16_t addr = NTSC_VideoGetScannerAddress(0);	// NB. uExecutedCycles==0 as SingleStep() called afterwards
-		BYTE data = mem[addr];
+		BYTE data = *MemGetReadPtr(addr);
 
 		fprintf( g_hTraceFile,
 			"%04X %04X %04X   %02X %02X %02X %02X %04X %s  %s\n",
@@ -8612,7 +8593,7 @@ void DebugContinueStepping ()
 
 			if ( MemIsAddrCodeMemory(regs.pc) )
 			{
-				BYTE nOpcode = *(mem+regs.pc);
+				BYTE nOpcode = *MemGetReadPtr(regs.pc);
 
 				// Update profiling stats
 				int  nOpmode = g_aOpcodes[ nOpcode ].nAddressMode;
@@ -8749,6 +8730,7 @@ static void DebugEnd ()
 
 	g_vMemorySearchResults.erase( g_vMemorySearchResults.begin(), g_vMemorySearchResults.end() );
 
+	CpuPredecodeInvalidate();	// Memory may have been modified by the debugger
 	g_nAppMode = MODE_RUNNING;
 
 	ReleaseDebuggerMemDC();
@@ -168,7 +168,7 @@ const Opcodes_t g_aOpcodes65C02[ NUM_OPCODES ] =
 };
 
 const Opcodes_t g_aOpcodes6502[ NUM_OPCODES ] =
-{ // Should match Cpu.cpp InternalCpuExecute() switch (*(mem+regs.pc++)) !!
+{ // Should match Cpu.cpp InternalCpuExecute() switch (*MemGetReadPtr(regs.pc++)) !!
 
 /*
 	Based on: http://axis.llx.com/~nparker/a2/opcodes.html
@@ -479,7 +479,7 @@ int  _6502_GetOpmodeOpbyte ( const int nBaseAddress, int & iOpmode_, int & nOpby
 	}
 #endif
 
-	int iOpcode_ = *(mem + nBaseAddress);
+	int iOpcode_ = *MemGetReadPtr(nBaseAddress);
 		iOpmode_ = g_aOpcodes[ iOpcode_ ].nAddressMode;
 		nOpbyte_ = g_aOpmodes[ iOpmode_ ].m_nBytes;
 
@@ -513,7 +513,7 @@ int  _6502_GetOpmodeOpbyte ( const int nBaseAddress, int & iOpmode_, int & nOpby
 			case NOP_WORD_2: nOpbyte_ = 4; iOpmode_ = AM_M; break;
 			case NOP_WORD_4: nOpbyte_ = 8; iOpmode_ = AM_M; break;
 			case NOP_ADDRESS:nOpbyte_ = 2; iOpmode_ = AM_A; // BUGFIX: 2.6.2.33 Define Address should be shown as Absolute mode, not Indirect Absolute mode. DA BASIC.FPTR D000:D080 // was showing as "da (END-1)" now shows as "da END-1"
-				pData->nTargetAddress = *(LPWORD)(mem+nBaseAddress);
+				pData->nTargetAddress = MemReadWord(nBaseAddress);
 				break;
 			case NOP_STRING_APPLE:
 				iOpmode_ = AM_DATA;
@@ -571,10 +571,10 @@ bool _6502_GetStackReturnAddress ( WORD & nAddress_ )
 
 	if (nStack <= (_6502_STACK_END - 1))
 	{
-		nAddress_ = (unsigned)*(LPBYTE)(mem + nStack);
+		nAddress_ = (unsigned)*MemGetReadPtr(nStack);
 		nStack++;
 		
-		nAddress_ += ((unsigned)*(LPBYTE)(mem + nStack)) << 8;
+		nAddress_ += ((unsigned)*MemGetReadPtr(nStack)) << 8;
 		nAddress_++;
 		return true;
 	}
@@ -608,9 +608,9 @@ bool _6502_GetTargets ( WORD nAddress, int *pTargetPartial_, int *pTargetPartial
 
 	bStatus   = true;
 
-	BYTE nOpcode   = mem[nAddress];
-	BYTE nTarget8  = mem[(nAddress+1)&0xFFFF];
-	WORD nTarget16 = (mem[(nAddress+2)&0xFFFF]<<8) | nTarget8;
+	BYTE nOpcode   = *MemGetReadPtr(nAddress);
+	BYTE nTarget8  = *MemGetReadPtr((nAddress+1)&0xFFFF);
+	WORD nTarget16 = (*MemGetReadPtr((nAddress+2)&0xFFFF)<<8) | nTarget8;
 
 	int eMode = g_aOpcodes[ nOpcode ].nAddressMode;
 
@@ -634,7 +634,7 @@ bool _6502_GetTargets ( WORD nAddress, int *pTargetPartial_, int *pTargetPartial
 
 					*pTargetPartial_  = _6502_STACK_BEGIN + ((sp+1) & 0xFF);
 					*pTargetPartial2_ = _6502_STACK_BEGIN + ((sp+2) & 0xFF);
-					nTarget16 = mem[*pTargetPartial_] + (mem[*pTargetPartial2_]<<8);
+					nTarget16 = *MemGetReadPtr(*pTargetPartial_) + (*MemGetReadPtr(*pTargetPartial2_)<<8);
 
 					if (nOpcode == OPCODE_RTS)
 						++nTarget16;
@@ -646,7 +646,7 @@ bool _6502_GetTargets ( WORD nAddress, int *pTargetPartial_, int *pTargetPartial
 					//*pTargetPartial3_ = _6502_STACK_BEGIN + ((regs.sp-2) & 0xFF);	// TODO: PHP
 					//*pTargetPartial4_ = _6502_BRK_VECTOR + 0;	// TODO
 					//*pTargetPartial5_ = _6502_BRK_VECTOR + 1;	// TODO
-					nTarget16 = *(LPWORD)(mem + _6502_BRK_VECTOR);
+					nTarget16 = MemReadWord(_6502_BRK_VECTOR);
 				}
 				else	// PHn/PLn
 				{
@@ -678,7 +678,7 @@ bool _6502_GetTargets ( WORD nAddress, int *pTargetPartial_, int *pTargetPartial
 		case AM_IAX: // Indexed (Absolute) Indirect
 			nTarget16 += regs.x;
 			*pTargetPartial_    = nTarget16;
-			*pTargetPointer_    = *(LPWORD)(mem + nTarget16);
+			*pTargetPointer_    = MemReadWord(nTarget16);
 			if (pTargetBytes_)
 				*pTargetBytes_ = 2;
 			break;
@@ -699,7 +699,7 @@ bool _6502_GetTargets ( WORD nAddress, int *pTargetPartial_, int *pTargetPartial
 
 		case AM_NA: // Indirect (Absolute) i.e. JMP
 			*pTargetPartial_    = nTarget16;
-			*pTargetPointer_    = *(LPWORD)(mem + nTarget16);
+			*pTargetPointer_    = MemReadWord(nTarget16);
 			if (pTargetBytes_)
 				*pTargetBytes_ = 2;
 			break;
@@ -707,21 +707,21 @@ bool _6502_GetTargets ( WORD nAddress, int *pTargetPartial_, int *pTargetPartial
 		case AM_IZX: // Indexed (Zeropage Indirect, X)
 			nTarget8  += regs.x;
 			*pTargetPartial_    = nTarget8;
-			*pTargetPointer_    = *(LPWORD)(mem + nTarget8);
+			*pTargetPointer_    = MemReadWord(nTarget8);
 			if (pTargetBytes_)
 				*pTargetBytes_ = 2;
 			break;
 
 		case AM_NZY: // Indirect (Zeropage) Indexed, Y
 			*pTargetPartial_    = nTarget8;
-			*pTargetPointer_    = ((*(LPWORD)(mem + nTarget8)) + regs.y) & _6502_MEM_END; // Bugfix: 
+			*pTargetPointer_    = (MemReadWord(nTarget8) + regs.y) & _6502_MEM_END; // Bugfix: 
 			if (pTargetBytes_)
 				*pTargetBytes_ = 1;
 			break;
 
 		case AM_NZ: // Indirect (Zeropage)
 			*pTargetPartial_    = nTarget8;
-			*pTargetPointer_    = *(LPWORD)(mem + nTarget8);
+			*pTargetPointer_    = MemReadWord(nTarget8);
 			if (pTargetBytes_)
 				*pTargetBytes_ = 2;
 			break;
@@ -1011,14 +1011,13 @@ int AssemblerPokeAddress( const int Opcode, const int nOpmode, const WORD nBaseA
 	// if (nOpbytes != nBytes)
 	//	ConsoleDisplayError( TEXT(" ERROR: Input Opcode bytes differs from actual!" ) );
 
-	*(memdirty + (nBaseAddress >> 8)) |= 1;
-//	*(mem + nBaseAddress) = (BYTE) nOpcode;
+//	*MemGetReadPtr(nBaseAddress) = (BYTE) nOpcode;
 
 	if (nOpbytes > 1)
-		*(mem + nBaseAddress + 1) = (BYTE)(nTargetOffset >> 0);
+		MemWriteByte(nBaseAddress + 1, (BYTE)(nTargetOffset >> 0));
 
 	if (nOpbytes > 2)
-		*(mem + nBaseAddress + 2) = (BYTE)(nTargetOffset >> 8);
+		MemWriteByte(nBaseAddress + 2, (BYTE)(nTargetOffset >> 8));
 
 	return nOpbytes;
 }
@@ -1039,7 +1038,7 @@ bool AssemblerPokeOpcodeAddress( const WORD nBaseAddress )
 
 		if (nOpmode == iAddressMode)
 		{
-			*(mem + nBaseAddress) = (BYTE) nOpcode;
+			MemWriteByte(nBaseAddress, (BYTE) nOpcode);
 			int nOpbytes = AssemblerPokeAddress( nOpcode, nOpmode, nBaseAddress, nTargetValue );
 
 			if (m_bDelayedTargetsDirty)
@@ -1453,7 +1452,6 @@ void AssemblerProcessDelayedSymols()
 				if (bModified)
 				{
 					AssemblerPokeAddress( nOpcode, nOpmode, pTarget->m_nBaseAddress, nTargetValue );
-					*(memdirty + (pTarget->m_nBaseAddress >> 8)) |= 1;
 
 					m_vDelayedTargets.erase( iSymbol );
 
@@ -1393,7 +1393,7 @@ int GetDisassemblyLine ( WORD nBaseAddress, DisasmLine_t & line_ )
 		{
 			nTarget = pData->nTargetAddress;
 		} else {
-			nTarget = *(LPWORD)(mem+nBaseAddress+1);
+			nTarget = MemReadWord(nBaseAddress+1);
 			if (nOpbyte == 2)
 				nTarget &= 0xFF;
 		}
@@ -1518,7 +1518,7 @@ int GetDisassemblyLine ( WORD nBaseAddress, DisasmLine_t & line_ )
 			{
 				bDisasmFormatFlags |= DISASM_FORMAT_TARGET_POINTER;
 
-				nTargetValue = *(mem + nTargetPointer) | (*(mem + ((nTargetPointer + 1) & 0xffff)) << 8);
+				nTargetValue = *MemGetReadPtr(nTargetPointer) | (*MemGetReadPtr((nTargetPointer + 1) & 0xffff) << 8);
 
 //				if (((iOpmode >= AM_A) && (iOpmode <= AM_NZ)) && (iOpmode != AM_R))
 				// nTargetBytes refers to size of pointer, not size of value
@@ -1634,7 +1634,7 @@ void FormatOpcodeBytes ( WORD nBaseAddress, DisasmLine_t & line_ )
 
 	for( int iByte = 0; iByte < nMaxOpBytes; iByte++ )
 	{
-		BYTE nMem = (unsigned)*(mem+nBaseAddress + iByte);
+		BYTE nMem = (unsigned)*MemGetReadPtr(nBaseAddress + iByte);
 		sprintf( pDst, "%02X", nMem ); // sBytes+strlen(sBytes)
 		pDst += 2;
 
@@ -1653,6 +1653,7 @@ void FormatNopcodeBytes ( WORD nBaseAddress, DisasmLine_t & line_ )
 {
 		char *pDst = line_.sTarget;
 const	char *pSrc = 0;
+		char  aText[ MAX_IMMEDIATE_LEN ]; // NB. Only up to MAX_IMMEDIATE_LEN chars of text are displayed
 		DWORD nStartAddress = line_.pDisasmData->nStartAddress;
 		DWORD nEndAddress   = line_.pDisasmData->nEndAddress  ;
 		int   nDataLen      = nEndAddress - nStartAddress + 1 ;
@@ -1661,8 +1662,8 @@ const	char *pSrc = 0;
 
 	for( int iByte = 0; iByte < line_.nOpbyte; )
 	{
-		BYTE nTarget8  = *(LPBYTE)(mem + nBaseAddress + iByte);
-		WORD nTarget16 = *(LPWORD)(mem + nBaseAddress + iByte);
+		BYTE nTarget8  = *MemGetReadPtr(nBaseAddress + iByte);
+		WORD nTarget16 = MemReadWord(nBaseAddress + iByte);
 		
 		switch( line_.iNoptype )
 		{
@@ -1696,12 +1697,13 @@ const	char *pSrc = 0;
 				break;
 			case NOP_STRING_APPLESOFT:
 				iByte = line_.nOpbyte;
-				strncpy( pDst, (const char*)(mem + nBaseAddress), iByte );
+				MemReadBlock( (LPBYTE)pDst, nBaseAddress, iByte );
 				pDst += iByte;
 				*pDst = 0;
 			case NOP_STRING_APPLE:
 				iByte = line_.nOpbyte; // handle all bytes of text
-				pSrc = (const char*)mem + nStartAddress;
+				MemReadBlock( (LPBYTE)aText, (WORD)nStartAddress, (len < MAX_IMMEDIATE_LEN) ? len : MAX_IMMEDIATE_LEN );
+				pSrc = aText;
 				
 				if (len > (MAX_IMMEDIATE_LEN - 2)) // does "text" fit?
 				{
@@ -2575,7 +2577,7 @@ void DrawMemory ( int line, int iMemDump )
 			}
 			else
 			{
-				BYTE nData = (unsigned)*(LPBYTE)(mem+iAddress);
+				BYTE nData = (unsigned)*MemGetReadPtr(iAddress);
 				sText[0] = 0;
 
 				char c = nData;
@@ -3178,7 +3180,7 @@ void DrawStack ( int line)
 		if (nAddress <= _6502_STACK_END)
 		{
 			DebuggerSetColorFG( DebuggerGetColor( FG_INFO_OPCODE )); // COLOR_FG_DATA_TEXT
-			sprintf(sText, "  %02X",(unsigned)*(LPBYTE)(mem+nAddress));
+			sprintf(sText, "  %02X",(unsigned)*MemGetReadPtr(nAddress));
 			PrintTextCursorX( sText, rect );
 		}
 		iStack++;
@@ -3218,9 +3220,9 @@ void DrawTargets ( int line)
 		{
 			sprintf(sAddress,"%04X",aTarget[iAddress]);
 			if (iAddress)
-				sprintf(sData,"%02X",*(LPBYTE)(mem+aTarget[iAddress]));
+				sprintf(sData,"%02X",*MemGetReadPtr(aTarget[iAddress]));
 			else
-				sprintf(sData,"%04X",*(LPWORD)(mem+aTarget[iAddress]));
+				sprintf(sData,"%04X",MemReadWord(aTarget[iAddress]));
 		}
 
 		rect.left   = DISPLAY_TARGETS_COLUMN;
@@ -3302,12 +3304,12 @@ void DrawWatches (int line)
 			BYTE nTarget8 = 0;
 			BYTE nValue8 = 0;
 
-			nTarget8 = (unsigned)*(LPBYTE)(mem+g_aWatches[iWatch].nAddress);
+			nTarget8 = (unsigned)*MemGetReadPtr(g_aWatches[iWatch].nAddress);
 			sprintf(sText,"%02X", nTarget8 );
 			DebuggerSetColorFG( DebuggerGetColor( FG_INFO_OPCODE ));
 			PrintTextCursorX( sText, rect2 );
 
-			nTarget8 = (unsigned)*(LPBYTE)(mem+g_aWatches[iWatch].nAddress + 1);
+			nTarget8 = (unsigned)*MemGetReadPtr(g_aWatches[iWatch].nAddress + 1);
 			sprintf(sText,"%02X", nTarget8 );
 			DebuggerSetColorFG( DebuggerGetColor( FG_INFO_OPCODE ));
 			PrintTextCursorX( sText, rect2 );
@@ -3316,7 +3318,7 @@ void DrawWatches (int line)
 			DebuggerSetColorFG( DebuggerGetColor( FG_INFO_OPERATOR ));
 			PrintTextCursorX( sText, rect2 );
 
-			WORD nTarget16 = (unsigned)*(LPWORD)(mem+g_aWatches[iWatch].nAddress);
+			WORD nTarget16 = (unsigned)MemReadWord(g_aWatches[iWatch].nAddress);
 			sprintf( sText,"%04X", nTarget16 );
 			DebuggerSetColorFG( DebuggerGetColor( FG_INFO_ADDRESS ));
 			PrintTextCursorX( sText, rect2 );
@@ -3325,7 +3327,7 @@ void DrawWatches (int line)
 //			PrintTextCursorX( ":", rect2 );
 			PrintTextCursorX( ")", rect2 );
 
-//			BYTE nValue8 = (unsigned)*(LPBYTE)(mem + nTarget16);
+//			BYTE nValue8 = (unsigned)*MemGetReadPtr(nTarget16);
 //			sprintf(sText,"%02X", nValue8 );
 //			DebuggerSetColorFG( DebuggerGetColor( FG_INFO_OPCODE ));
 //			PrintTextCursorX( sText, rect2 );
@@ -3349,7 +3351,7 @@ void DrawWatches (int line)
 				else
 					DebuggerSetColorBG( DebuggerGetColor( BG_DATA_2 ));
 
-				BYTE nValue8 = (unsigned)*(LPBYTE)(mem + nTarget16 + iByte );
+				BYTE nValue8 = (unsigned)*MemGetReadPtr(nTarget16 + iByte);
 				sprintf(sText,"%02X", nValue8 );
 				PrintTextCursorX( sText, rect2 );
 			}
@@ -3457,7 +3459,7 @@ void DrawZeroPagePointers ( int line )
 			DebuggerSetColorFG( DebuggerGetColor( FG_INFO_OPERATOR ));
 			PrintTextCursorX( ":", rect2 );
 
-			WORD nTarget16 = (WORD)mem[ nZPAddr1 ] | ((WORD)mem[ nZPAddr2 ]<< 8);
+			WORD nTarget16 = (WORD)*MemGetReadPtr(nZPAddr1) | ((WORD)*MemGetReadPtr(nZPAddr2)<< 8);
 			sprintf( sText, "%04X", nTarget16 );
 			DebuggerSetColorFG( DebuggerGetColor( FG_INFO_ADDRESS ));
 			PrintTextCursorX( sText, rect2 );
@@ -3465,7 +3467,7 @@ void DrawZeroPagePointers ( int line )
 			DebuggerSetColorFG( DebuggerGetColor( FG_INFO_OPERATOR ));
 			PrintTextCursorX( ":", rect2 );
 
-			BYTE nValue8 = (unsigned)*(LPBYTE)(mem + nTarget16);
+			BYTE nValue8 = (unsigned)*MemGetReadPtr(nTarget16);
 			sprintf(sText, "%02X", nValue8 );
 			DebuggerSetColorFG( DebuggerGetColor( FG_INFO_OPCODE ));
 			PrintTextCursorX( sText, rect2 );
@@ -3570,7 +3572,7 @@ void DrawSubWindow_Data (Update_t bUpdate)
 		sOpcodes[0] = 0;
 		for ( iByte = 0; iByte < nMaxOpcodes; iByte++ )
 		{
-			BYTE nData = (unsigned)*(LPBYTE)(mem + iAddress + iByte);
+			BYTE nData = (unsigned)*MemGetReadPtr(iAddress + iByte);
 			sprintf( &sOpcodes[ iByte * 3 ], "%02X ", nData );
 		}
 		sOpcodes[ nMaxOpcodes * 3 ] = 0;
@@ -3621,7 +3623,7 @@ void DrawSubWindow_Data (Update_t bUpdate)
 		iAddress = nAddress;
 		for (iByte = 0; iByte < nMaxOpcodes; iByte++ )
 		{
-			BYTE nImmediate = (unsigned)*(LPBYTE)(mem + iAddress);
+			BYTE nImmediate = (unsigned)*MemGetReadPtr(iAddress);
 			int iTextBackground = iBackground;
 			if ((iAddress >= _6502_IO_BEGIN) && (iAddress <= _6502_IO_END))
 			{
@@ -410,7 +410,10 @@ void __stdcall Disk2InterfaceCard::ControlMotor(WORD, WORD address, BYTE, BYTE,
 	BOOL newState = address & 1;
 
 	if (newState != m_floppyMotorOn)	// motor changed state
+	{
 		m_formatTrack.DriveNotWritingTrack();
+		CpuSetDiskAccelActive(false);	// Forget the last latch access: must see a new one before accelerating again
+	}
 
 	m_floppyMotorOn = newState;
 	// NB. Motor off doesn't reset the Command Decoder like reset. (UTAIIe figures 9.7 & 9.8 chip C2)
@@ -532,6 +535,9 @@ void Disk2InterfaceCard::Destroy(void)
 
 void __stdcall Disk2InterfaceCard::Enable(WORD, WORD address, BYTE, BYTE, ULONG uExecutedCycles)
 {
+	if (m_currDrive != (address & 1))
+		CpuSetDiskAccelActive(false);	// Last latch access was for the other drive (which may be a different image type)
+
 	m_currDrive = address & 1;
 #if LOG_DISK_ENABLE_DRIVE
 	LOG_DISK("enable drive: %d\r\n", m_currDrive);
@@ -635,11 +641,15 @@ ImageError_e Disk2InterfaceCard::InsertDisk(const int drive, LPCTSTR pszImageFil
 		bCreateIfNecessary,
 		pFloppy->m_strFilenameInZip);
 
-	if (Error == eIMAGE_ERROR_NONE && ImageIsMultiFileZip(pFloppy->m_imagehandle))
+	// NB. A file in the zip can be chosen with a pathname of "<archive>.zip\<file>", so only ask when given just the archive
+	const char* pszExt = strrchr(pszImageFilename, '.');
+	const bool bZipArchive = pszExt && _stricmp(pszExt, ".zip") == 0;
+
+	if (Error == eIMAGE_ERROR_NONE && bZipArchive && ImageIsMultiFileZip(pFloppy->m_imagehandle))
 	{
-		TCHAR szText[100+MAX_PATH];
-		StringCbPrintf(szText, sizeof(szText), "Only the first file in a multi-file zip is supported\nUse disk image '%s' ?", pFloppy->m_strFilenameInZip.c_str());
-		int nRes = MessageBox(g_hFrameWindow, szText, TEXT("Multi-Zip Warning"), MB_ICONWARNING | MB_YESNO | MB_SETFOREGROUND);
+		TCHAR szText[200+2*MAX_PATH];
+		StringCbPrintf(szText, sizeof(szText), "This zip contains multiple files\nUse disk image '%s' ?\n\n(Insert '%s\\<file>' to use another file in the zip)", pFloppy->m_strFilenameInZip.c_str(), pszImageFilename);
+		int nRes = FrameMessageBox(szText, TEXT("Multi-Zip Warning"), MB_ICONWARNING | MB_YESNO | MB_SETFOREGROUND);
 		if (nRes == IDNO)
 		{
 			RemoveDisk(drive);
@@ -669,6 +679,13 @@ bool Disk2InterfaceCard::IsConditionForFullSpeed(void)
 	return m_floppyMotorOn && m_enhanceDisk;
 }
 
+// Disk-only acceleration (see CpuDiskAccel()) is only for nibble images: the data latch hook is in ReadWrite(), which WOZ images don't use
+bool Disk2InterfaceCard::IsConditionForDiskAccel(void)
+{
+	ImageInfo* pImage = m_floppyDrive[m_currDrive].m_disk.m_imagehandle;
+	return IsConditionForFullSpeed() && pImage && !ImageIsWOZ(pImage);
+}
+
 //===========================================================================
 
 void Disk2InterfaceCard::NotifyInvalidImage(const int drive, LPCTSTR pszImageFilename, const ImageError_e Error)
@@ -729,7 +746,7 @@ void Disk2InterfaceCard::NotifyInvalidImage(const int drive, LPCTSTR pszImageFil
 			szBuffer,
 			MAX_PATH + 128,
 			TEXT("Unable to use the file %s\nbecause the ")
-			TEXT("first file (%s) in this multi-zip archive is not recognized.\n")
+			TEXT("file (%s) in this multi-zip archive is not recognized.\n")
 			TEXT("Try unzipping and using the disk images directly.\n"),
 			pszImageFilename,
 			m_floppyDrive[drive].m_disk.m_strFilenameInZip.c_str());
@@ -774,8 +791,7 @@ void Disk2InterfaceCard::NotifyInvalidImage(const int drive, LPCTSTR pszImageFil
 		return;
 	}
 
-	MessageBox(
-		g_hFrameWindow,
+	FrameMessageBox(
 		szBuffer,
 		g_pAppTitle,
 		MB_ICONEXCLAMATION | MB_SETFOREGROUND);
@@ -898,6 +914,9 @@ void __stdcall Disk2InterfaceCard::ReadWrite(WORD pc, WORD addr, BYTE bWrite, BY
 		}
 	}
 
+	if (m_enhanceDisk)
+		CpuDiskAccelLatchAccess(pc);
+
 	if (!m_floppyWriteMode)
 	{
 		// Don't change latch if drive off after 1 second drive-off delay (UTAIIe page 9-13)
@@ -1099,6 +1118,164 @@ void __stdcall Disk2InterfaceCard::DataLatchReadWriteWOZ(WORD pc, WORD addr, BYT
 		FrameDrawDiskStatus((HDC)0);
 }
 
+// LSS byte transitions, for DataLatchReadWOZ()'s fast path:
+// . the result of clocking 8 bits through the LSS (as per DataLatchReadWOZ()'s per-bit loop)
+// . indexed by [latch delay (0,3,4,7)][shift register][8 bits, 1st bit in b7]
+
+struct LSSByteTransition
+{
+	BYTE shiftReg;
+	BYTE latchDelay;
+	BYTE latch;			// Only valid if (flags & kLSSLatchLoaded)
+	BYTE nibble;		// Only valid if (flags & kLSSNibbleLoaded) - at most one per 8 bits
+	BYTE flags;
+	BYTE dbgLatchDelayedCnt;	// #increments (after any reset)
+};
+
+enum
+{
+	kLSSLatchLoaded = 1<<0,
+	kLSSNibbleLoaded = 1<<1,
+	kLSSDbgCntReset = 1<<2,
+};
+
+static const int kNumLSSLatchDelays = 4;
+static LSSByteTransition g_lssByteTransition[kNumLSSLatchDelays][256][256];	// 1.5MB
+static bool g_bLSSByteTransitionInit = false;
+
+static int LSSLatchDelayToIndex(const int latchDelay)
+{
+	switch (latchDelay)
+	{
+	case 0: return 0;
+	case 3: return 1;
+	case 4: return 2;
+	case 7: return 3;
+	}
+	return -1;	// eg. from a save-state
+}
+
+static void InitLSSByteTransitions(void)
+{
+	const int latchDelays[kNumLSSLatchDelays] = {0,3,4,7};
+
+	for (int delayIdx = 0; delayIdx < kNumLSSLatchDelays; delayIdx++)
+	{
+		for (UINT shiftReg = 0; shiftReg < 256; shiftReg++)
+		{
+			for (UINT bits = 0; bits < 256; bits++)
+			{
+				BYTE sr = shiftReg;
+				int latchDelay = latchDelays[delayIdx];
+				BYTE latch = 0;
+				BYTE nibble = 0;
+				BYTE flags = 0;
+				UINT dbgCnt = 0;
+
+				for (int i = 7; i >= 0; i--)
+				{
+					sr <<= 1;
+					sr |= (bits >> i) & 1;
+
+					if (latchDelay)
+					{
+						latchDelay -= 4;
+						if (latchDelay < 0)
+							latchDelay = 0;
+
+						if (sr)
+						{
+							flags |= kLSSDbgCntReset;
+							dbgCnt = 0;
+						}
+						else
+						{
+							latchDelay += 4;
+							dbgCnt++;
+						}
+					}
+
+					if (!latchDelay)
+					{
+						latch = sr;
+						flags |= kLSSLatchLoaded;
+
+						if (sr & 0x80)
+						{
+							_ASSERT(!(flags & kLSSNibbleLoaded));
+							nibble = sr;
+							flags |= kLSSNibbleLoaded;
+							latchDelay = 7;
+							sr = 0;
+						}
+					}
+				}
+
+				_ASSERT(LSSLatchDelayToIndex(latchDelay) >= 0);
+
+				LSSByteTransition& t = g_lssByteTransition[delayIdx][shiftReg][bits];
+				t.shiftReg = sr;
+				t.latchDelay = latchDelay;
+				t.latch = latch;
+				t.nibble = nibble;
+				t.flags = flags;
+				t.dbgLatchDelayedCnt = dbgCnt;
+			}
+		}
+	}
+
+	g_bLSSByteTransitionInit = true;
+}
+
+// Clock a whole byte of the bit-stream through the LSS, but only for the common case:
+// . the bit-stream is byte aligned, and won't wrap within this byte
+// . no weak bits, ie. the head window never sees 4 consecutive zeros (so no rand() output bits)
+// Returns false (having changed nothing) if the per-bit path must be used instead
+bool Disk2InterfaceCard::DataLatchReadWOZByte(FloppyDrive& drive, FloppyDisk& floppy)
+{
+	if (floppy.m_bitMask != 0x80 || floppy.m_bitOffset + 8 >= floppy.m_bitCount || m_resetSequencer)
+		return false;
+
+	const int delayIdx = LSSLatchDelayToIndex(m_latchDelay);
+	if (delayIdx < 0)
+		return false;
+
+	const BYTE n = floppy.m_trackimage[floppy.m_byte];
+
+	// Head window after each of the 8 bits is shifted in = bits [k+3:k] of these 11 bits (for k=7..0)
+	const UINT zeros = ~(((drive.m_headWindow & 7) << 8) | n) & 0x7FF;
+	if ((zeros & (zeros >> 1) & (zeros >> 2) & (zeros >> 3)) & 0xFF)
+		return false;
+
+	if (!g_bLSSByteTransitionInit)
+		InitLSSByteTransitions();
+
+	// The LSS sees the head window's b1, so lags the bit-stream by one bit
+	const BYTE bits = ((drive.m_headWindow & 1) << 7) | (n >> 1);
+	drive.m_headWindow = n;
+
+	floppy.m_byte++;
+	floppy.m_bitOffset += 8;
+
+	const LSSByteTransition& t = g_lssByteTransition[delayIdx][m_shiftReg][bits];
+	m_shiftReg = t.shiftReg;
+	m_latchDelay = t.latchDelay;
+
+	if (t.flags & kLSSLatchLoaded)
+		m_floppyLatch = t.latch;
+
+	if (t.flags & kLSSDbgCntReset)
+		m_dbgLatchDelayedCnt = 0;
+	m_dbgLatchDelayedCnt += t.dbgLatchDelayedCnt;
+
+#if LOG_DISK_NIBBLES_READ
+	if (t.flags & kLSSNibbleLoaded)
+		m_formatTrack.DecodeLatchNibbleRead(t.nibble);	// As per the per-bit path
+#endif
+
+	return true;
+}
+
 void Disk2InterfaceCard::DataLatchReadWOZ(WORD pc, WORD addr, UINT bitCellRemainder)
 {
 	// m_diskLastReadLatchCycle = g_nCumulativeCycles;	// Not used by WOZ (only by NIB)
@@ -1121,6 +1298,14 @@ void Disk2InterfaceCard::DataLatchReadWOZ(WORD pc, WORD addr, UINT bitCellRemain
 
 	for (UINT i = 0; i < bitCellRemainder; i++)
 	{
+#if !(LOG_DISK_ENABLED && LOG_DISK_NIBBLES_READ)	// Per-bit path logs skipped latch data
+		if (bitCellRemainder - i >= 8 && DataLatchReadWOZByte(drive, floppy))
+		{
+			i += 8-1;	// NB. loop increments i
+			continue;
+		}
+#endif
+
 		BYTE n = floppy.m_trackimage[floppy.m_byte];
 
 		drive.m_headWindow <<= 1;
@@ -1602,6 +1787,201 @@ bool Disk2InterfaceCard::DriveSwap(void)
 
 //===========================================================================
 
+// Fast disk (cmd-line: -fast-disk):
+// . Requests to the DOS 3.3 RWTS and to the ProDOS Disk II driver are satisfied directly from the image, a sector (or block) at a time,
+//   instead of the 6502 code stepping the head and reading/writing every nibble via the LSS
+// . Only for DO & PO images, and only for read & write (& RWTS seek) requests
+//   - everything else (eg. FORMAT, NIB & WOZ images, or software with its own RWTS) falls back to nibble-level emulation
+// . The head isn't moved, so RWTS's & ProDOS's record of the current track stays correct for any subsequent non-trapped request
+// . Memory is accessed as the 6502 would, ie. via the current memory paging
+
+static const WORD kRWTSEntry = 0xBD00;		// DOS 3.3: STY $48 ; STA $49
+static const WORD kProDOSMLIEntry = 0xBF00;	// ProDOS: JMP MLI
+static const WORD kProDOSDevAdr = 0xBF10;	// ProDOS: driver entry for slot 0-7, drive 1 (then drive 2 at +$10)
+
+static BYTE FastDiskReadByte(const WORD addr)
+{
+	return *MemGetReadPtr(addr);
+}
+
+static void FastDiskWriteByte(const WORD addr, const BYTE value)
+{
+	memdirty[addr >> 8] = 0xFF;
+	LPBYTE page = memwrite[addr >> 8];
+	if (page)
+		*(page+(addr & 0xFF)) = value;
+}
+
+static bool FastDiskIsIOSpace(const WORD addr, const UINT length)
+{
+	return (addr + length > 0x10000) || (addr < 0xD000 && addr + length > 0xC000);
+}
+
+WORD Disk2InterfaceCard::GetProDOSDriverEntry(const int drive)
+{
+	return MemReadWord(kProDOSDevAdr + m_slot*2 + (drive == DRIVE_2 ? 0x10 : 0));
+}
+
+// Called once per CpuExecute(), as DOS or ProDOS may have been loaded (or overwritten) since
+UINT Disk2InterfaceCard::GetFastDiskTraps(WORD* pTraps)
+{
+	UINT uNumTraps = 0;
+
+	if (IsDriveEmpty(DRIVE_1) && IsDriveEmpty(DRIVE_2))
+		return uNumTraps;
+
+	if (FastDiskReadByte(kRWTSEntry+0) == 0x84 && FastDiskReadByte(kRWTSEntry+1) == 0x48 &&
+		FastDiskReadByte(kRWTSEntry+2) == 0x85 && FastDiskReadByte(kRWTSEntry+3) == 0x49)
+		pTraps[uNumTraps++] = kRWTSEntry;
+
+	if (FastDiskReadByte(kProDOSMLIEntry) == 0x4C)
+	{
+		pTraps[uNumTraps++] = GetProDOSDriverEntry(DRIVE_1);
+		pTraps[uNumTraps++] = GetProDOSDriverEntry(DRIVE_2);
+	}
+
+	return uNumTraps;
+}
+
+// Returns false if the request must be handled by the 6502 code, else:
+// . a & bError are the return code & carry flag for the caller
+// . uSectors is the number of sectors transferred (for the cycles to charge)
+bool Disk2InterfaceCard::FastDiskTrap(const WORD pc, BYTE& a, bool& bError, UINT& uSectors)
+{
+	if (pc == kRWTSEntry)
+		return FastDiskRWTS(a, bError, uSectors);
+
+	return FastDiskProDOS(pc, a, bError, uSectors);
+}
+
+// The track image being read/written by the LSS (if any) is stale after a sector write
+void Disk2InterfaceCard::FastDiskInvalidateTrack(const int drive, const UINT track)
+{
+	FloppyDrive* pDrive = &m_floppyDrive[drive];
+	if (ImagePhaseToTrack(pDrive->m_disk.m_imagehandle, pDrive->m_phasePrecise) == track)
+		pDrive->m_disk.m_trackimagedata = false;
+}
+
+// RWTS: A/Y = IOB
+bool Disk2InterfaceCard::FastDiskRWTS(BYTE& a, bool& bError, UINT& uSectors)
+{
+	const WORD iob = (regs.a << 8) | regs.y;
+	if (FastDiskIsIOSpace(iob, 0x11))
+		return false;
+
+	if (FastDiskReadByte(iob+0x00) != 0x01 || FastDiskReadByte(iob+0x01) != (m_slot << 4))	// IOB type ; slot*16
+		return false;
+
+	const BYTE driveNum = FastDiskReadByte(iob+0x02);
+	const BYTE command = FastDiskReadByte(iob+0x0C);
+	if ((driveNum != 1 && driveNum != 2) || command > 2)	// 0=seek, 1=read, 2=write, 4=format
+		return false;
+
+	const int drive = driveNum - 1;
+	const BYTE track = FastDiskReadByte(iob+0x04);
+	const BYTE sector = FastDiskReadByte(iob+0x05);
+	const WORD buffer = FastDiskReadByte(iob+0x08) | (FastDiskReadByte(iob+0x09) << 8);
+	if (command != 0 && FastDiskIsIOSpace(buffer, 256))
+		return false;
+
+	FloppyDisk* pFloppy = &m_floppyDrive[drive].m_disk;
+	if (!pFloppy->m_imagehandle)
+		return false;
+
+	FlushCurrentTrack(drive);
+
+	BYTE sectorBuffer[256];
+	if (!ImageReadSector(pFloppy->m_imagehandle, track, sector, sectorBuffer))
+		return false;	// Not a DO or PO image (or track/sector out of range)
+
+	const BYTE volume = ImageGetVolumeNumber(pFloppy->m_imagehandle);
+	const BYTE expectedVolume = FastDiskReadByte(iob+0x03);
+	BYTE rc = 0x00;
+
+	if (expectedVolume && expectedVolume != volume)
+	{
+		rc = 0x20;	// Volume mismatch
+	}
+	else if (command == 1)
+	{
+		for (UINT i = 0; i < 256; i++)
+			FastDiskWriteByte(buffer+i, sectorBuffer[i]);
+	}
+	else if (command == 2)
+	{
+		for (UINT i = 0; i < 256; i++)
+			sectorBuffer[i] = FastDiskReadByte(buffer+i);
+
+		if (pFloppy->m_bWriteProtected || !ImageWriteSector(pFloppy->m_imagehandle, track, sector, sectorBuffer))
+			rc = 0x10;	// Write protected
+		else
+			FastDiskInvalidateTrack(drive, track);
+	}
+
+	FastDiskWriteByte(iob+0x0D, rc);
+	FastDiskWriteByte(iob+0x0E, volume);
+	FastDiskWriteByte(iob+0x0F, m_slot << 4);
+	FastDiskWriteByte(iob+0x10, driveNum);
+
+	a = rc;
+	bError = rc != 0x00;
+	uSectors = 1;
+	return true;
+}
+
+// ProDOS driver: $42=command, $43=unit (DSSS0000), $44/45=buffer, $46/47=block
+bool Disk2InterfaceCard::FastDiskProDOS(const WORD pc, BYTE& a, bool& bError, UINT& uSectors)
+{
+	const BYTE unit = FastDiskReadByte(0x43);
+	const int drive = (unit & 0x80) ? DRIVE_2 : DRIVE_1;
+	if (((unit >> 4) & 7) != m_slot || pc != GetProDOSDriverEntry(drive))
+		return false;
+
+	const BYTE command = FastDiskReadByte(0x42);
+	if (command != 1 && command != 2)	// 0=status, 1=read, 2=write, 3=format
+		return false;
+
+	const WORD buffer = MemReadWord(0x44);
+	const WORD block = MemReadWord(0x46);
+	if (FastDiskIsIOSpace(buffer, 512))
+		return false;
+
+	FloppyDisk* pFloppy = &m_floppyDrive[drive].m_disk;
+	if (!pFloppy->m_imagehandle)
+		return false;
+
+	FlushCurrentTrack(drive);
+
+	BYTE blockBuffer[512];
+	if (!ImageReadBlock(pFloppy->m_imagehandle, block, blockBuffer))
+		return false;	// Not a DO or PO image (or block out of range)
+
+	BYTE rc = 0x00;
+
+	if (command == 1)
+	{
+		for (UINT i = 0; i < 512; i++)
+			FastDiskWriteByte(buffer+i, blockBuffer[i]);
+	}
+	else
+	{
+		for (UINT i = 0; i < 512; i++)
+			blockBuffer[i] = FastDiskReadByte(buffer+i);
+
+		if (pFloppy->m_bWriteProtected || !ImageWriteBlock(pFloppy->m_imagehandle, block, blockBuffer))
+			rc = 0x2B;	// Write protected
+		else
+			FastDiskInvalidateTrack(drive, block >> 3);
+	}
+
+	a = rc;
+	bError = rc != 0x00;
+	uSectors = 2;
+	return true;
+}
+
+//===========================================================================
+
 // TODO: LoadRom_Disk_Floppy()
 void Disk2InterfaceCard::Initialize(LPBYTE pCxRomPeripheral, UINT uSlot)
 {
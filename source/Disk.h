@@ -139,6 +139,7 @@ public:
 	void EjectDisk(const int drive);
 
 	bool IsConditionForFullSpeed(void);
+	bool IsConditionForDiskAccel(void);
 	void NotifyInvalidImage(const int drive, LPCTSTR pszImageFilename, const ImageError_e Error);
 	void Reset(const bool bIsPowerCycle=false);
 	bool GetProtect(const int drive);
@@ -170,6 +171,9 @@ public:
 	bool GetEnhanceDisk(void);
 	void SetEnhanceDisk(bool bEnhanceDisk);
 
+	UINT GetFastDiskTraps(WORD* pTraps);
+	bool FastDiskTrap(const WORD pc, BYTE& a, bool& bError, UINT& uSectors);
+
 	static BYTE __stdcall IORead(WORD pc, WORD addr, BYTE bWrite, BYTE d, ULONG nExecutedCycles);
 	static BYTE __stdcall IOWrite(WORD pc, WORD addr, BYTE bWrite, BYTE d, ULONG nExecutedCycles);
 
@@ -189,9 +193,14 @@ private:
 	void UpdateBitStreamPosition(FloppyDisk& floppy, const ULONG bitCellDelta);
 	void UpdateBitStreamOffsets(FloppyDisk& floppy);
 	void DataLatchReadWOZ(WORD pc, WORD addr, UINT bitCellRemainder);
+	bool DataLatchReadWOZByte(FloppyDrive& drive, FloppyDisk& floppy);
 	void DataLatchWriteWOZ(WORD pc, WORD addr, BYTE d, UINT bitCellRemainder);
 	void DumpSectorWOZ(FloppyDisk floppy);
 	void DumpTrackWOZ(FloppyDisk floppy);
+	WORD GetProDOSDriverEntry(const int drive);
+	bool FastDiskRWTS(BYTE& a, bool& bError, UINT& uSectors);
+	bool FastDiskProDOS(const WORD pc, BYTE& a, bool& bError, UINT& uSectors);
+	void FastDiskInvalidateTrack(const int drive, const UINT track);
 
 	void SaveSnapshotFloppy(YamlSaveHelper& yamlSaveHelper, UINT unit);
 	void SaveSnapshotDriveUnit(YamlSaveHelper& yamlSaveHelper, UINT unit);
@@ -31,6 +31,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "Common.h"
 #include "DiskImage.h"
 #include "DiskImageHelper.h"
+#include "DiskImageIndex.h"
 
 
 static CDiskImageHelper sg_DiskImageHelper;
@@ -63,6 +64,11 @@ ImageError_e ImageOpen(	LPCTSTR pszImageFilename,
 	if (bExpectFloppy)	pImageInfo->pImageHelper = &sg_DiskImageHelper;
 	else				pImageInfo->pImageHelper = &sg_HardDiskImageHelper;
 
+	// NB. The harddisk helper only has the HDV type
+	const ImageIndexEntry* pIndexEntry = ImageIndexLookup(pszImageFilename);
+	const bool bUseHint = pIndexEntry && (bExpectFloppy || pIndexEntry->type == eImageHDV);
+	pImageInfo->pImageHelper->SetDetectHint(bUseHint ? (eImageType)pIndexEntry->type : eImageUNKNOWN);
+
 	ImageError_e Err = pImageInfo->pImageHelper->Open(pszImageFilename, pImageInfo, bCreateIfNecessary, strFilenameInZip);
 	if (Err != eIMAGE_ERROR_NONE)
 	{
@@ -138,6 +144,8 @@ BOOL ImageBoot(ImageInfo* const pImageInfo)
 
 void ImageDestroy(void)
 {
+	CImageBase::ms_WriteBack.Stop();
+
 	VirtualFree(sg_DiskImageHelper.GetWorkBuffer(), 0, MEM_RELEASE);
 	sg_DiskImageHelper.SetWorkBuffer(NULL);
 }
@@ -148,6 +156,8 @@ void ImageInitialize(void)
 {
 	LPBYTE pBuffer = (LPBYTE) VirtualAlloc(NULL, TRACK_DENIBBLIZED_SIZE*2, MEM_COMMIT, PAGE_READWRITE);
 	sg_DiskImageHelper.SetWorkBuffer(pBuffer);
+
+	CImageBase::ms_WriteBack.Start();
 }
 
 //===========================================================================
@@ -224,6 +234,80 @@ bool ImageWriteBlock(	ImageInfo* const pImageInfo,
 
 //===========================================================================
 
+// Multi-block access (for HDV images, see Harddisk.cpp's block cache)
+bool ImageReadBlocks(	ImageInfo* const pImageInfo,
+						UINT nBlock,
+						UINT nBlocks,
+						LPBYTE pBuffer)
+{
+	bool bRes = false;
+	if (pImageInfo->pImageType->AllowRW())
+		bRes = pImageInfo->pImageType->ReadBlocks(pImageInfo, nBlock, nBlocks, pBuffer);
+
+	return bRes;
+}
+
+//===========================================================================
+
+bool ImageWriteBlocks(	ImageInfo* const pImageInfo,
+						UINT nBlock,
+						UINT nBlocks,
+						LPBYTE pBuffer)
+{
+	bool bRes = false;
+	if (pImageInfo->pImageType->AllowRW() && !pImageInfo->bWriteProtected)
+		bRes = pImageInfo->pImageType->WriteBlocks(pImageInfo, nBlock, nBlocks, pBuffer);
+
+	return bRes;
+}
+
+//===========================================================================
+
+// Extend the image to nBlocks, as zero blocks
+bool ImageGrow(	ImageInfo* const pImageInfo,
+				UINT nBlocks)
+{
+	bool bRes = false;
+	if (pImageInfo->pImageType->AllowRW() && !pImageInfo->bWriteProtected)
+		bRes = pImageInfo->pImageType->Grow(pImageInfo, nBlocks);
+
+	return bRes;
+}
+
+//===========================================================================
+
+// NB. nSector is a DOS 3.3 logical sector
+bool ImageReadSector(	ImageInfo* const pImageInfo,
+						UINT nTrack,
+						UINT nSector,
+						LPBYTE pSectorBuffer)
+{
+	bool bRes = false;
+	if (pImageInfo->pImageType->AllowRW() && nTrack < TRACKS_MAX && pImageInfo->ValidTrack[nTrack])
+		bRes = pImageInfo->pImageType->ReadSector(pImageInfo, nTrack, nSector, pSectorBuffer);
+
+	return bRes;
+}
+
+//===========================================================================
+
+bool ImageWriteSector(	ImageInfo* const pImageInfo,
+						UINT nTrack,
+						UINT nSector,
+						LPBYTE pSectorBuffer)
+{
+	bool bRes = false;
+	if (pImageInfo->pImageType->AllowRW() && !pImageInfo->bWriteProtected)
+		bRes = pImageInfo->pImageType->WriteSector(pImageInfo, nTrack, nSector, pSectorBuffer);
+
+	if (bRes)
+		pImageInfo->ValidTrack[nTrack] = 1;
+
+	return bRes;
+}
+
+//===========================================================================
+
 UINT ImageGetNumTracks(ImageInfo* const pImageInfo)
 {
 	return pImageInfo ? pImageInfo->uNumTracks : 0;
@@ -260,6 +344,11 @@ BYTE ImageGetOptimalBitTiming(ImageInfo* const pImageInfo)
 	return pImageInfo ? pImageInfo->optimalBitTiming : 32;
 }
 
+BYTE ImageGetVolumeNumber(ImageInfo* const pImageInfo)
+{
+	return pImageInfo ? pImageInfo->pImageType->GetVolumeNumber() : DEFAULT_VOLUME_NUMBER;
+}
+
 UINT ImagePhaseToTrack(ImageInfo* const pImageInfo, const float phase, const bool limit/*=true*/)
 {
 	if (!pImageInfo)
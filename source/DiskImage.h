@@ -75,6 +75,11 @@ void ImageReadTrack(ImageInfo* const pImageInfo, float phase, LPBYTE pTrackImage
 void ImageWriteTrack(ImageInfo* const pImageInfo, float phase, LPBYTE pTrackImageBuffer, int nNibbles);
 bool ImageReadBlock(ImageInfo* const pImageInfo, UINT nBlock, LPBYTE pBlockBuffer);
 bool ImageWriteBlock(ImageInfo* const pImageInfo, UINT nBlock, LPBYTE pBlockBuffer);
+bool ImageReadBlocks(ImageInfo* const pImageInfo, UINT nBlock, UINT nBlocks, LPBYTE pBuffer);
+bool ImageWriteBlocks(ImageInfo* const pImageInfo, UINT nBlock, UINT nBlocks, LPBYTE pBuffer);
+bool ImageGrow(ImageInfo* const pImageInfo, UINT nBlocks);
+bool ImageReadSector(ImageInfo* const pImageInfo, UINT nTrack, UINT nSector, LPBYTE pSectorBuffer);
+bool ImageWriteSector(ImageInfo* const pImageInfo, UINT nTrack, UINT nSector, LPBYTE pSectorBuffer);
 
 UINT ImageGetNumTracks(ImageInfo* const pImageInfo);
 bool ImageIsWriteProtected(ImageInfo* const pImageInfo);
@@ -83,6 +88,7 @@ const char* ImageGetPathname(ImageInfo* const pImageInfo);
 UINT ImageGetImageSize(ImageInfo* const pImageInfo);
 bool ImageIsWOZ(ImageInfo* const pImageInfo);
 BYTE ImageGetOptimalBitTiming(ImageInfo* const pImageInfo);
+BYTE ImageGetVolumeNumber(ImageInfo* const pImageInfo);
 UINT ImagePhaseToTrack(ImageInfo* const pImageInfo, const float phase, const bool limit=true);
 
 void GetImageTitle(LPCTSTR pPathname, TCHAR* pImageName, TCHAR* pFullName);
@@ -36,6 +36,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "CPU.h"
 #include "DiskImage.h"
 #include "DiskImageHelper.h"
+#include "Log.h"
 #include "Memory.h"
 
 
@@ -65,6 +66,53 @@ BYTE CImageBase::ms_SectorNumber[NUM_SECTOR_ORDERS][0x10] =
 };
 
 LPBYTE CImageBase::ms_pWorkBuffer = NULL;
+CImageWriteBack CImageBase::ms_WriteBack;
+CZipCache CImageBase::ms_ZipCache;
+
+//-----------------------------------------------------------------------------
+
+// Map a normal image file, so that tracks & blocks are read from (and written to) the OS's file cache:
+// . avoids a private copy of the whole image (eg. 32MB for a hard disk) and reading it all on insertion
+// . a view of a file opened read-only is read-only too, so writes must check bMappedReadOnly
+static bool MapImageFile(ImageInfo* pImageInfo, const DWORD dwSize)
+{
+	_ASSERT(pImageInfo->hMapping == NULL && pImageInfo->pImageBuffer == NULL);
+
+	pImageInfo->bMappedReadOnly = false;
+	pImageInfo->hMapping = CreateFileMapping(pImageInfo->hFile, NULL, PAGE_READWRITE, 0, dwSize, NULL);
+	if (pImageInfo->hMapping == NULL)
+	{
+		pImageInfo->bMappedReadOnly = true;
+		pImageInfo->hMapping = CreateFileMapping(pImageInfo->hFile, NULL, PAGE_READONLY, 0, dwSize, NULL);
+		if (pImageInfo->hMapping == NULL)
+			return false;
+	}
+
+	pImageInfo->pImageBuffer = (BYTE*) MapViewOfFile(pImageInfo->hMapping, pImageInfo->bMappedReadOnly ? FILE_MAP_READ : FILE_MAP_WRITE, 0, 0, dwSize);
+	if (pImageInfo->pImageBuffer == NULL)
+	{
+		CloseHandle(pImageInfo->hMapping);
+		pImageInfo->hMapping = NULL;
+		return false;
+	}
+
+	return true;
+}
+
+static void UnmapImageFile(ImageInfo* pImageInfo)
+{
+	if (pImageInfo->hMapping == NULL)
+		return;
+
+	if (!pImageInfo->bMappedReadOnly)
+		FlushViewOfFile(pImageInfo->pImageBuffer, 0);
+
+	UnmapViewOfFile(pImageInfo->pImageBuffer);
+	pImageInfo->pImageBuffer = NULL;
+
+	CloseHandle(pImageInfo->hMapping);
+	pImageInfo->hMapping = NULL;
+}
 
 //-----------------------------------------------------------------------------
 
@@ -78,64 +126,80 @@ bool CImageBase::ReadTrack(ImageInfo* pImageInfo, const int nTrack, LPBYTE pTrac
 
 //-------------------------------------
 
+// Only the parts of the track that differ from the image are written:
+// . pImageBuffer always holds a floppy image, so the track is compared against it
+// . eg. a game save typically changes a sector or two, so this saves rewriting (or re-compressing) the whole track
+// . Changes separated by fewer than kTrackSpanGap unchanged bytes are written as one span
 bool CImageBase::WriteTrack(ImageInfo* pImageInfo, const int nTrack, LPBYTE pTrackBuffer, const UINT uTrackSize)
 {
-	const long Offset = pImageInfo->uOffset + nTrack * uTrackSize;
-	memcpy(&pImageInfo->pImageBuffer[Offset], pTrackBuffer, uTrackSize);
+	const UINT kTrackSpanGap = 64;
+	const UINT uTrackOffset = pImageInfo->uOffset + nTrack * uTrackSize;
+	const BYTE* pImage = &pImageInfo->pImageBuffer[uTrackOffset];
 
-	if (pImageInfo->FileType == eFileNormal)
+	bool bRes = true;
+	UINT i = 0;
+
+	while (i < uTrackSize)
 	{
-		if (pImageInfo->hFile == INVALID_HANDLE_VALUE)
-			return false;
+		if (pTrackBuffer[i] == pImage[i])
+		{
+			i++;
+			continue;
+		}
 
-		SetFilePointer(pImageInfo->hFile, Offset, NULL, FILE_BEGIN);
+		const UINT uStart = i;
+		UINT uEnd = i+1;
+		for (UINT j=uEnd; j < uTrackSize && j < uEnd+kTrackSpanGap; j++)
+		{
+			if (pTrackBuffer[j] != pImage[j])
+				uEnd = j+1;
+		}
 
-		DWORD dwBytesWritten;
-		BOOL bRes = WriteFile(pImageInfo->hFile, pTrackBuffer, uTrackSize, &dwBytesWritten, NULL);
-		_ASSERT(dwBytesWritten == uTrackSize);
-		if (!bRes || dwBytesWritten != uTrackSize)
-			return false;
+		if (!WriteImageData(pImageInfo, uTrackOffset+uStart, &pTrackBuffer[uStart], uEnd-uStart))
+			bRes = false;
+
+		i = uEnd;
 	}
-	else if (pImageInfo->FileType == eFileGZip)
-	{
-		// Write entire compressed image each time (dirty track change or dirty disk removal)
-		gzFile hGZFile = gzopen(pImageInfo->szFilename, "wb");
-		if (hGZFile == NULL)
-			return false;
 
-		int nLen = gzwrite(hGZFile, pImageInfo->pImageBuffer, pImageInfo->uImageSize);
-		if (nLen != pImageInfo->uImageSize)
-			return false;
+	return bRes;
+}
 
-		int nRes = gzclose(hGZFile);
-		hGZFile = NULL;
-		if (nRes != Z_OK)
-			return false;
-	}
-	else if (pImageInfo->FileType == eFileZip)
+//-------------------------------------
+
+bool CImageBase::WriteImageData(ImageInfo* pImageInfo, const UINT uOffset, const LPBYTE pData, const UINT uSize)
+{
+	if (pImageInfo->FileType == eFileNormal)
 	{
-		// Write entire compressed image each time (dirty track change or dirty disk removal)
-		// NB. Only support Zip archives with a single file
-		zipFile hZipFile = zipOpen(pImageInfo->szFilename, APPEND_STATUS_CREATE);
-		if (hZipFile == NULL)
-			return false;
+		if (pImageInfo->hMapping)
+		{
+			if (pImageInfo->bMappedReadOnly)
+				return false;
 
-		int nRes = zipOpenNewFileInZip(hZipFile, pImageInfo->szFilenameInZip, &pImageInfo->zipFileInfo, NULL, 0, NULL, 0, NULL, Z_DEFLATED, Z_BEST_SPEED);
-		if (nRes != ZIP_OK)
-			return false;
+			memcpy(&pImageInfo->pImageBuffer[uOffset], pData, uSize);	// Written to the file by the OS (and flushed on eject)
+			return true;
+		}
 
-		nRes = zipWriteInFileInZip(hZipFile, pImageInfo->pImageBuffer, pImageInfo->uImageSize);
-		if (nRes != ZIP_OK)
-			return false;
+		memcpy(&pImageInfo->pImageBuffer[uOffset], pData, uSize);
 
-		nRes = zipCloseFileInZip(hZipFile);
-		if (nRes != ZIP_OK)
+		if (pImageInfo->hFile == INVALID_HANDLE_VALUE)
 			return false;
 
-		nRes = zipClose(hZipFile, NULL);
-		if (nRes != ZIP_OK)
+		SetFilePointer(pImageInfo->hFile, uOffset, NULL, FILE_BEGIN);
+
+		DWORD dwBytesWritten;
+		BOOL bRes = WriteFile(pImageInfo->hFile, pData, uSize, &dwBytesWritten, NULL);
+		_ASSERT(dwBytesWritten == uSize);
+		if (!bRes || dwBytesWritten != uSize)
 			return false;
 	}
+	else if ((pImageInfo->FileType == eFileGZip) || (pImageInfo->FileType == eFileZip))
+	{
+		// Re-compressing the entire image is deferred to the write-back thread
+		ms_WriteBack.Lock();
+		memcpy(&pImageInfo->pImageBuffer[uOffset], pData, uSize);
+		ms_WriteBack.MarkDirty(pImageInfo);
+		ms_WriteBack.Unlock();
+	}
 	else
 	{
 		_ASSERT(0);
@@ -147,25 +211,38 @@ bool CImageBase::WriteTrack(ImageInfo* pImageInfo, const int nTrack, LPBYTE pTra
 
 //-----------------------------------------------------------------------------
 
-bool CImageBase::ReadBlock(ImageInfo* pImageInfo, const int nBlock, LPBYTE pBlockBuffer)
+bool CImageBase::ReadBlock(ImageInfo* pImageInfo, const int nBlock, LPBYTE pBlockBuffer, const UINT nBlocks/*=1*/)
 {
 	long Offset = pImageInfo->uOffset + nBlock * HD_BLOCK_SIZE;
+	const UINT uSize = nBlocks * HD_BLOCK_SIZE;
 
 	if (pImageInfo->FileType == eFileNormal)
 	{
+		if (pImageInfo->hMapping)
+		{
+			if ((UINT)Offset+uSize > pImageInfo->uImageSize)
+				return false;
+
+			memcpy(pBlockBuffer, &pImageInfo->pImageBuffer[Offset], uSize);
+			return true;
+		}
+
 		if (pImageInfo->hFile == INVALID_HANDLE_VALUE)
 			return false;
 
 		SetFilePointer(pImageInfo->hFile, Offset, NULL, FILE_BEGIN);
 
 		DWORD dwBytesRead;
-		BOOL bRes = ReadFile(pImageInfo->hFile, pBlockBuffer, HD_BLOCK_SIZE, &dwBytesRead, NULL);
-		if (!bRes || dwBytesRead != HD_BLOCK_SIZE)
+		BOOL bRes = ReadFile(pImageInfo->hFile, pBlockBuffer, uSize, &dwBytesRead, NULL);
+		if (!bRes || dwBytesRead != uSize)
 			return false;
 	}
 	else if ((pImageInfo->FileType == eFileGZip) || (pImageInfo->FileType == eFileZip))
 	{
-		memcpy(pBlockBuffer, &pImageInfo->pImageBuffer[Offset], HD_BLOCK_SIZE);
+		if ((UINT)Offset+uSize > pImageInfo->uImageSize)
+			return false;
+
+		memcpy(pBlockBuffer, &pImageInfo->pImageBuffer[Offset], uSize);
 	}
 	else
 	{
@@ -178,84 +255,341 @@ bool CImageBase::ReadBlock(ImageInfo* pImageInfo, const int nBlock, LPBYTE pBloc
 
 //-------------------------------------
 
-bool CImageBase::WriteBlock(ImageInfo* pImageInfo, const int nBlock, LPBYTE pBlockBuffer)
+bool CImageBase::WriteBlock(ImageInfo* pImageInfo, const int nBlock, LPBYTE pBlockBuffer, const UINT nBlocks/*=1*/)
 {
 	long Offset = pImageInfo->uOffset + nBlock * HD_BLOCK_SIZE;
-	const bool bGrowImageBuffer = (UINT)Offset+HD_BLOCK_SIZE > pImageInfo->uImageSize;
+	const UINT uSize = nBlocks * HD_BLOCK_SIZE;
+	const bool bGrowImageBuffer = (UINT)Offset+uSize > pImageInfo->uImageSize;
 
 	if (pImageInfo->FileType == eFileGZip || pImageInfo->FileType == eFileZip)
 	{
+		// Re-compressing the entire image is deferred to the write-back thread
+		ms_WriteBack.Lock();
+
 		if (bGrowImageBuffer)
-		{
-			// Horribly inefficient! (Unzip to a normal file if you want better performance!)
-			const UINT uNewImageSize = Offset+HD_BLOCK_SIZE;
-			BYTE* pNewImageBuffer = new BYTE [uNewImageSize];
+			GrowImageBuffer(pImageInfo, Offset+uSize);
 
-			memcpy(pNewImageBuffer, pImageInfo->pImageBuffer, pImageInfo->uImageSize);
-			memset(&pNewImageBuffer[pImageInfo->uImageSize], 0, uNewImageSize-pImageInfo->uImageSize);	// Should always be HD_BLOCK_SIZE (so this is redundant)
+		memcpy(&pImageInfo->pImageBuffer[Offset], pBlockBuffer, uSize);
 
-			delete [] pImageInfo->pImageBuffer;
-			pImageInfo->pImageBuffer = pNewImageBuffer;
-			pImageInfo->uImageSize = uNewImageSize;
-		}
-
-		memcpy(&pImageInfo->pImageBuffer[Offset], pBlockBuffer, HD_BLOCK_SIZE);
+		ms_WriteBack.MarkDirty(pImageInfo);
+		ms_WriteBack.Unlock();
 	}
-
-	if (pImageInfo->FileType == eFileNormal)
+	else if (pImageInfo->FileType == eFileNormal)
 	{
 		if (pImageInfo->hFile == INVALID_HANDLE_VALUE)
 			return false;
 
+		const bool bMapped = pImageInfo->hMapping != NULL;
+		if (bMapped)
+		{
+			if (pImageInfo->bMappedReadOnly)
+				return false;
+
+			if (!bGrowImageBuffer)
+			{
+				memcpy(&pImageInfo->pImageBuffer[Offset], pBlockBuffer, uSize);
+				return true;
+			}
+
+			UnmapImageFile(pImageInfo);	// Re-map once the file has been extended
+		}
+
 		SetFilePointer(pImageInfo->hFile, Offset, NULL, FILE_BEGIN);
 
 		DWORD dwBytesWritten;
-		BOOL bRes = WriteFile(pImageInfo->hFile, pBlockBuffer, HD_BLOCK_SIZE, &dwBytesWritten, NULL);
-		if (!bRes || dwBytesWritten != HD_BLOCK_SIZE)
+		BOOL bRes = WriteFile(pImageInfo->hFile, pBlockBuffer, uSize, &dwBytesWritten, NULL);
+
+		if (bRes && dwBytesWritten == uSize && bGrowImageBuffer)
+			pImageInfo->uImageSize = Offset+uSize;
+
+		if (bMapped)
+			MapImageFile(pImageInfo, pImageInfo->uImageSize);	// On failure, fall back to ReadFile()/WriteFile()
+
+		if (!bRes || dwBytesWritten != uSize)
 			return false;
+	}
+	else
+	{
+		_ASSERT(0);
+		return false;
+	}
 
-		if (bGrowImageBuffer)
-			pImageInfo->uImageSize += HD_BLOCK_SIZE;
+	return true;
+}
+
+//-------------------------------------
+
+// Pre: ms_WriteBack is locked
+void CImageBase::GrowImageBuffer(ImageInfo* pImageInfo, const UINT uNewImageSize)
+{
+	BYTE* pNewImageBuffer = new BYTE [uNewImageSize];
+
+	memcpy(pNewImageBuffer, pImageInfo->pImageBuffer, pImageInfo->uImageSize);
+	memset(&pNewImageBuffer[pImageInfo->uImageSize], 0, uNewImageSize-pImageInfo->uImageSize);
+
+	delete [] pImageInfo->pImageBuffer;
+	pImageInfo->pImageBuffer = pNewImageBuffer;
+	pImageInfo->uImageSize = uNewImageSize;
+}
+
+// Extend the image with zero blocks in one step (rather than writing each zero block):
+// . For a normal file, just move the end-of-file - the file system zero-fills (NTFS does this lazily, on first read or write)
+bool CImageBase::GrowBlocks(ImageInfo* pImageInfo, const UINT nBlocks)
+{
+	const UINT uNewImageSize = pImageInfo->uOffset + nBlocks * HD_BLOCK_SIZE;
+	if (uNewImageSize <= pImageInfo->uImageSize)
+		return true;
+
+	if (pImageInfo->FileType == eFileGZip || pImageInfo->FileType == eFileZip)
+	{
+		ms_WriteBack.Lock();
+		GrowImageBuffer(pImageInfo, uNewImageSize);
+		ms_WriteBack.MarkDirty(pImageInfo);
+		ms_WriteBack.Unlock();
+		return true;
 	}
-	else if (pImageInfo->FileType == eFileGZip)
+
+	if (pImageInfo->FileType != eFileNormal || pImageInfo->hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	const bool bMapped = pImageInfo->hMapping != NULL;
+	if (bMapped)
 	{
-		// Write entire compressed image each time a block is written
-		gzFile hGZFile = gzopen(pImageInfo->szFilename, "wb");
-		if (hGZFile == NULL)
+		if (pImageInfo->bMappedReadOnly)
 			return false;
 
-		int nLen = gzwrite(hGZFile, pImageInfo->pImageBuffer, pImageInfo->uImageSize);
-		if (nLen != pImageInfo->uImageSize)
+		UnmapImageFile(pImageInfo);
+	}
+
+	SetFilePointer(pImageInfo->hFile, uNewImageSize, NULL, FILE_BEGIN);
+	const bool bRes = SetEndOfFile(pImageInfo->hFile) ? true : false;
+	if (bRes)
+		pImageInfo->uImageSize = uNewImageSize;
+
+	if (bMapped)
+		MapImageFile(pImageInfo, pImageInfo->uImageSize);	// On failure, fall back to ReadFile()/WriteFile()
+
+	return bRes;
+}
+
+//-----------------------------------------------------------------------------
+
+void CImageWriteBack::Start(void)
+{
+	if (m_hThread)
+		return;
+
+	m_hWakeEvent = CreateEvent(NULL, FALSE, FALSE, NULL);	// Auto-reset
+	m_hQuitEvent = CreateEvent(NULL, TRUE, FALSE, NULL);	// Manual-reset
+
+	DWORD dwThreadId;
+	m_hThread = CreateThread(NULL,				// lpThreadAttributes
+								0,				// dwStackSize
+								ThreadProc,
+								this,			// lpParameter
+								0,				// dwCreationFlags : 0 = Run immediately
+								&dwThreadId);	// lpThreadId
+
+	if (m_hThread)
+		SetThreadPriority(m_hThread, THREAD_PRIORITY_BELOW_NORMAL);
+	else
+		LogFileOutput("ImageWriteBack: CreateThread() failed, images will only be saved on eject\n");
+}
+
+void CImageWriteBack::Stop(void)
+{
+	if (m_hThread)
+	{
+		SetEvent(m_hQuitEvent);
+		WaitForSingleObject(m_hThread, INFINITE);
+		CloseHandle(m_hThread);
+		m_hThread = NULL;
+	}
+
+	if (m_hWakeEvent)
+	{
+		CloseHandle(m_hWakeEvent);
+		m_hWakeEvent = NULL;
+	}
+
+	if (m_hQuitEvent)
+	{
+		CloseHandle(m_hQuitEvent);
+		m_hQuitEvent = NULL;
+	}
+
+	FlushDue(true);
+}
+
+// Pre: Lock()'d
+void CImageWriteBack::MarkDirty(ImageInfo* pImageInfo)
+{
+	const DWORD dwNow = GetTickCount();
+
+	MAPPENDING::iterator it = m_mapPending.find(pImageInfo);
+	if (it == m_mapPending.end())
+	{
+		PendingImage pending = {dwNow, dwNow};
+		m_mapPending[pImageInfo] = pending;
+
+		if (m_hWakeEvent)
+			SetEvent(m_hWakeEvent);	// Thread re-calculates its timeout
+	}
+	else
+	{
+		it->second.dwLastWrite = dwNow;
+	}
+}
+
+// Eject: write the image now (unless it's about to be deleted)
+void CImageWriteBack::Close(ImageInfo* pImageInfo, const bool bDiscard)
+{
+	EnterCriticalSection(&m_csFile);
+
+	if (bDiscard)
+	{
+		Lock();
+		m_mapPending.erase(pImageInfo);
+		Unlock();
+	}
+	else
+	{
+		Flush(pImageInfo);
+	}
+
+	LeaveCriticalSection(&m_csFile);
+}
+
+DWORD WINAPI CImageWriteBack::ThreadProc(LPVOID lpParameter)
+{
+	CImageWriteBack* pWriteBack = (CImageWriteBack*) lpParameter;
+	HANDLE hEvents[2] = {pWriteBack->m_hQuitEvent, pWriteBack->m_hWakeEvent};
+
+	while (true)
+	{
+		DWORD dwRes = WaitForMultipleObjects(2, hEvents, FALSE, pWriteBack->GetTimeUntilNextFlush());
+		if (dwRes == WAIT_OBJECT_0)
+			break;	// Quit: Stop() writes any pending images
+
+		pWriteBack->FlushDue(false);
+	}
+
+	return 0;
+}
+
+DWORD CImageWriteBack::GetTimeUntilNextFlush(void)
+{
+	const DWORD dwNow = GetTickCount();
+	DWORD dwTimeout = INFINITE;
+
+	Lock();
+
+	for (MAPPENDING::iterator it = m_mapPending.begin(); it != m_mapPending.end(); ++it)
+	{
+		const DWORD dwSinceLast = dwNow - it->second.dwLastWrite;
+		const DWORD dwSinceFirst = dwNow - it->second.dwFirstWrite;
+		const DWORD dwQuiet = (dwSinceLast < kQuietPeriod) ? kQuietPeriod - dwSinceLast : 0;
+		const DWORD dwMax = (dwSinceFirst < kMaxDelay) ? kMaxDelay - dwSinceFirst : 0;
+		dwTimeout = MIN(dwTimeout, MIN(dwQuiet, dwMax));
+	}
+
+	Unlock();
+
+	return dwTimeout;
+}
+
+void CImageWriteBack::FlushDue(const bool bAll)
+{
+	EnterCriticalSection(&m_csFile);
+
+	std::vector<ImageInfo*> vecDue;
+	const DWORD dwNow = GetTickCount();
+
+	Lock();
+	for (MAPPENDING::iterator it = m_mapPending.begin(); it != m_mapPending.end(); ++it)
+	{
+		if (bAll || (dwNow - it->second.dwLastWrite) >= kQuietPeriod || (dwNow - it->second.dwFirstWrite) >= kMaxDelay)
+			vecDue.push_back(it->first);
+	}
+	Unlock();
+
+	for (UINT i=0; i<vecDue.size(); i++)
+		Flush(vecDue[i]);
+
+	LeaveCriticalSection(&m_csFile);
+}
+
+// Pre: m_csFile held, so pImageInfo can't be closed (and freed) by another thread
+bool CImageWriteBack::Flush(ImageInfo* pImageInfo)
+{
+	Lock();
+
+	MAPPENDING::iterator it = m_mapPending.find(pImageInfo);
+	if (it == m_mapPending.end())
+	{
+		Unlock();
+		return true;
+	}
+
+	m_mapPending.erase(it);
+
+	// Snapshot the image, so the emulation thread can continue writing while it's compressed
+	const FileType_e FileType = pImageInfo->FileType;
+	const std::string strFilename(pImageInfo->szFilename);
+	const std::string strFilenameInZip(pImageInfo->szFilenameInZip);
+	const zip_fileinfo zipFileInfo = pImageInfo->zipFileInfo;
+	const std::vector<BYTE> vecImage(pImageInfo->pImageBuffer, pImageInfo->pImageBuffer + pImageInfo->uImageSize);
+
+	Unlock();
+
+	const bool bRes = WriteCompressedImage(FileType, strFilename, strFilenameInZip, zipFileInfo, vecImage);
+	if (!bRes)
+		LogFileOutput("ImageWriteBack: failed to write %s\n", strFilename.c_str());
+
+	return bRes;
+}
+
+// Write entire compressed image to a temp file, then replace the original
+bool CImageWriteBack::WriteCompressedImage(const FileType_e FileType, const std::string& strFilename, const std::string& strFilenameInZip, const zip_fileinfo& zipFileInfo, const std::vector<BYTE>& vecImage)
+{
+	const std::string strTempFilename = strFilename + ".tmp";
+	const UINT uImageSize = vecImage.size();
+	const BYTE* pImage = uImageSize ? &vecImage[0] : NULL;
+
+	if (FileType == eFileGZip)
+	{
+		gzFile hGZFile = gzopen(strTempFilename.c_str(), "wb");
+		if (hGZFile == NULL)
 			return false;
 
+		int nLen = gzwrite(hGZFile, pImage, uImageSize);
 		int nRes = gzclose(hGZFile);
 		hGZFile = NULL;
-		if (nRes != Z_OK)
+		if (nLen != uImageSize || nRes != Z_OK)
+		{
+			DeleteFile(strTempFilename.c_str());
 			return false;
+		}
 	}
-	else if (pImageInfo->FileType == eFileZip)
+	else if (FileType == eFileZip)
 	{
-		// Write entire compressed image each time a block is written
 		// NB. Only support Zip archives with a single file
-		zipFile hZipFile = zipOpen(pImageInfo->szFilename, APPEND_STATUS_CREATE);
+		zipFile hZipFile = zipOpen(strTempFilename.c_str(), APPEND_STATUS_CREATE);
 		if (hZipFile == NULL)
 			return false;
 
-		int nRes = zipOpenNewFileInZip(hZipFile, pImageInfo->szFilenameInZip, &pImageInfo->zipFileInfo, NULL, 0, NULL, 0, NULL, Z_DEFLATED, Z_BEST_SPEED);
-		if (nRes != ZIP_OK)
-			return false;
-
-		nRes = zipWriteInFileInZip(hZipFile, pImageInfo->pImageBuffer, pImageInfo->uImageSize);
-		if (nRes != ZIP_OK)
-			return false;
+		int nRes = zipOpenNewFileInZip(hZipFile, strFilenameInZip.c_str(), &zipFileInfo, NULL, 0, NULL, 0, NULL, Z_DEFLATED, Z_BEST_SPEED);
+		if (nRes == ZIP_OK)
+			nRes = zipWriteInFileInZip(hZipFile, pImage, uImageSize);
+		if (nRes == ZIP_OK)
+			nRes = zipCloseFileInZip(hZipFile);
 
-		nRes = zipCloseFileInZip(hZipFile);
-		if (nRes != ZIP_OK)
-			return false;
-
-		nRes = zipClose(hZipFile, NULL);
-		if (nRes != ZIP_OK)
+		int nResClose = zipClose(hZipFile, NULL);
+		if (nRes != ZIP_OK || nResClose != ZIP_OK)
+		{
+			DeleteFile(strTempFilename.c_str());
 			return false;
+		}
 	}
 	else
 	{
@@ -263,11 +597,210 @@ bool CImageBase::WriteBlock(ImageInfo* pImageInfo, const int nBlock, LPBYTE pBlo
 		return false;
 	}
 
+	if (!MoveFileEx(strTempFilename.c_str(), strFilename.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+	{
+		DeleteFile(strTempFilename.c_str());
+		return false;
+	}
+
+	if (FileType == eFileZip)
+		CImageBase::ms_ZipCache.Invalidate(strFilename.c_str());
+
 	return true;
 }
 
 //-----------------------------------------------------------------------------
 
+std::string CZipCache::GetKey(LPCTSTR pszZipFilename)
+{
+	char szPathname[MAX_PATH];
+	const DWORD uNameLen = GetFullPathName(pszZipFilename, MAX_PATH, szPathname, NULL);
+	if (uNameLen == 0 || uNameLen >= MAX_PATH)
+		StringCbCopy(szPathname, MAX_PATH, pszZipFilename);
+
+	CharLowerBuff(szPathname, strlen(szPathname));
+	return szPathname;
+}
+
+ImageError_e CZipCache::ReadIndex(LPCTSTR pszZipFilename, std::vector<ZipEntry>& vecEntries)
+{
+	vecEntries.clear();
+
+	unzFile hZipFile = unzOpen(pszZipFilename);
+	if (hZipFile == NULL)
+		return eIMAGE_ERROR_UNABLE_TO_OPEN_ZIP;
+
+	int nRes = unzGoToFirstFile(hZipFile);
+	while (nRes == UNZ_OK)
+	{
+		ZipEntry entry;
+		char szFilename[MAX_PATH];
+		memset(szFilename, 0, sizeof(szFilename));
+
+		nRes = unzGetCurrentFileInfo(hZipFile, &entry.info, szFilename, MAX_PATH-1, NULL, 0, NULL, 0);
+		if (nRes == UNZ_OK)
+			nRes = unzGetFilePos(hZipFile, &entry.pos);
+		if (nRes != UNZ_OK)
+			break;
+
+		entry.strFilename = szFilename;
+		vecEntries.push_back(entry);
+
+		nRes = unzGoToNextFile(hZipFile);
+	}
+
+	unzClose(hZipFile);
+
+	if (nRes != UNZ_END_OF_LIST_OF_FILE || vecEntries.empty())
+		return eIMAGE_ERROR_ZIP;
+
+	return eIMAGE_ERROR_NONE;
+}
+
+ImageError_e CZipCache::GetIndex(LPCTSTR pszZipFilename, std::vector<ZipEntry>& vecEntries)
+{
+	WIN32_FILE_ATTRIBUTE_DATA fileData;
+	if (!GetFileAttributesEx(pszZipFilename, GetFileExInfoStandard, &fileData))
+		return eIMAGE_ERROR_UNABLE_TO_OPEN_ZIP;
+
+	const UINT64 uLastWrite = ((UINT64)fileData.ftLastWriteTime.dwHighDateTime << 32) | fileData.ftLastWriteTime.dwLowDateTime;
+	const UINT uSize = fileData.nFileSizeLow;
+	const std::string strKey = GetKey(pszZipFilename);
+
+	EnterCriticalSection(&m_cs);
+
+	MAPINDEX::iterator it = m_mapIndex.find(strKey);
+	if (it != m_mapIndex.end() && it->second.uLastWrite == uLastWrite && it->second.uSize == uSize)
+	{
+		it->second.uLastUsed = ++m_uClock;
+		vecEntries = it->second.vecEntries;
+		LeaveCriticalSection(&m_cs);
+		return eIMAGE_ERROR_NONE;
+	}
+
+	LeaveCriticalSection(&m_cs);
+
+	// Not indexed (or changed since): read the central directory without holding the lock
+	ImageError_e Err = ReadIndex(pszZipFilename, vecEntries);
+	if (Err != eIMAGE_ERROR_NONE)
+		return Err;
+
+	EnterCriticalSection(&m_cs);
+
+	if (m_mapIndex.size() >= kMaxIndexes && m_mapIndex.find(strKey) == m_mapIndex.end())
+	{
+		MAPINDEX::iterator itOldest = m_mapIndex.begin();
+		for (it = m_mapIndex.begin(); it != m_mapIndex.end(); ++it)
+		{
+			if (it->second.uLastUsed < itOldest->second.uLastUsed)
+				itOldest = it;
+		}
+		m_mapIndex.erase(itOldest);
+	}
+
+	ZipIndex& index = m_mapIndex[strKey];
+	index.uLastWrite = uLastWrite;
+	index.uSize = uSize;
+	index.uLastUsed = ++m_uClock;
+	index.vecEntries = vecEntries;
+
+	LeaveCriticalSection(&m_cs);
+	return eIMAGE_ERROR_NONE;
+}
+
+bool CZipCache::GetFile(LPCTSTR pszZipFilename, const ZipEntry& entry, LPBYTE pBuffer)
+{
+	const std::string strKey = GetKey(pszZipFilename);
+	bool bFound = false;
+
+	EnterCriticalSection(&m_cs);
+
+	for (UINT i=0; i<m_vecCachedFiles.size(); i++)
+	{
+		CachedFile* pFile = m_vecCachedFiles[i];
+		if (pFile->crc == entry.info.crc && pFile->data.size() == entry.info.uncompressed_size &&
+			pFile->strFilename == entry.strFilename && pFile->strZipKey == strKey)
+		{
+			memcpy(pBuffer, &pFile->data[0], pFile->data.size());
+			pFile->uLastUsed = ++m_uClock;
+			bFound = true;
+			break;
+		}
+	}
+
+	LeaveCriticalSection(&m_cs);
+	return bFound;
+}
+
+void CZipCache::PutFile(LPCTSTR pszZipFilename, const ZipEntry& entry, const LPBYTE pBuffer)
+{
+	const UINT uSize = entry.info.uncompressed_size;
+	if (uSize == 0 || uSize > kMaxCachedFileSize)
+		return;
+
+	CachedFile* pNewFile = new CachedFile;
+	pNewFile->strZipKey = GetKey(pszZipFilename);
+	pNewFile->strFilename = entry.strFilename;
+	pNewFile->crc = entry.info.crc;
+	pNewFile->data.assign(pBuffer, pBuffer + uSize);
+
+	EnterCriticalSection(&m_cs);
+
+	// Replace any older copy (eg. from another thread), then evict the least recently used files to make room
+	for (UINT i=0; i<m_vecCachedFiles.size(); )
+	{
+		if (m_vecCachedFiles[i]->strFilename == pNewFile->strFilename && m_vecCachedFiles[i]->strZipKey == pNewFile->strZipKey)
+			RemoveCachedFile(i);
+		else
+			i++;
+	}
+
+	while (!m_vecCachedFiles.empty() && m_uCachedBytes + uSize > kMaxCachedBytes)
+	{
+		UINT uOldest = 0;
+		for (UINT i=1; i<m_vecCachedFiles.size(); i++)
+		{
+			if (m_vecCachedFiles[i]->uLastUsed < m_vecCachedFiles[uOldest]->uLastUsed)
+				uOldest = i;
+		}
+		RemoveCachedFile(uOldest);
+	}
+
+	pNewFile->uLastUsed = ++m_uClock;
+	m_vecCachedFiles.push_back(pNewFile);
+	m_uCachedBytes += uSize;
+
+	LeaveCriticalSection(&m_cs);
+}
+
+void CZipCache::RemoveCachedFile(const UINT uIndex)
+{
+	m_uCachedBytes -= m_vecCachedFiles[uIndex]->data.size();
+	delete m_vecCachedFiles[uIndex];
+	m_vecCachedFiles.erase(m_vecCachedFiles.begin() + uIndex);
+}
+
+void CZipCache::Invalidate(LPCTSTR pszZipFilename)
+{
+	const std::string strKey = GetKey(pszZipFilename);
+
+	EnterCriticalSection(&m_cs);
+
+	m_mapIndex.erase(strKey);
+
+	for (UINT i=0; i<m_vecCachedFiles.size(); )
+	{
+		if (m_vecCachedFiles[i]->strZipKey == strKey)
+			RemoveCachedFile(i);
+		else
+			i++;
+	}
+
+	LeaveCriticalSection(&m_cs);
+}
+
+//-----------------------------------------------------------------------------
+
 LPBYTE CImageBase::Code62(int sector)
 {
 	// CONVERT THE 256 8-BIT BYTES INTO 342 6-BIT BYTES, WHICH WE STORE
@@ -556,6 +1089,92 @@ void CImageBase::SkewTrack(const int nTrack, const int nNumNibbles, const LPBYTE
 
 //-------------------------------------
 
+// Re-encoding all 16 sectors with Code62() on every head step is slow for software that seeks back & forth (eg. copiers & fast loaders),
+// so keep each nibblized track until it's written to
+int CImageBase::ReadNibblizedTrack(ImageInfo* pImageInfo, LPBYTE pTrackImageBuffer, SectorOrder_e SectorOrder, const UINT track)
+{
+	NibblizedTrackCache*& pCache = pImageInfo->pNibblizedTrackCache;
+	if (pCache == NULL)
+	{
+		pCache = new NibblizedTrackCache;
+		pCache->uVolumeNumber = m_uVolumeNumber;
+		memset(pCache->uNibbles, 0, sizeof(pCache->uNibbles));
+	}
+
+	if (pCache->uVolumeNumber != m_uVolumeNumber)
+	{
+		pCache->uVolumeNumber = m_uVolumeNumber;
+		memset(pCache->uNibbles, 0, sizeof(pCache->uNibbles));
+	}
+
+	if (pCache->uNibbles[track] == 0)
+	{
+		ReadTrack(pImageInfo, track, ms_pWorkBuffer, TRACK_DENIBBLIZED_SIZE);
+		pCache->uNibbles[track] = NibblizeTrack(pCache->track[track], SectorOrder, track);
+	}
+
+	const UINT uNibbles = pCache->uNibbles[track];
+	memcpy(pTrackImageBuffer, pCache->track[track], uNibbles);
+	return uNibbles;
+}
+
+void CImageBase::WriteNibblizedTrack(ImageInfo* pImageInfo, LPBYTE pTrackImageBuffer, SectorOrder_e SectorOrder, const UINT track, const int nNibbles)
+{
+	if (pImageInfo->pNibblizedTrackCache)
+		pImageInfo->pNibblizedTrackCache->uNibbles[track] = 0;	// Re-nibblize from the written sectors on next read
+
+	DenibblizeTrack(pTrackImageBuffer, SectorOrder, nNibbles);
+	WriteTrack(pImageInfo, track, ms_pWorkBuffer, TRACK_DENIBBLIZED_SIZE);
+}
+
+//-------------------------------------
+
+// Sector-level access, for the fast disk mode (see Disk2InterfaceCard::FastDiskTrap()):
+// . sector is in SectorOrder (DOS 3.3 logical sector, or ProDOS half-block), so map it via its physical sector to the image's order
+bool CImageBase::AccessSector(ImageInfo* pImageInfo, const UINT track, const UINT sector, SectorOrder_e SectorOrder, SectorOrder_e ImageOrder, LPBYTE pSectorBuffer, const bool bWrite)
+{
+	if (track >= pImageInfo->uNumTracks || sector >= NUM_SECTORS)
+		return false;
+
+	UINT imageSector = sector;
+	if (SectorOrder != ImageOrder)
+	{
+		for (UINT physical = 0; physical < NUM_SECTORS; physical++)
+		{
+			if (ms_SectorNumber[SectorOrder][physical] == sector)
+			{
+				imageSector = ms_SectorNumber[ImageOrder][physical];
+				break;
+			}
+		}
+	}
+
+	if (!bWrite)
+	{
+		const long offset = pImageInfo->uOffset + track * TRACK_DENIBBLIZED_SIZE + (imageSector << 8);
+		memcpy(pSectorBuffer, &pImageInfo->pImageBuffer[offset], 256);
+		return true;
+	}
+
+	if (pImageInfo->pNibblizedTrackCache)
+		pImageInfo->pNibblizedTrackCache->uNibbles[track] = 0;
+
+	const UINT offset = pImageInfo->uOffset + track * TRACK_DENIBBLIZED_SIZE + (imageSector << 8);
+	return WriteImageData(pImageInfo, offset, pSectorBuffer, 256);
+}
+
+// A 5.25" ProDOS block is 2 half-blocks (in ProDOS order) on track nBlock/8
+bool CImageBase::AccessFloppyBlock(ImageInfo* pImageInfo, const UINT nBlock, SectorOrder_e ImageOrder, LPBYTE pBlockBuffer, const bool bWrite)
+{
+	const UINT track = nBlock >> 3;
+	const UINT sector = (nBlock & 7) << 1;
+
+	return AccessSector(pImageInfo, track, sector+0, eProDOSOrder, ImageOrder, pBlockBuffer,     bWrite) &&
+		   AccessSector(pImageInfo, track, sector+1, eProDOSOrder, ImageOrder, pBlockBuffer+256, bWrite);
+}
+
+//-------------------------------------
+
 bool CImageBase::IsValidImageSize(const DWORD uImageSize)
 {
 	m_uNumTracksInImage = 0;
@@ -633,8 +1252,7 @@ public:
 	virtual void Read(ImageInfo* pImageInfo, const float phase, LPBYTE pTrackImageBuffer, int* pNibbles, UINT* pBitCount, bool enhanceDisk)
 	{
 		const UINT track = PhaseToTrack(phase);
-		ReadTrack(pImageInfo, track, ms_pWorkBuffer, TRACK_DENIBBLIZED_SIZE);
-		*pNibbles = NibblizeTrack(pTrackImageBuffer, eDOSOrder, track);
+		*pNibbles = ReadNibblizedTrack(pImageInfo, pTrackImageBuffer, eDOSOrder, track);
 		if (!enhanceDisk)
 			SkewTrack(track, *pNibbles, pTrackImageBuffer);
 	}
@@ -642,10 +1260,14 @@ public:
 	virtual void Write(ImageInfo* pImageInfo, const float phase, LPBYTE pTrackImageBuffer, int nNibbles)
 	{
 		const UINT track = PhaseToTrack(phase);
-		DenibblizeTrack(pTrackImageBuffer, eDOSOrder, nNibbles);
-		WriteTrack(pImageInfo, track, ms_pWorkBuffer, TRACK_DENIBBLIZED_SIZE);
+		WriteNibblizedTrack(pImageInfo, pTrackImageBuffer, eDOSOrder, track, nNibbles);
 	}
 
+	virtual bool Read(ImageInfo* pImageInfo, UINT nBlock, LPBYTE pBlockBuffer) { return AccessFloppyBlock(pImageInfo, nBlock, eDOSOrder, pBlockBuffer, false); }
+	virtual bool Write(ImageInfo* pImageInfo, UINT nBlock, LPBYTE pBlockBuffer) { return AccessFloppyBlock(pImageInfo, nBlock, eDOSOrder, pBlockBuffer, true); }
+	virtual bool ReadSector(ImageInfo* pImageInfo, UINT nTrack, UINT nSector, LPBYTE pSectorBuffer) { return AccessSector(pImageInfo, nTrack, nSector, eDOSOrder, eDOSOrder, pSectorBuffer, false); }
+	virtual bool WriteSector(ImageInfo* pImageInfo, UINT nTrack, UINT nSector, LPBYTE pSectorBuffer) { return AccessSector(pImageInfo, nTrack, nSector, eDOSOrder, eDOSOrder, pSectorBuffer, true); }
+
 	virtual bool AllowCreate(void) { return true; }
 	virtual UINT GetImageSizeForCreate(void) { return TRACK_DENIBBLIZED_SIZE * TRACKS_STANDARD; }
 
@@ -701,8 +1323,7 @@ public:
 	virtual void Read(ImageInfo* pImageInfo, const float phase, LPBYTE pTrackImageBuffer, int* pNibbles, UINT* pBitCount, bool enhanceDisk)
 	{
 		const UINT track = PhaseToTrack(phase);
-		ReadTrack(pImageInfo, track, ms_pWorkBuffer, TRACK_DENIBBLIZED_SIZE);
-		*pNibbles = NibblizeTrack(pTrackImageBuffer, eProDOSOrder, track);
+		*pNibbles = ReadNibblizedTrack(pImageInfo, pTrackImageBuffer, eProDOSOrder, track);
 		if (!enhanceDisk)
 			SkewTrack(track, *pNibbles, pTrackImageBuffer);
 	}
@@ -710,10 +1331,14 @@ public:
 	virtual void Write(ImageInfo* pImageInfo, const float phase, LPBYTE pTrackImageBuffer, int nNibbles)
 	{
 		const UINT track = PhaseToTrack(phase);
-		DenibblizeTrack(pTrackImageBuffer, eProDOSOrder, nNibbles);
-		WriteTrack(pImageInfo, track, ms_pWorkBuffer, TRACK_DENIBBLIZED_SIZE);
+		WriteNibblizedTrack(pImageInfo, pTrackImageBuffer, eProDOSOrder, track, nNibbles);
 	}
 
+	virtual bool Read(ImageInfo* pImageInfo, UINT nBlock, LPBYTE pBlockBuffer) { return AccessFloppyBlock(pImageInfo, nBlock, eProDOSOrder, pBlockBuffer, false); }
+	virtual bool Write(ImageInfo* pImageInfo, UINT nBlock, LPBYTE pBlockBuffer) { return AccessFloppyBlock(pImageInfo, nBlock, eProDOSOrder, pBlockBuffer, true); }
+	virtual bool ReadSector(ImageInfo* pImageInfo, UINT nTrack, UINT nSector, LPBYTE pSectorBuffer) { return AccessSector(pImageInfo, nTrack, nSector, eDOSOrder, eProDOSOrder, pSectorBuffer, false); }
+	virtual bool WriteSector(ImageInfo* pImageInfo, UINT nTrack, UINT nSector, LPBYTE pSectorBuffer) { return AccessSector(pImageInfo, nTrack, nSector, eDOSOrder, eProDOSOrder, pSectorBuffer, true); }
+
 	virtual eImageType GetType(void) { return eImagePO; }
 	virtual const char* GetCreateExtensions(void) { return ".po"; }
 	virtual const char* GetRejectExtensions(void) { return ".do;.iie;.nib;.prg;.woz"; }
@@ -836,6 +1461,27 @@ public:
 		return WriteBlock(pImageInfo, nBlock, pBlockBuffer);
 	}
 
+	virtual bool ReadBlocks(ImageInfo* pImageInfo, UINT nBlock, UINT nBlocks, LPBYTE pBuffer)
+	{
+		return ReadBlock(pImageInfo, nBlock, pBuffer, nBlocks);
+	}
+
+	virtual bool WriteBlocks(ImageInfo* pImageInfo, UINT nBlock, UINT nBlocks, LPBYTE pBuffer)
+	{
+		if (pImageInfo->bWriteProtected)
+			return false;
+
+		return WriteBlock(pImageInfo, nBlock, pBuffer, nBlocks);
+	}
+
+	virtual bool Grow(ImageInfo* pImageInfo, UINT nBlocks)
+	{
+		if (pImageInfo->bWriteProtected)
+			return false;
+
+		return GrowBlocks(pImageInfo, nBlocks);
+	}
+
 	virtual eImageType GetType(void) { return eImageHDV; }
 	virtual const char* GetCreateExtensions(void) { return ".hdv"; }
 	virtual const char* GetRejectExtensions(void) { return ".do;.iie;.prg"; }
@@ -960,7 +1606,10 @@ public:
 			return false;
 		}
 
-		ReadFile(ptr->hFile, mem+address, length, &bytesread, NULL);
+		BYTE* pBuffer = new BYTE [length];
+		ReadFile(ptr->hFile, pBuffer, length, &bytesread, NULL);
+		MemWriteBlock(address, pBuffer, length);
+		delete [] pBuffer;
 		int loop = 192;
 		while (loop--)
 			*(memdirty+loop) = 0xFF;
@@ -1014,7 +1663,10 @@ public:
 		}
 
 		SetFilePointer(pImageInfo->hFile,128,NULL,FILE_BEGIN);
-		ReadFile(pImageInfo->hFile, mem+address, length, &bytesread, NULL);
+		BYTE* pBuffer = new BYTE [length];
+		ReadFile(pImageInfo->hFile, pBuffer, length, &bytesread, NULL);
+		MemWriteBlock(address, pBuffer, length);
+		delete [] pBuffer;
 
 		int loop = 192;
 		while (loop--)
@@ -1411,78 +2063,89 @@ ImageError_e CImageHelperBase::CheckGZipFile(LPCTSTR pszImageFilename, ImageInfo
 
 ImageError_e CImageHelperBase::CheckZipFile(LPCTSTR pszImageFilename, ImageInfo* pImageInfo, std::string& strFilenameInZip)
 {
-	unzFile hZipFile = unzOpen(pszImageFilename);
-	if (hZipFile == NULL)
-		return eIMAGE_ERROR_UNABLE_TO_OPEN_ZIP;
-
-	unz_global_info global_info;
-	unz_file_info file_info;
-	char szFilename[MAX_PATH];
-	memset(szFilename, 0, sizeof(szFilename));
-	int nRes = 0, nLen = 0;
+	std::vector<CZipCache::ZipEntry> vecEntries;
+	ImageError_e Err = CImageBase::ms_ZipCache.GetIndex(pszImageFilename, vecEntries);
+	if (Err != eIMAGE_ERROR_NONE)
+		return Err;
 
-	try
+	// Use the requested file (see GetZipEntryPathname()), else the 1st file in the archive
+	UINT uEntry = 0;
+	if (!strFilenameInZip.empty())
 	{
-		nRes = unzGetGlobalInfo(hZipFile, &global_info);
-		if (nRes != UNZ_OK)
-			throw eIMAGE_ERROR_ZIP;
+		while (uEntry < vecEntries.size() && _stricmp(vecEntries[uEntry].strFilename.c_str(), strFilenameInZip.c_str()) != 0)
+			uEntry++;
 
-		nRes = unzGoToFirstFile(hZipFile);	// Only support 1st file in zip archive for now
-		if (nRes != UNZ_OK)
-			throw eIMAGE_ERROR_ZIP;
+		if (uEntry == vecEntries.size())
+			return eIMAGE_ERROR_UNABLE_TO_OPEN;
+	}
 
-		nRes = unzGetCurrentFileInfo(hZipFile, &file_info, szFilename, MAX_PATH, NULL, 0, NULL, 0);
-		if (nRes != UNZ_OK)
-			throw eIMAGE_ERROR_ZIP;
+	CZipCache::ZipEntry& entry = vecEntries[uEntry];
 
-		const UINT uFileSize = file_info.uncompressed_size;
-		if (uFileSize > GetMaxImageSize())
-			throw eIMAGE_ERROR_BAD_SIZE;
+	const UINT uFileSize = entry.info.uncompressed_size;
+	if (uFileSize > GetMaxImageSize())
+		return eIMAGE_ERROR_BAD_SIZE;
 
-		pImageInfo->pImageBuffer = new BYTE[uFileSize];
+	pImageInfo->pImageBuffer = new BYTE[uFileSize];
+	int nLen = uFileSize;
 
-		nRes = unzOpenCurrentFile(hZipFile);
-		if (nRes != UNZ_OK)
-			throw eIMAGE_ERROR_ZIP;
+	if (!CImageBase::ms_ZipCache.GetFile(pszImageFilename, entry, pImageInfo->pImageBuffer))
+	{
+		unzFile hZipFile = unzOpen(pszImageFilename);
+		if (hZipFile == NULL)
+			return eIMAGE_ERROR_UNABLE_TO_OPEN_ZIP;
+
+		int nRes = 0;
+
+		try
+		{
+			nRes = unzGoToFilePos(hZipFile, &entry.pos);
+			if (nRes != UNZ_OK)
+				throw eIMAGE_ERROR_ZIP;
 
-		nLen = unzReadCurrentFile(hZipFile, pImageInfo->pImageBuffer, uFileSize);
-		if (nLen < 0)
+			nRes = unzOpenCurrentFile(hZipFile);
+			if (nRes != UNZ_OK)
+				throw eIMAGE_ERROR_ZIP;
+
+			nLen = unzReadCurrentFile(hZipFile, pImageInfo->pImageBuffer, uFileSize);
+			if (nLen < 0)
+			{
+				unzCloseCurrentFile(hZipFile);	// Must CloseCurrentFile before Close
+				throw eIMAGE_ERROR_UNSUPPORTED;
+			}
+
+			nRes = unzCloseCurrentFile(hZipFile);	// NB. Also checks the CRC (if the whole file was read)
+			if (nRes != UNZ_OK)
+				throw eIMAGE_ERROR_ZIP;
+		}
+		catch (ImageError_e error)
 		{
-			unzCloseCurrentFile(hZipFile);	// Must CloseCurrentFile before Close
-			throw eIMAGE_ERROR_UNSUPPORTED;
+			unzClose(hZipFile);
+			return error;
 		}
 
-		nRes = unzCloseCurrentFile(hZipFile);
+		nRes = unzClose(hZipFile);
+		hZipFile = NULL;
 		if (nRes != UNZ_OK)
-			throw eIMAGE_ERROR_ZIP;
-	}
-	catch (ImageError_e error)
-	{
-		if (hZipFile)
-			unzClose(hZipFile);
+			return eIMAGE_ERROR_ZIP;
 
-		return error;
+		if ((UINT)nLen == uFileSize)
+			CImageBase::ms_ZipCache.PutFile(pszImageFilename, entry, pImageInfo->pImageBuffer);
 	}
 
-	nRes = unzClose(hZipFile);
-	hZipFile = NULL;
-	if (nRes != UNZ_OK)
-		return eIMAGE_ERROR_ZIP;
-
-	strncpy(pImageInfo->szFilenameInZip, szFilename, MAX_PATH);
+	strncpy(pImageInfo->szFilenameInZip, entry.strFilename.c_str(), MAX_PATH);
 	pImageInfo->szFilenameInZip[MAX_PATH-1] = 0;
-	memcpy(&pImageInfo->zipFileInfo.tmz_date, &file_info.tmu_date, sizeof(file_info.tmu_date));
-	pImageInfo->zipFileInfo.dosDate     = file_info.dosDate;
-	pImageInfo->zipFileInfo.internal_fa = file_info.internal_fa;
-	pImageInfo->zipFileInfo.external_fa = file_info.external_fa;
-	pImageInfo->uNumEntriesInZip = global_info.number_entry;
-	strFilenameInZip = szFilename;
+	memcpy(&pImageInfo->zipFileInfo.tmz_date, &entry.info.tmu_date, sizeof(entry.info.tmu_date));
+	pImageInfo->zipFileInfo.dosDate     = entry.info.dosDate;
+	pImageInfo->zipFileInfo.internal_fa = entry.info.internal_fa;
+	pImageInfo->zipFileInfo.external_fa = entry.info.external_fa;
+	pImageInfo->uNumEntriesInZip = vecEntries.size();
+	strFilenameInZip = entry.strFilename;
 
 	//
 
 	// Determine the file's extension and convert it to lowercase
 	TCHAR szExt[_MAX_EXT] = "";
-	GetCharLowerExt(szExt, szFilename, _MAX_EXT);
+	GetCharLowerExt(szExt, entry.strFilename.c_str(), _MAX_EXT);
 
 	DWORD dwSize = nLen;
 	DWORD dwOffset = 0;
@@ -1490,7 +2153,7 @@ ImageError_e CImageHelperBase::CheckZipFile(LPCTSTR pszImageFilename, ImageInfo*
 
 	if (!pImageType)
 	{
-		if (global_info.number_entry > 1)
+		if (vecEntries.size() > 1)
 			return eIMAGE_ERROR_UNSUPPORTED_MULTI_ZIP;
 
 		return eIMAGE_ERROR_UNSUPPORTED;
@@ -1500,7 +2163,7 @@ ImageError_e CImageHelperBase::CheckZipFile(LPCTSTR pszImageFilename, ImageInfo*
 	if (Type == eImageAPL || Type == eImageIIE || Type == eImagePRG)
 		return eIMAGE_ERROR_UNSUPPORTED;
 
-	if (global_info.number_entry > 1)
+	if (vecEntries.size() > 1)
 		pImageInfo->bWriteProtected = 1;	// Zip archives with multiple files are read-only (for now)
 
 	SetImageInfo(pImageInfo, eFileZip, dwOffset, pImageType, dwSize);
@@ -1572,19 +2235,22 @@ ImageError_e CImageHelperBase::CheckNormalFile(LPCTSTR pszImageFilename, ImageIn
 		bool bTempDetectBuffer;
 		const UINT uDetectSize = GetMinDetectSize(dwSize, &bTempDetectBuffer);
 
-		pImageInfo->pImageBuffer = new BYTE [dwSize];
-
-		DWORD dwBytesRead;
-		BOOL bRes = ReadFile(hFile, pImageInfo->pImageBuffer, dwSize, &dwBytesRead, NULL);
-		if (!bRes || dwSize != dwBytesRead)
+		if (!MapImageFile(pImageInfo, dwSize))
 		{
-			delete [] pImageInfo->pImageBuffer;
-			pImageInfo->pImageBuffer = NULL;
-			return eIMAGE_ERROR_BAD_SIZE;
+			pImageInfo->pImageBuffer = new BYTE [dwSize];
+
+			DWORD dwBytesRead;
+			BOOL bRes = ReadFile(hFile, pImageInfo->pImageBuffer, dwSize, &dwBytesRead, NULL);
+			if (!bRes || dwSize != dwBytesRead)
+			{
+				delete [] pImageInfo->pImageBuffer;
+				pImageInfo->pImageBuffer = NULL;
+				return eIMAGE_ERROR_BAD_SIZE;
+			}
 		}
 
 		pImageType = Detect(pImageInfo->pImageBuffer, dwSize, szExt, dwOffset, pImageInfo->bWriteProtected, pImageInfo->pTrackMap, pImageInfo->optimalBitTiming);
-		if (bTempDetectBuffer)
+		if (bTempDetectBuffer && !pImageInfo->hMapping)	// NB. A mapped image is kept, and ReadBlock()/WriteBlock() use it
 		{
 			delete [] pImageInfo->pImageBuffer;
 			pImageInfo->pImageBuffer = NULL;
@@ -1627,6 +2293,7 @@ ImageError_e CImageHelperBase::CheckNormalFile(LPCTSTR pszImageFilename, ImageIn
 
 	if (!pImageType)
 	{
+		UnmapImageFile(pImageInfo);
 		CloseHandle(hFile);
 		hFile = INVALID_HANDLE_VALUE;
 
@@ -1652,6 +2319,36 @@ void CImageHelperBase::SetImageInfo(ImageInfo* pImageInfo, FileType_e eFileGZip,
 
 //-------------------------------------
 
+// "<archive>.zip\<file>" (if not itself an existing file) is a file within a zip archive, eg. the 2nd disk of a multi-disk game
+static bool GetZipEntryPathname(LPCTSTR pszImageFilename, std::string& strZipFilename, std::string& strFilenameInZip)
+{
+	if (GetFileAttributes(pszImageFilename) != INVALID_FILE_ATTRIBUTES)
+		return false;
+
+	const std::string strPathname(pszImageFilename);
+
+	for (size_t pos = 0; pos + ZIP_SUFFIX_LEN < strPathname.size(); pos++)
+	{
+		if (_strnicmp(&strPathname[pos], ZIP_SUFFIX, ZIP_SUFFIX_LEN) != 0)
+			continue;
+
+		const size_t end = pos + ZIP_SUFFIX_LEN;
+		if (strPathname[end] != '\\' && strPathname[end] != '/')
+			continue;
+
+		const DWORD dwAttributes = GetFileAttributes(strPathname.substr(0, end).c_str());
+		if (dwAttributes == INVALID_FILE_ATTRIBUTES || (dwAttributes & FILE_ATTRIBUTE_DIRECTORY))
+			continue;
+
+		strZipFilename = strPathname.substr(0, end);
+		strFilenameInZip = strPathname.substr(end+1);
+		std::replace(strFilenameInZip.begin(), strFilenameInZip.end(), '\\', '/');	// Zip archives use '/' separators
+		return !strFilenameInZip.empty();
+	}
+
+	return false;
+}
+
 ImageError_e CImageHelperBase::Open(	LPCTSTR pszImageFilename,
 										ImageInfo* pImageInfo,
 										const bool bCreateIfNecessary,
@@ -1661,6 +2358,7 @@ ImageError_e CImageHelperBase::Open(	LPCTSTR pszImageFilename,
 
 	ImageError_e Err;
     const size_t uStrLen = strlen(pszImageFilename);
+	std::string strZipFilename;
 
     if (uStrLen > GZ_SUFFIX_LEN && _stricmp(pszImageFilename+uStrLen-GZ_SUFFIX_LEN, GZ_SUFFIX) == 0)
 	{
@@ -1668,8 +2366,14 @@ ImageError_e CImageHelperBase::Open(	LPCTSTR pszImageFilename,
 	}
     else if (uStrLen > ZIP_SUFFIX_LEN && _stricmp(pszImageFilename+uStrLen-ZIP_SUFFIX_LEN, ZIP_SUFFIX) == 0)
 	{
+		strFilenameInZip.clear();	// Use the 1st file
 		Err = CheckZipFile(pszImageFilename, pImageInfo, strFilenameInZip);
 	}
+	else if (GetZipEntryPathname(pszImageFilename, strZipFilename, strFilenameInZip))
+	{
+		Err = CheckZipFile(strZipFilename.c_str(), pImageInfo, strFilenameInZip);
+		pImageInfo->bWriteProtected = true;	// Its pathname isn't the archive's, so it can't be written back
+	}
 	else
 	{
 		Err = CheckNormalFile(pszImageFilename, pImageInfo, bCreateIfNecessary);
@@ -1692,12 +2396,16 @@ ImageError_e CImageHelperBase::Open(	LPCTSTR pszImageFilename,
 
 void CImageHelperBase::Close(ImageInfo* pImageInfo, const bool bDeleteFile)
 {
+	UnmapImageFile(pImageInfo);
+
 	if (pImageInfo->hFile != INVALID_HANDLE_VALUE)
 	{
 		CloseHandle(pImageInfo->hFile);
 		pImageInfo->hFile = INVALID_HANDLE_VALUE;
 	}
 
+	CImageBase::ms_WriteBack.Close(pImageInfo, bDeleteFile);
+
 	if (bDeleteFile)
 	{
 		DeleteFile(pImageInfo->szFilename);
@@ -1707,6 +2415,9 @@ void CImageHelperBase::Close(ImageInfo* pImageInfo, const bool bDeleteFile)
 
 	delete [] pImageInfo->pImageBuffer;
 	pImageInfo->pImageBuffer = NULL;
+
+	delete pImageInfo->pNibblizedTrackCache;
+	pImageInfo->pNibblizedTrackCache = NULL;
 }
 
 //-----------------------------------------------------------------------------
@@ -1751,6 +2462,17 @@ CImageBase* CDiskImageHelper::Detect(LPBYTE pImage, DWORD dwSize, const TCHAR* p
 		}
 	}
 
+	// The image index says what this image was, so only fall back to trying every type if it no longer matches
+	if (imageType == eImageUNKNOWN && m_DetectHint != eImageUNKNOWN)
+	{
+		CImageBase* pImageType = GetImage(m_DetectHint);
+		if (pImageType && !(*pszExt && _tcsstr(pImageType->GetRejectExtensions(), pszExt)))
+		{
+			if (pImageType->Detect(pImage, dwSize, pszExt) == eMatch)
+				imageType = m_DetectHint;
+		}
+	}
+
 	if (imageType == eImageUNKNOWN)
 	{
 		for (UINT uLoop=0; uLoop < GetNumImages() && imageType == eImageUNKNOWN; uLoop++)
@@ -2,6 +2,7 @@
 
 #include "DiskDefs.h"
 #include "zip.h"
+#include "unzip.h"
 
 #define GZ_SUFFIX ".gz"
 #define GZ_SUFFIX_LEN (sizeof(GZ_SUFFIX)-1)
@@ -18,6 +19,14 @@ class CImageHelperBase;
 
 enum FileType_e {eFileNormal, eFileGZip, eFileZip};
 
+// DO & PO images: tracks are nibblized once, then served from here until written
+struct NibblizedTrackCache
+{
+	BYTE	uVolumeNumber;					// Volume number the tracks were nibblized with
+	UINT	uNibbles[TRACKS_MAX];			// 0 = track not cached
+	BYTE	track[TRACKS_MAX][NIBBLES_PER_TRACK];
+};
+
 struct ImageInfo
 {
 	TCHAR			szFilename[MAX_PATH];
@@ -35,12 +44,143 @@ struct ImageInfo
 	BYTE			ValidTrack[TRACKS_MAX];
 	UINT			uNumTracks;
 	BYTE*			pImageBuffer;
+	HANDLE			hMapping;	// Normal files: if non-NULL then pImageBuffer is a view of the file
+	bool			bMappedReadOnly;
+	NibblizedTrackCache* pNibblizedTrackCache;	// DO & PO only (allocated on first track read)
 	BYTE*			pTrackMap;	// WOZ only
 	BYTE			optimalBitTiming;	// WOZ only
 };
 
 //-------------------------------------
 
+// Background write-back of compressed (gzip/zip) images:
+// . Re-compressing the whole image on each dirty track/block stalls emulation, so WriteTrack()/WriteBlock() only update pImageBuffer
+// . The write-back thread re-compresses an image once it has had no writes for kQuietPeriod, or kMaxDelay after its first unsaved write
+// . Close() (eject) and Stop() (exit) write any pending image synchronously
+// . The archive is written to a temp file which then replaces the original, so a crash mid-write leaves the old image intact
+
+class CImageWriteBack
+{
+public:
+	CImageWriteBack(void) : m_hThread(NULL), m_hWakeEvent(NULL), m_hQuitEvent(NULL)
+	{
+		InitializeCriticalSection(&m_csBuffer);
+		InitializeCriticalSection(&m_csFile);
+	}
+	~CImageWriteBack(void)
+	{
+		_ASSERT(m_hThread == NULL);
+		DeleteCriticalSection(&m_csFile);
+		DeleteCriticalSection(&m_csBuffer);
+	}
+
+	void Start(void);
+	void Stop(void);
+
+	// Emulation thread: hold Lock() while modifying a compressed image's pImageBuffer, then call MarkDirty()
+	void Lock(void) { EnterCriticalSection(&m_csBuffer); }
+	void Unlock(void) { LeaveCriticalSection(&m_csBuffer); }
+	void MarkDirty(ImageInfo* pImageInfo);
+
+	void Close(ImageInfo* pImageInfo, const bool bDiscard);
+
+private:
+	struct PendingImage
+	{
+		DWORD dwFirstWrite;		// GetTickCount() of first write since the image was last saved
+		DWORD dwLastWrite;
+	};
+
+	static DWORD WINAPI ThreadProc(LPVOID lpParameter);
+	DWORD GetTimeUntilNextFlush(void);
+	void FlushDue(const bool bAll);
+	bool Flush(ImageInfo* pImageInfo);
+	static bool WriteCompressedImage(const FileType_e FileType, const std::string& strFilename, const std::string& strFilenameInZip, const zip_fileinfo& zipFileInfo, const std::vector<BYTE>& vecImage);
+
+	static const DWORD kQuietPeriod = 2000;	// ms
+	static const DWORD kMaxDelay = 10000;	// ms
+
+	typedef std::map<ImageInfo*, PendingImage> MAPPENDING;
+	MAPPENDING m_mapPending;		// Guarded by m_csBuffer
+
+	CRITICAL_SECTION m_csBuffer;	// Guards pImageBuffer (for compressed images) & m_mapPending
+	CRITICAL_SECTION m_csFile;		// Held while an image file is written, so Close() can't free the image during a flush
+	HANDLE m_hThread;
+	HANDLE m_hWakeEvent;
+	HANDLE m_hQuitEvent;
+};
+
+//-------------------------------------
+
+// Zip archives: an index of each archive's files, and a cache of recently decompressed files
+// . The index (from the archive's central directory) locates any file without scanning the archive
+// . Re-opening a cached file (eg. swapping between the disks of a multi-disk game) is a copy instead of an inflate
+// . An archive is re-indexed if its size or last-write time changes, and cached files are also matched by CRC
+// . Images can be opened on any thread (eg. by the image library scan), so all state is guarded by m_cs
+
+class CZipCache
+{
+public:
+	struct ZipEntry
+	{
+		std::string strFilename;
+		unz_file_pos pos;
+		unz_file_info info;
+	};
+
+	CZipCache(void) : m_uClock(0), m_uCachedBytes(0)
+	{
+		InitializeCriticalSection(&m_cs);
+	}
+	~CZipCache(void)
+	{
+		for (UINT i=0; i<m_vecCachedFiles.size(); i++)
+			delete m_vecCachedFiles[i];
+		DeleteCriticalSection(&m_cs);
+	}
+
+	ImageError_e GetIndex(LPCTSTR pszZipFilename, std::vector<ZipEntry>& vecEntries);
+	bool GetFile(LPCTSTR pszZipFilename, const ZipEntry& entry, LPBYTE pBuffer);
+	void PutFile(LPCTSTR pszZipFilename, const ZipEntry& entry, const LPBYTE pBuffer);
+	void Invalidate(LPCTSTR pszZipFilename);
+
+private:
+	struct ZipIndex
+	{
+		UINT64 uLastWrite;		// FILETIME
+		UINT uSize;
+		UINT uLastUsed;
+		std::vector<ZipEntry> vecEntries;
+	};
+
+	struct CachedFile
+	{
+		std::string strZipKey;
+		std::string strFilename;
+		uLong crc;
+		UINT uLastUsed;
+		std::vector<BYTE> data;
+	};
+
+	static std::string GetKey(LPCTSTR pszZipFilename);
+	static ImageError_e ReadIndex(LPCTSTR pszZipFilename, std::vector<ZipEntry>& vecEntries);
+	void RemoveCachedFile(const UINT uIndex);
+
+	static const UINT kMaxIndexes = 32;
+	static const UINT kMaxCachedBytes = 8*1024*1024;
+	static const UINT kMaxCachedFileSize = 2*1024*1024;	// eg. an 800K 3.5" image, but not a large HDV
+
+	typedef std::map<std::string, ZipIndex> MAPINDEX;
+	MAPINDEX m_mapIndex;
+	std::vector<CachedFile*> m_vecCachedFiles;
+	UINT m_uClock;				// For LRU eviction
+	UINT m_uCachedBytes;
+
+	CRITICAL_SECTION m_cs;
+};
+
+//-------------------------------------
+
 #define HD_BLOCK_SIZE 512
 
 #define UNIDISK35_800K_SIZE (800*1024)	// UniDisk 3.5"
@@ -60,6 +200,11 @@ public:
 	virtual bool Read(ImageInfo* pImageInfo, UINT nBlock, LPBYTE pBlockBuffer) { return false; }
 	virtual void Write(ImageInfo* pImageInfo, const float phase, LPBYTE pTrackImageBuffer, int nNibbles) { }
 	virtual bool Write(ImageInfo* pImageInfo, UINT nBlock, LPBYTE pBlockBuffer) { return false; }
+	virtual bool ReadBlocks(ImageInfo* pImageInfo, UINT nBlock, UINT nBlocks, LPBYTE pBuffer) { return false; }	// HDV only
+	virtual bool WriteBlocks(ImageInfo* pImageInfo, UINT nBlock, UINT nBlocks, LPBYTE pBuffer) { return false; }
+	virtual bool Grow(ImageInfo* pImageInfo, UINT nBlocks) { return false; }
+	virtual bool ReadSector(ImageInfo* pImageInfo, UINT nTrack, UINT nSector, LPBYTE pSectorBuffer) { return false; }	// DOS 3.3 logical sector (DO & PO only)
+	virtual bool WriteSector(ImageInfo* pImageInfo, UINT nTrack, UINT nSector, LPBYTE pSectorBuffer) { return false; }
 
 	virtual bool AllowBoot(void) { return false; }		// Only:    APL and PRG
 	virtual bool AllowRW(void) { return true; }			// All but: APL and PRG
@@ -71,6 +216,7 @@ public:
 	virtual const char* GetRejectExtensions(void) = 0;
 
 	void SetVolumeNumber(const BYTE uVolumeNumber) { m_uVolumeNumber = uVolumeNumber; }
+	BYTE GetVolumeNumber(void) { return m_uVolumeNumber; }
 	bool IsValidImageSize(const DWORD uImageSize);
 
 	// To accurately convert a half phase (quarter track) back to a track (round half tracks down), use: ceil(phase)/2, eg:
@@ -83,17 +229,26 @@ public:
 protected:
 	bool ReadTrack(ImageInfo* pImageInfo, const int nTrack, LPBYTE pTrackBuffer, const UINT uTrackSize);
 	bool WriteTrack(ImageInfo* pImageInfo, const int nTrack, LPBYTE pTrackBuffer, const UINT uTrackSize);
-	bool ReadBlock(ImageInfo* pImageInfo, const int nBlock, LPBYTE pBlockBuffer);
-	bool WriteBlock(ImageInfo* pImageInfo, const int nBlock, LPBYTE pBlockBuffer);
+	bool WriteImageData(ImageInfo* pImageInfo, const UINT uOffset, const LPBYTE pData, const UINT uSize);
+	bool ReadBlock(ImageInfo* pImageInfo, const int nBlock, LPBYTE pBlockBuffer, const UINT nBlocks=1);
+	bool WriteBlock(ImageInfo* pImageInfo, const int nBlock, LPBYTE pBlockBuffer, const UINT nBlocks=1);
+	void GrowImageBuffer(ImageInfo* pImageInfo, const UINT uNewImageSize);
+	bool GrowBlocks(ImageInfo* pImageInfo, const UINT nBlocks);
 
 	LPBYTE Code62(int sector);
 	void Decode62(LPBYTE imageptr);
 	void DenibblizeTrack (LPBYTE trackimage, SectorOrder_e SectorOrder, int nibbles);
 	DWORD NibblizeTrack (LPBYTE trackimagebuffer, SectorOrder_e SectorOrder, int track);
 	void SkewTrack (const int nTrack, const int nNumNibbles, const LPBYTE pTrackImageBuffer);
+	int ReadNibblizedTrack(ImageInfo* pImageInfo, LPBYTE pTrackImageBuffer, SectorOrder_e SectorOrder, const UINT track);
+	void WriteNibblizedTrack(ImageInfo* pImageInfo, LPBYTE pTrackImageBuffer, SectorOrder_e SectorOrder, const UINT track, const int nNibbles);
+	bool AccessSector(ImageInfo* pImageInfo, const UINT track, const UINT sector, SectorOrder_e SectorOrder, SectorOrder_e ImageOrder, LPBYTE pSectorBuffer, const bool bWrite);
+	bool AccessFloppyBlock(ImageInfo* pImageInfo, const UINT nBlock, SectorOrder_e ImageOrder, LPBYTE pBlockBuffer, const bool bWrite);
 
 public:
 	static LPBYTE ms_pWorkBuffer;
+	static CImageWriteBack ms_WriteBack;
+	static CZipCache ms_ZipCache;
 	UINT m_uNumTracksInImage;	// Init'd by CDiskImageHelper.Detect()/GetImageForCreation() & possibly updated by IsValidImageSize()
 
 protected:
@@ -290,7 +445,8 @@ public:
 	CImageHelperBase(const bool bIsFloppy) :
 		m_2IMGHelper(bIsFloppy),
 		m_Result2IMG(eMismatch),
-		m_WOZHelper()
+		m_WOZHelper(),
+		m_DetectHint(eImageUNKNOWN)
 	{
 	}
 	virtual ~CImageHelperBase(void)
@@ -307,6 +463,8 @@ public:
 	virtual UINT GetMaxImageSize(void) = 0;
 	virtual UINT GetMinDetectSize(const UINT uImageSize, bool* pTempDetectBuffer) = 0;
 
+	void SetDetectHint(eImageType Type) { m_DetectHint = Type; }	// Type to try first (eg. from the image index)
+
 protected:
 	ImageError_e CheckGZipFile(LPCTSTR pszImageFilename, ImageInfo* pImageInfo);
 	ImageError_e CheckZipFile(LPCTSTR pszImageFilename, ImageInfo* pImageInfo, std::string& strFilenameInZip);
@@ -337,6 +495,7 @@ protected:
 	C2IMGHelper m_2IMGHelper;
 	eDetectResult m_Result2IMG;
 	CWOZHelper m_WOZHelper;
+	eImageType m_DetectHint;
 };
 
 //-------------------------------------
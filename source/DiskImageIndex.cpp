@@ -0,0 +1,615 @@
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2010, Tom Charlesworth, Michael Pohoreski
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/* Description: Image library index
+ *
+ * Author: Various
+ */
+
+/*
+Index file format
+-----------------
+A text file, with one line per image and the fields separated by tabs:
+	pathname, type, file size, last-write FILETIME (hex), hash (hex), volume name, catalog ('|' separated)
+Lines starting with '#' are comments. Tabs, '|' and control characters in names are written as '?'.
+
+NIB and WOZ images are indexed without a catalog, as this would mean denibblizing the whole disk.
+*/
+
+#include "StdAfx.h"
+
+#include "Common.h"
+#include "DiskImage.h"
+#include "DiskImageHelper.h"
+#include "DiskImageIndex.h"
+#include "Log.h"
+
+static std::vector<ImageIndexEntry> g_vecImageIndex;
+static std::map<std::string, UINT> g_mapImageIndex;	// Lower-case pathname -> g_vecImageIndex[]
+
+static const char* const g_szIndexHeader = "# AppleWin image index v1";
+
+static const char* const g_szImageExtensions[] = { ".bin", ".do", ".dsk", ".nib", ".po", ".woz", ".2mg", ".2img", ".iie", ".apl", ".prg", ".hdv", ".gz", ".zip" };
+
+// Indexed by eImageType
+static const char* const g_szImageTypeNames[] = { "UNKNOWN", "DO", "PO", "NIB1", "NIB2", "HDV", "IIE", "APL", "PRG", "WOZ1", "WOZ2" };
+
+static const UINT kMaxScanThreads = 32;				// NB. WaitForMultipleObjects() can wait for at most MAXIMUM_WAIT_OBJECTS (64)
+static const UINT kMaxCatalogFiles = 4096;			// Guards against corrupt (eg. circular) catalogs
+static const UINT kMaxDirectoryBlocks = 1024;
+static const UINT kMaxDirectoryDepth = 8;
+static const UINT kHashChunkBlocks = 64;
+
+static const UINT64 kFNVOffsetBasis = 0xCBF29CE484222325ULL;
+static const UINT64 kFNVPrime = 0x00000100000001B3ULL;
+
+//===========================================================================
+
+static std::string ToLower(const std::string& str)
+{
+	std::string strLower(str);
+	for (UINT i=0; i<strLower.size(); i++)
+		strLower[i] = (char) tolower((BYTE)strLower[i]);
+	return strLower;
+}
+
+static std::string GetFilename(const std::string& strPathname)
+{
+	const size_t pos = strPathname.find_last_of("\\/");
+	return (pos == std::string::npos) ? strPathname : strPathname.substr(pos+1);
+}
+
+static bool IsImageExtension(LPCSTR pszFilename)
+{
+	LPCSTR pszExt = strrchr(pszFilename, '.');
+	if (!pszExt)
+		return false;
+
+	for (UINT i=0; i<sizeof(g_szImageExtensions)/sizeof(g_szImageExtensions[0]); i++)
+	{
+		if (_stricmp(pszExt, g_szImageExtensions[i]) == 0)
+			return true;
+	}
+
+	return false;
+}
+
+//===========================================================================
+
+// Catalog decoding (DO & PO images use the DOS 3.3 sector or ProDOS block interface of their CImageBase)
+
+static std::string GetDOS33Filename(const BYTE* pName)
+{
+	std::string strName;
+	for (UINT i=0; i<30; i++)
+		strName += (char) (pName[i] & 0x7F);
+
+	const size_t end = strName.find_last_not_of(' ');
+	strName.erase(end == std::string::npos ? 0 : end+1);
+	return strName;
+}
+
+static bool ReadDOS33Catalog(ImageInfo& info, ImageIndexEntry& entry)
+{
+	BYTE vtoc[256];
+	if (!info.pImageType->ReadSector(&info, 17, 0, vtoc))
+		return false;
+
+	// Max track/sector pairs per T/S list sector & sectors per track
+	if (vtoc[0x27] != 122 || vtoc[0x35] != NUM_SECTORS)
+		return false;
+
+	char szVolume[16];
+	sprintf(szVolume, "DISK VOLUME %d", vtoc[0x06]);
+	entry.strVolumeName = szVolume;
+
+	UINT track = vtoc[0x01];
+	UINT sector = vtoc[0x02];
+
+	for (UINT n=0; n < info.uNumTracks*NUM_SECTORS && track != 0; n++)
+	{
+		BYTE catalog[256];
+		if (sector >= NUM_SECTORS || !info.pImageType->ReadSector(&info, track, sector, catalog))
+			break;
+
+		for (UINT i=0; i<7; i++)
+		{
+			const BYTE* pEntry = &catalog[0x0B + i*35];
+			if (pEntry[0] == 0x00)		// Never used: end of catalog
+				return true;
+			if (pEntry[0] == 0xFF)		// Deleted
+				continue;
+
+			if (entry.vecFiles.size() >= kMaxCatalogFiles)
+				return true;
+			entry.vecFiles.push_back( GetDOS33Filename(&pEntry[0x03]) );
+		}
+
+		track = catalog[0x01];
+		sector = catalog[0x02];
+	}
+
+	return true;
+}
+
+static void ReadProDOSDirectory(ImageInfo& info, UINT block, const std::string& strPrefix, const UINT depth, ImageIndexEntry& entry)
+{
+	BYTE buffer[HD_BLOCK_SIZE];
+	UINT entryLength = 0;
+	UINT entriesPerBlock = 0;
+
+	for (UINT n=0; n < kMaxDirectoryBlocks && block != 0; n++)
+	{
+		if (!info.pImageType->Read(&info, block, buffer))
+			return;
+
+		UINT i = 0;
+		if (n == 0)
+		{
+			// Volume or subdirectory header
+			entryLength = buffer[0x04+0x1F];
+			entriesPerBlock = buffer[0x04+0x20];
+			if (entryLength < 0x27 || entriesPerBlock == 0 || 0x04 + entryLength*entriesPerBlock > HD_BLOCK_SIZE)
+				return;
+			i = 1;
+		}
+
+		for (; i<entriesPerBlock; i++)
+		{
+			const BYTE* pEntry = &buffer[0x04 + i*entryLength];
+			const BYTE storageType = pEntry[0] >> 4;
+			if (storageType == 0)		// Deleted
+				continue;
+
+			const std::string strName = strPrefix + std::string((const char*)&pEntry[1], pEntry[0] & 0x0F);
+
+			if (entry.vecFiles.size() >= kMaxCatalogFiles)
+				return;
+
+			if (storageType == 0xD)		// Subdirectory
+			{
+				entry.vecFiles.push_back(strName + "/");
+				if (depth < kMaxDirectoryDepth)
+					ReadProDOSDirectory(info, pEntry[0x11] | (pEntry[0x12] << 8), strName + "/", depth+1, entry);
+			}
+			else
+			{
+				entry.vecFiles.push_back(strName);
+			}
+		}
+
+		block = buffer[0x02] | (buffer[0x03] << 8);
+	}
+}
+
+static bool ReadProDOSCatalog(ImageInfo& info, ImageIndexEntry& entry)
+{
+	const UINT kVolumeDirectoryBlock = 2;
+
+	BYTE buffer[HD_BLOCK_SIZE];
+	if (!info.pImageType->Read(&info, kVolumeDirectoryBlock, buffer))
+		return false;
+
+	// No previous block, and a volume directory header
+	if (buffer[0x00] != 0 || buffer[0x01] != 0 || (buffer[0x04] >> 4) != 0xF)
+		return false;
+
+	entry.strVolumeName = "/" + std::string((const char*)&buffer[0x05], buffer[0x04] & 0x0F);
+
+	ReadProDOSDirectory(info, kVolumeDirectoryBlock, "", 0, entry);
+	return true;
+}
+
+//===========================================================================
+
+static UINT64 HashImage(ImageInfo& info)
+{
+	UINT64 uHash = kFNVOffsetBasis;
+
+	if (info.pImageBuffer)
+	{
+		for (UINT i=info.uOffset; i<info.uImageSize; i++)
+			uHash = (uHash ^ info.pImageBuffer[i]) * kFNVPrime;
+		return uHash;
+	}
+
+	// An HDV which couldn't be mapped, so read it a chunk at a time
+	BYTE* pBuffer = new BYTE [kHashChunkBlocks * HD_BLOCK_SIZE];
+	const UINT uNumBlocks = (info.uImageSize - info.uOffset) / HD_BLOCK_SIZE;
+
+	for (UINT block=0; block<uNumBlocks; block+=kHashChunkBlocks)
+	{
+		const UINT nBlocks = (uNumBlocks - block < kHashChunkBlocks) ? uNumBlocks - block : kHashChunkBlocks;
+		if (!info.pImageType->ReadBlocks(&info, block, nBlocks, pBuffer))
+			break;
+
+		for (UINT i=0; i<nBlocks * HD_BLOCK_SIZE; i++)
+			uHash = (uHash ^ pBuffer[i]) * kFNVPrime;
+	}
+
+	delete [] pBuffer;
+	return uHash;
+}
+
+static bool OpenImage(CImageHelperBase& helper, LPCSTR pszPathname, ImageInfo& info)
+{
+	ZeroMemory(&info, sizeof(info));
+	info.bWriteProtected = true;	// Open read-only (which also means a zero-length file is never created or deleted)
+	info.pImageHelper = &helper;
+
+	std::string strFilenameInZip;
+	if (helper.Open(pszPathname, &info, false, strFilenameInZip) == eIMAGE_ERROR_NONE)
+		return true;
+
+	helper.Close(&info, false);
+	return false;
+}
+
+// Called on a scan thread, so only uses that thread's image helpers
+static void ScanImage(CDiskImageHelper& diskHelper, CHardDiskImageHelper& hardDiskHelper, ImageIndexEntry& entry)
+{
+	ImageInfo info;
+	bool bOpen = OpenImage(diskHelper, entry.strPathname.c_str(), info);
+
+	if (bOpen && info.pImageType->GetType() == eImageHDV)
+	{
+		diskHelper.Close(&info, false);
+		bOpen = false;
+	}
+
+	if (!bOpen)
+	{
+		if (!OpenImage(hardDiskHelper, entry.strPathname.c_str(), info))
+			return;
+	}
+
+	entry.type = info.pImageType->GetType();
+	entry.uHash = HashImage(info);
+
+	if (entry.type == eImageDO || entry.type == eImagePO)
+	{
+		info.uNumTracks = diskHelper.GetNumTracksInImage(info.pImageType);
+		if (!ReadDOS33Catalog(info, entry))
+		{
+			entry.vecFiles.clear();
+			ReadProDOSCatalog(info, entry);
+		}
+	}
+	else if (entry.type == eImageHDV)
+	{
+		ReadProDOSCatalog(info, entry);
+	}
+
+	info.pImageHelper->Close(&info, false);
+}
+
+struct ScanJob
+{
+	std::vector<ImageIndexEntry>* pEntries;
+	LONG nNext;		// Next entry to scan
+};
+
+static DWORD WINAPI ScanThreadProc(LPVOID lpParameter)
+{
+	ScanJob* pJob = (ScanJob*) lpParameter;
+	CDiskImageHelper diskHelper;
+	CHardDiskImageHelper hardDiskHelper;
+
+	while (true)
+	{
+		const UINT n = (UINT) (InterlockedIncrement(&pJob->nNext) - 1);
+		if (n >= pJob->pEntries->size())
+			break;
+
+		ScanImage(diskHelper, hardDiskHelper, (*pJob->pEntries)[n]);
+	}
+
+	return 0;
+}
+
+static void FindImages(const std::string& strDirectory, std::vector<ImageIndexEntry>& vecEntries)
+{
+	WIN32_FIND_DATA fd;
+	HANDLE hFind = FindFirstFile((strDirectory + "\\*").c_str(), &fd);
+	if (hFind == INVALID_HANDLE_VALUE)
+		return;
+
+	do
+	{
+		if (strcmp(fd.cFileName, ".") == 0 || strcmp(fd.cFileName, "..") == 0)
+			continue;
+
+		const std::string strPathname = strDirectory + "\\" + fd.cFileName;
+
+		if (fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+		{
+			if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))	// Don't follow junctions, as they can loop
+				FindImages(strPathname, vecEntries);
+		}
+		else if (fd.nFileSizeHigh == 0 && fd.nFileSizeLow != 0 && IsImageExtension(fd.cFileName))
+		{
+			ImageIndexEntry entry;
+			entry.strPathname = strPathname;
+			entry.type = eImageUNKNOWN;
+			entry.uSize = fd.nFileSizeLow;
+			entry.uLastWrite = ((UINT64)fd.ftLastWriteTime.dwHighDateTime << 32) | fd.ftLastWriteTime.dwLowDateTime;
+			entry.uHash = 0;
+			vecEntries.push_back(entry);
+		}
+	}
+	while (FindNextFile(hFind, &fd));
+
+	FindClose(hFind);
+}
+
+//===========================================================================
+
+static std::string SanitizeName(const std::string& strName)
+{
+	std::string str(strName);
+	for (UINT i=0; i<str.size(); i++)
+	{
+		if ((BYTE)str[i] < 0x20 || str[i] == '|' || str[i] == 0x7F)
+			str[i] = '?';
+	}
+	return str;
+}
+
+static bool WriteIndex(LPCSTR pszIndexFilename, const std::vector<ImageIndexEntry>& vecEntries)
+{
+	FILE* fp = fopen(pszIndexFilename, "wt");
+	if (!fp)
+		return false;
+
+	fprintf(fp, "%s\n", g_szIndexHeader);
+
+	for (UINT n=0; n<vecEntries.size(); n++)
+	{
+		const ImageIndexEntry& entry = vecEntries[n];
+		if (entry.type == eImageUNKNOWN)
+			continue;
+
+		fprintf(fp, "%s\t%s\t%u\t%I64X\t%016I64X\t%s\t",
+			entry.strPathname.c_str(), g_szImageTypeNames[entry.type], entry.uSize, entry.uLastWrite, entry.uHash,
+			SanitizeName(entry.strVolumeName).c_str());
+
+		for (UINT i=0; i<entry.vecFiles.size(); i++)
+			fprintf(fp, "%s%s", i ? "|" : "", SanitizeName(entry.vecFiles[i]).c_str());
+
+		fprintf(fp, "\n");
+	}
+
+	const bool bRes = ferror(fp) == 0;
+	fclose(fp);
+	return bRes;
+}
+
+// Scan a directory tree for images on a pool of threads (one per processor), and write their index
+// . Returns the number of images indexed
+UINT ImageIndexScan(LPCSTR pszDirectory, LPCSTR pszIndexFilename)
+{
+	char szDirectory[MAX_PATH];
+	const DWORD uLen = GetFullPathName(pszDirectory, MAX_PATH, szDirectory, NULL);
+	if (uLen == 0 || uLen >= MAX_PATH)
+		return 0;
+
+	std::string strDirectory(szDirectory);
+	if (!strDirectory.empty() && strDirectory[strDirectory.size()-1] == '\\')
+		strDirectory.erase(strDirectory.size()-1);
+
+	std::vector<ImageIndexEntry> vecEntries;
+	FindImages(strDirectory, vecEntries);
+
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	UINT uNumThreads = sysInfo.dwNumberOfProcessors;
+	if (uNumThreads > kMaxScanThreads)		uNumThreads = kMaxScanThreads;
+	if (uNumThreads > vecEntries.size())	uNumThreads = vecEntries.size();
+
+	ScanJob job = { &vecEntries, 0 };
+	std::vector<HANDLE> vecThreads;
+
+	for (UINT i=0; i<uNumThreads; i++)
+	{
+		DWORD dwThreadId;
+		HANDLE hThread = CreateThread(NULL,				// lpThreadAttributes
+										0,				// dwStackSize
+										ScanThreadProc,
+										&job,			// lpParameter
+										0,				// dwCreationFlags : 0 = Run immediately
+										&dwThreadId);	// lpThreadId
+		if (hThread)
+			vecThreads.push_back(hThread);
+	}
+
+	if (!vecThreads.empty())
+	{
+		WaitForMultipleObjects(vecThreads.size(), &vecThreads[0], TRUE, INFINITE);
+		for (UINT i=0; i<vecThreads.size(); i++)
+			CloseHandle(vecThreads[i]);
+	}
+	else
+	{
+		ScanThreadProc(&job);	// No threads, so scan on this one
+	}
+
+	UINT uNumImages = 0;
+	for (UINT n=0; n<vecEntries.size(); n++)
+	{
+		if (vecEntries[n].type != eImageUNKNOWN)
+			uNumImages++;
+	}
+
+	LogFileOutput("ImageIndex: scanned %d files in %s (%d threads), found %d images\n", vecEntries.size(), strDirectory.c_str(), vecThreads.size(), uNumImages);
+
+	if (!WriteIndex(pszIndexFilename, vecEntries))
+	{
+		LogFileOutput("ImageIndex: failed to write %s\n", pszIndexFilename);
+		return 0;
+	}
+
+	return uNumImages;
+}
+
+//===========================================================================
+
+static bool ReadLine(FILE* fp, std::string& strLine)
+{
+	strLine.clear();
+
+	char buffer[1024];
+	while (fgets(buffer, sizeof(buffer), fp))
+	{
+		strLine += buffer;
+		if (strLine[strLine.size()-1] == '\n')
+		{
+			strLine.erase(strLine.size()-1);
+			return true;
+		}
+	}
+
+	return !strLine.empty();
+}
+
+static void Split(const std::string& str, const char delimiter, std::vector<std::string>& vecFields)
+{
+	vecFields.clear();
+
+	size_t start = 0;
+	while (true)
+	{
+		const size_t end = str.find(delimiter, start);
+		vecFields.push_back(str.substr(start, end == std::string::npos ? std::string::npos : end-start));
+		if (end == std::string::npos)
+			break;
+		start = end+1;
+	}
+}
+
+bool ImageIndexLoad(LPCSTR pszIndexFilename)
+{
+	g_vecImageIndex.clear();
+	g_mapImageIndex.clear();
+
+	FILE* fp = fopen(pszIndexFilename, "rt");
+	if (!fp)
+		return false;
+
+	std::string strLine;
+	std::vector<std::string> vecFields;
+
+	while (ReadLine(fp, strLine))
+	{
+		if (strLine.empty() || strLine[0] == '#')
+			continue;
+
+		Split(strLine, '\t', vecFields);
+		if (vecFields.size() != 7)
+			continue;
+
+		ImageIndexEntry entry;
+		entry.strPathname = vecFields[0];
+		entry.type = eImageUNKNOWN;
+		for (UINT i=eImageUNKNOWN+1; i<sizeof(g_szImageTypeNames)/sizeof(g_szImageTypeNames[0]); i++)
+		{
+			if (vecFields[1] == g_szImageTypeNames[i])
+				entry.type = (BYTE) i;
+		}
+		if (entry.type == eImageUNKNOWN)
+			continue;
+
+		entry.uSize = strtoul(vecFields[2].c_str(), NULL, 10);
+		entry.uLastWrite = _strtoui64(vecFields[3].c_str(), NULL, 16);
+		entry.uHash = _strtoui64(vecFields[4].c_str(), NULL, 16);
+		entry.strVolumeName = vecFields[5];
+		if (!vecFields[6].empty())
+			Split(vecFields[6], '|', entry.vecFiles);
+
+		g_mapImageIndex[ToLower(entry.strPathname)] = g_vecImageIndex.size();
+		g_vecImageIndex.push_back(entry);
+	}
+
+	fclose(fp);
+
+	LogFileOutput("ImageIndex: loaded %d images from %s\n", g_vecImageIndex.size(), pszIndexFilename);
+	return true;
+}
+
+// Returns the image's entry, but only if the file is unchanged since it was scanned
+const ImageIndexEntry* ImageIndexLookup(LPCSTR pszPathname)
+{
+	if (g_vecImageIndex.empty())
+		return NULL;
+
+	char szPathname[MAX_PATH];
+	const DWORD uLen = GetFullPathName(pszPathname, MAX_PATH, szPathname, NULL);
+	if (uLen == 0 || uLen >= MAX_PATH)
+		return NULL;
+
+	std::map<std::string, UINT>::const_iterator it = g_mapImageIndex.find(ToLower(szPathname));
+	if (it == g_mapImageIndex.end())
+		return NULL;
+
+	const ImageIndexEntry& entry = g_vecImageIndex[it->second];
+
+	WIN32_FILE_ATTRIBUTE_DATA fileData;
+	if (!GetFileAttributesEx(szPathname, GetFileExInfoStandard, &fileData))
+		return NULL;
+
+	const UINT64 uLastWrite = ((UINT64)fileData.ftLastWriteTime.dwHighDateTime << 32) | fileData.ftLastWriteTime.dwLowDateTime;
+	if (fileData.nFileSizeHigh != 0 || fileData.nFileSizeLow != entry.uSize || uLastWrite != entry.uLastWrite)
+		return NULL;
+
+	return &entry;
+}
+
+// Find images by name (case-insensitive): first those whose filename matches (with or without its extension), then those with a matching file in their catalog
+UINT ImageIndexFind(LPCSTR pszName, std::vector<const ImageIndexEntry*>& vecEntries)
+{
+	vecEntries.clear();
+	const std::string strName = ToLower(pszName);
+
+	for (UINT n=0; n<g_vecImageIndex.size(); n++)
+	{
+		const std::string strFilename = ToLower(GetFilename(g_vecImageIndex[n].strPathname));
+		const size_t dot = strFilename.rfind('.');
+		if (strFilename == strName || (dot != std::string::npos && strFilename.substr(0, dot) == strName))
+			vecEntries.push_back(&g_vecImageIndex[n]);
+	}
+
+	for (UINT n=0; n<g_vecImageIndex.size(); n++)
+	{
+		const std::vector<std::string>& vecFiles = g_vecImageIndex[n].vecFiles;
+		for (UINT i=0; i<vecFiles.size(); i++)
+		{
+			if (ToLower(vecFiles[i]) == strName || ToLower(GetFilename(vecFiles[i])) == strName)
+			{
+				if (std::find(vecEntries.begin(), vecEntries.end(), &g_vecImageIndex[n]) == vecEntries.end())
+					vecEntries.push_back(&g_vecImageIndex[n]);
+				break;
+			}
+		}
+	}
+
+	return vecEntries.size();
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+/*
+AppleWin : An Apple //e emulator for Windows
+
+Copyright (C) 1994-1996, Michael O'Brien
+Copyright (C) 1999-2001, Oliver Schmidt
+Copyright (C) 2002-2005, Tom Charlesworth
+Copyright (C) 2006-2010, Tom Charlesworth, Michael Pohoreski
+
+AppleWin is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+AppleWin is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with AppleWin; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+// Image library index: built by scanning a directory tree (-scan-images), loaded with -image-index
+// . Lets ImageOpen() skip straight to the image's type, and images be found by name
+
+struct ImageIndexEntry
+{
+	std::string strPathname;
+	BYTE type;				// eImageType
+	UINT uSize;				// File size
+	UINT64 uLastWrite;		// FILETIME
+	UINT64 uHash;			// 64-bit FNV-1a of the image data (excluding any 2IMG/MacBinary header)
+	std::string strVolumeName;
+	std::vector<std::string> vecFiles;	// DOS 3.3 or ProDOS catalog (ProDOS subdirectory files as "DIR/FILE")
+};
+
+UINT ImageIndexScan(LPCSTR pszDirectory, LPCSTR pszIndexFilename);
+bool ImageIndexLoad(LPCSTR pszIndexFilename);
+const ImageIndexEntry* ImageIndexLookup(LPCSTR pszPathname);
+UINT ImageIndexFind(LPCSTR pszName, std::vector<const ImageIndexEntry*>& vecEntries);
@@ -709,6 +709,9 @@ void FrameDrawDiskLEDS( HDC passdc )
 	g_eStatusDrive1 = eDrive1Status;
 	g_eStatusDrive2 = eDrive2Status;
 
+	if (g_hFrameWindow == NULL)	// eg. -headless (GetDC(NULL) would draw on the desktop)
+		return;
+
 	// Draw Track/Sector
 	FrameReleaseDC();
 	HDC  dc     = (passdc ? passdc : GetDC(g_hFrameWindow));
@@ -745,7 +748,7 @@ void FrameDrawDiskLEDS( HDC passdc )
 //===========================================================================
 void FrameDrawDiskStatus( HDC passdc )
 {
-	if (mem == NULL)
+	if (memread[0] == NULL)
 		return;
 
 	if (g_nAppMode == MODE_LOGO)
@@ -763,14 +766,14 @@ void FrameDrawDiskStatus( HDC passdc )
 	int nDisk2Track  = sg_Disk2Card.GetTrack(DRIVE_2);
 
 	// Probe known OS's for Track/Sector
-	int  isProDOS = mem[ 0xBF00 ] == 0x4C;
+	int  isProDOS = *MemGetReadPtr( 0xBF00 ) == 0x4C;
 	bool isValid  = true;
 
 	// Try DOS3.3 Sector
 	if ( !isProDOS )
 	{
-		int nDOS33track  = mem[ 0xB7EC ];
-		int nDOS33sector = mem[ 0xB7ED ];
+		int nDOS33track  = *MemGetReadPtr( 0xB7EC );
+		int nDOS33sector = *MemGetReadPtr( 0xB7ED );
 
 		if ((nDOS33track  >= 0 && nDOS33track  < 40)
 		&&  (nDOS33sector >= 0 && nDOS33sector < 16))
@@ -792,7 +795,7 @@ void FrameDrawDiskStatus( HDC passdc )
 	}
 	else // isProDOS
 	{
-		// we can't just read from mem[ 0xD357 ] since it might be bank-switched from ROM
+		// we can't just read from memread[] for $D357 since it might be bank-switched from ROM
 		// and we need the Language Card RAM
 		// memrom[ 0xD350 ] = " ERROR\x07\x00"  Applesoft error message
 		//                             T   S
@@ -826,6 +829,9 @@ void FrameDrawDiskStatus( HDC passdc )
 	if (g_nSectorDrive2 < 0) sprintf_s( g_sSectorDrive2, sizeof(g_sSectorDrive2), "??" );
 	else                     sprintf_s( g_sSectorDrive2, sizeof(g_sSectorDrive2), "%2d", g_nSectorDrive2 );
 
+	if (g_hFrameWindow == NULL)	// eg. -headless (GetDC(NULL) would draw on the desktop)
+		return;
+
 	// Draw Track/Sector
 	FrameReleaseDC();
 	HDC  dc     = (passdc ? passdc : GetDC(g_hFrameWindow));
@@ -2637,6 +2643,29 @@ void FrameReleaseDC () {
   }
 }
 
+//===========================================================================
+// MessageBox() owned by the frame window
+// . Headless: there's no-one to click it, so just log it & take the default button (so batch jobs don't block)
+int FrameMessageBox (LPCSTR lpText, LPCSTR lpCaption, UINT uType)
+{
+	if (!g_bHeadless)
+		return MessageBox(g_hFrameWindow, lpText, lpCaption, uType);
+
+	LogFileOutput("MessageBox: %s: %s\n", lpCaption ? lpCaption : "Error", lpText);
+
+	const UINT nDefButton = (uType & MB_DEFMASK) >> 8;	// 0..3
+
+	switch (uType & MB_TYPEMASK)
+	{
+	case MB_OKCANCEL:			return nDefButton == 0 ? IDOK : IDCANCEL;
+	case MB_ABORTRETRYIGNORE:	return nDefButton == 0 ? IDABORT : nDefButton == 1 ? IDRETRY : IDIGNORE;
+	case MB_YESNOCANCEL:		return nDefButton == 0 ? IDYES : nDefButton == 1 ? IDNO : IDCANCEL;
+	case MB_YESNO:				return nDefButton == 0 ? IDYES : IDNO;
+	case MB_RETRYCANCEL:		return nDefButton == 0 ? IDRETRY : IDCANCEL;
+	default:					return IDOK;
+	}
+}
+
 //===========================================================================
 void FrameRefreshStatus (int drawflags, bool bUpdateDiskStatus) {
 	// NB. 99% of the time we draw the disk status.  On DiskDriveSwap() we don't.
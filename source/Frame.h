@@ -24,6 +24,7 @@
 	void    FrameCreateWindow(void);
 	HDC     FrameGetDC ();
 	void    FrameReleaseDC ();
+	int     FrameMessageBox (LPCSTR lpText, LPCSTR lpCaption, UINT uType);
 	void    FrameRefreshStatus (int, bool bUpdateDiskStatus = true );
 	void    FrameRegisterClass ();
 	void	FrameSetCursorPosByMousePos();
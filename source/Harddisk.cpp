@@ -33,6 +33,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "DiskImageHelper.h"
 #include "Frame.h"
 #include "Harddisk.h"
+#include "Log.h"
 #include "Memory.h"
 #include "Registry.h"
 #include "YamlHelper.h"
@@ -112,6 +113,26 @@ Overview
       sound card in slot 7 is a generally bad idea) will cause problems.
 */
 
+// Block cache:
+// . ProDOS makes a separate request for each 512-byte block, so each HDD keeps its most recently used blocks
+// . Read miss: if it follows on from the previous read, then also read ahead the next blocks (as one image access)
+// . Write: the block is just marked dirty, and dirty blocks are written back (contiguous blocks as one image access)
+//   when one is evicted, once the HDD has been idle for HD_FLUSH_CYCLES, or on reset/eject/save-state
+// . A write beyond the end of the image first extends the image to that block in one step (see ImageGrow())
+
+static const UINT HD_CACHE_BLOCKS = 64;			// 32KB per HDD
+static const UINT HD_READ_AHEAD_BLOCKS = 8;
+static const UINT HD_FLUSH_CYCLES = 1000*1000;	// 1M cycles = ~1.000s
+
+struct HDCacheBlock
+{
+	UINT	block;
+	UINT	lastUsed;
+	bool	valid;
+	bool	dirty;
+	BYTE	data[HD_BLOCK_SIZE];
+};
+
 struct HDD
 {
 	HDD()
@@ -134,6 +155,11 @@ struct HDD
 		hd_buf_ptr = 0;
 		hd_imageloaded = false;
 		ZeroMemory(hd_buf, sizeof(hd_buf));
+		ZeroMemory(cache, sizeof(cache));
+		cacheClock = 0;
+		cacheLastReadBlock = (UINT)-1;
+		cacheDirty = false;
+		cacheIdleCycles = 0;
 #if HD_LED
 		hd_status_next = DISK_STATUS_OFF;
 		hd_status_prev = DISK_STATUS_OFF;
@@ -153,6 +179,12 @@ struct HDD
 	WORD	hd_buf_ptr;
 	bool	hd_imageloaded;
 	BYTE	hd_buf[HD_BLOCK_SIZE+1];	// Why +1? Probably for erroreous reads beyond the block size (ie. reads from I/O addr 0xC0F8)
+	//
+	HDCacheBlock cache[HD_CACHE_BLOCKS];
+	UINT	cacheClock;					// For LRU
+	UINT	cacheLastReadBlock;			// For read-ahead
+	bool	cacheDirty;
+	UINT	cacheIdleCycles;			// Since the last write
 
 #if HD_LED
 	Disk_Status_e hd_status_next;
@@ -177,11 +209,16 @@ static UINT g_uSlot = 7;
 //===========================================================================
 
 static void HD_SaveLastDiskImage(const int iDrive);
+static bool HD_CacheFlush(HDD* pHDD);
 
 static void HD_CleanupDrive(const int iDrive)
 {
 	if (g_HardDisk[iDrive].imagehandle)
 	{
+		HD_CacheFlush(&g_HardDisk[iDrive]);
+		ZeroMemory(g_HardDisk[iDrive].cache, sizeof(g_HardDisk[iDrive].cache));
+		g_HardDisk[iDrive].cacheLastReadBlock = (UINT)-1;
+
 		ImageClose(g_HardDisk[iDrive].imagehandle);
 		g_HardDisk[iDrive].imagehandle = NULL;
 	}
@@ -318,6 +355,24 @@ void HD_Reset(void)
 {
 	g_HardDisk[HARDDISK_1].hd_error = 0;
 	g_HardDisk[HARDDISK_2].hd_error = 0;
+
+	HD_CacheFlush(&g_HardDisk[HARDDISK_1]);
+	HD_CacheFlush(&g_HardDisk[HARDDISK_2]);
+}
+
+// Write back dirty blocks once the HDD has been idle
+void HD_UpdateDriveState(DWORD cycles)
+{
+	for (UINT i = 0; i < NUM_HARDDISKS; i++)
+	{
+		HDD* pHDD = &g_HardDisk[i];
+		if (!pHDD->cacheDirty)
+			continue;
+
+		pHDD->cacheIdleCycles += cycles;
+		if (pHDD->cacheIdleCycles >= HD_FLUSH_CYCLES)
+			HD_CacheFlush(pHDD);
+	}
 }
 
 //-------------------------------------
@@ -477,6 +532,184 @@ bool HD_IsDriveUnplugged(const int iDrive)
 
 //-----------------------------------------------------------------------------
 
+static HDCacheBlock* HD_CacheFind(HDD* pHDD, const UINT block)
+{
+	for (UINT i = 0; i < HD_CACHE_BLOCKS; i++)
+	{
+		if (pHDD->cache[i].valid && pHDD->cache[i].block == block)
+			return &pHDD->cache[i];
+	}
+
+	return NULL;
+}
+
+static bool HD_CacheCompareBlock(const HDCacheBlock* pA, const HDCacheBlock* pB)
+{
+	return pA->block < pB->block;
+}
+
+static bool HD_CacheFlush(HDD* pHDD)
+{
+	if (!pHDD->cacheDirty)
+		return true;
+
+	std::vector<HDCacheBlock*> dirty;
+	for (UINT i = 0; i < HD_CACHE_BLOCKS; i++)
+	{
+		if (pHDD->cache[i].valid && pHDD->cache[i].dirty)
+			dirty.push_back(&pHDD->cache[i]);
+	}
+
+	std::sort(dirty.begin(), dirty.end(), HD_CacheCompareBlock);
+
+	static BYTE runBuffer[HD_CACHE_BLOCKS * HD_BLOCK_SIZE];
+	bool bRes = true;
+
+	for (UINT first = 0; first < dirty.size(); )
+	{
+		UINT n = 1;
+		while (first+n < dirty.size() && dirty[first+n]->block == dirty[first]->block + n)
+			n++;
+
+		for (UINT i = 0; i < n; i++)
+			memcpy(&runBuffer[i * HD_BLOCK_SIZE], dirty[first+i]->data, HD_BLOCK_SIZE);
+
+		if (ImageWriteBlocks(pHDD->imagehandle, dirty[first]->block, n, runBuffer))
+		{
+			for (UINT i = 0; i < n; i++)
+				dirty[first+i]->dirty = false;
+		}
+		else
+		{
+			// Keep the blocks dirty (ProDOS has already been told they were written), and retry after the next idle period
+			LogFileOutput("HDD: Failed to write back %d block(s) from block %d to: %s\n", n, dirty[first]->block, pHDD->fullname);
+			bRes = false;
+		}
+
+		first += n;
+	}
+
+	pHDD->cacheDirty = !bRes;
+	pHDD->cacheIdleCycles = 0;
+	return bRes;
+}
+
+// Get the least recently used block (writing back the dirty blocks, if it's dirty)
+// . returns NULL if all blocks are dirty and can't be written back
+static HDCacheBlock* HD_CacheAlloc(HDD* pHDD, const UINT block)
+{
+	HDCacheBlock* pVictim = &pHDD->cache[0];
+	for (UINT i = 0; i < HD_CACHE_BLOCKS; i++)
+	{
+		if (!pHDD->cache[i].valid)
+		{
+			pVictim = &pHDD->cache[i];
+			break;
+		}
+
+		if (pHDD->cache[i].lastUsed < pVictim->lastUsed)
+			pVictim = &pHDD->cache[i];
+	}
+
+	if (pVictim->valid && pVictim->dirty)
+		HD_CacheFlush(pHDD);
+
+	if (pVictim->dirty)
+	{
+		// Write-back failed: keep the dirty block, so use the least recently used clean block instead
+		pVictim = NULL;
+		for (UINT i = 0; i < HD_CACHE_BLOCKS; i++)
+		{
+			if (!pHDD->cache[i].dirty && (!pVictim || pHDD->cache[i].lastUsed < pVictim->lastUsed))
+				pVictim = &pHDD->cache[i];
+		}
+
+		if (!pVictim)
+			return NULL;
+	}
+
+	pVictim->block = block;
+	pVictim->valid = true;
+	pVictim->dirty = false;
+	return pVictim;
+}
+
+static bool HD_CacheRead(HDD* pHDD, const UINT block, LPBYTE pBlockBuffer)
+{
+	HDCacheBlock* pBlock = HD_CacheFind(pHDD, block);
+	if (!pBlock)
+	{
+		UINT nBlocks = 1;
+		if (block == pHDD->cacheLastReadBlock + 1)
+		{
+			// Sequential: read ahead, up to the end of the image or the next cached block
+			const UINT uImageBlocks = ImageGetImageSize(pHDD->imagehandle) / HD_BLOCK_SIZE;
+			while (nBlocks < HD_READ_AHEAD_BLOCKS && block+nBlocks < uImageBlocks && !HD_CacheFind(pHDD, block+nBlocks))
+				nBlocks++;
+		}
+
+		static BYTE readBuffer[HD_READ_AHEAD_BLOCKS * HD_BLOCK_SIZE];
+		if (!ImageReadBlocks(pHDD->imagehandle, block, nBlocks, readBuffer))
+		{
+			nBlocks = 1;
+			if (!ImageReadBlocks(pHDD->imagehandle, block, nBlocks, readBuffer))
+				return false;
+		}
+
+		for (UINT i = 0; i < nBlocks; i++)
+		{
+			HDCacheBlock* pNewBlock = HD_CacheAlloc(pHDD, block+i);
+			if (!pNewBlock)
+			{
+				if (i > 0)
+					break;
+
+				// Cache is full of blocks that can't be written back: so just don't cache this block
+				pHDD->cacheLastReadBlock = block;
+				memcpy(pBlockBuffer, readBuffer, HD_BLOCK_SIZE);
+				return true;
+			}
+
+			memcpy(pNewBlock->data, &readBuffer[i * HD_BLOCK_SIZE], HD_BLOCK_SIZE);
+			pNewBlock->lastUsed = ++pHDD->cacheClock;
+			if (i == 0)
+				pBlock = pNewBlock;
+		}
+	}
+
+	pBlock->lastUsed = ++pHDD->cacheClock;
+	pHDD->cacheLastReadBlock = block;
+	memcpy(pBlockBuffer, pBlock->data, HD_BLOCK_SIZE);
+	return true;
+}
+
+static bool HD_CacheWrite(HDD* pHDD, const UINT block, const BYTE* pBlockBuffer)
+{
+	if (ImageIsWriteProtected(pHDD->imagehandle))
+		return false;
+
+	// Extend the image now, so that the write-back can't fail due to the image's size
+	if ((block + 1) * HD_BLOCK_SIZE > ImageGetImageSize(pHDD->imagehandle) && !ImageGrow(pHDD->imagehandle, block + 1))
+		return false;
+
+	HDCacheBlock* pBlock = HD_CacheFind(pHDD, block);
+	if (!pBlock)
+		pBlock = HD_CacheAlloc(pHDD, block);
+
+	if (!pBlock)	// Cache is full of blocks that can't be written back: so write-through (which will most likely fail too)
+		return ImageWriteBlocks(pHDD->imagehandle, block, 1, const_cast<LPBYTE>(pBlockBuffer));
+
+	memcpy(pBlock->data, pBlockBuffer, HD_BLOCK_SIZE);
+	pBlock->dirty = true;
+	pBlock->lastUsed = ++pHDD->cacheClock;
+
+	pHDD->cacheDirty = true;
+	pHDD->cacheIdleCycles = 0;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+
 #define DEVICE_OK				0x00
 #define DEVICE_UNKNOWN_ERROR	0x28
 #define DEVICE_IO_ERROR			0x27
@@ -516,7 +749,7 @@ static BYTE __stdcall HD_IO_EMUL(WORD pc, WORD addr, BYTE bWrite, BYTE d, ULONG
 						case 0x01: //read
 							if ((pHDD->hd_diskblock * HD_BLOCK_SIZE) < ImageGetImageSize(pHDD->imagehandle))
 							{
-								bool bRes = ImageReadBlock(pHDD->imagehandle, pHDD->hd_diskblock, pHDD->hd_buf);
+								bool bRes = HD_CacheRead(pHDD, pHDD->hd_diskblock, pHDD->hd_buf);
 								if (bRes)
 								{
 									pHDD->hd_error = 0;
@@ -540,28 +773,9 @@ static BYTE __stdcall HD_IO_EMUL(WORD pc, WORD addr, BYTE bWrite, BYTE d, ULONG
 #if HD_LED
 								pHDD->hd_status_next = DISK_STATUS_WRITE;
 #endif
-								bool bRes = true;
-								const bool bAppendBlocks = (pHDD->hd_diskblock * HD_BLOCK_SIZE) >= ImageGetImageSize(pHDD->imagehandle);
+								MemReadBlock(pHDD->hd_buf, pHDD->hd_memblock, HD_BLOCK_SIZE);
 
-								if (bAppendBlocks)
-								{
-									ZeroMemory(pHDD->hd_buf, HD_BLOCK_SIZE);
-
-									// Inefficient (especially for gzip/zip files!)
-									UINT uBlock = ImageGetImageSize(pHDD->imagehandle) / HD_BLOCK_SIZE;
-									while (uBlock < pHDD->hd_diskblock)
-									{
-										bRes = ImageWriteBlock(pHDD->imagehandle, uBlock++, pHDD->hd_buf);
-										_ASSERT(bRes);
-										if (!bRes)
-											break;
-									}
-								}
-
-								MoveMemory(pHDD->hd_buf, mem+pHDD->hd_memblock, HD_BLOCK_SIZE);
-
-								if (bRes)
-									bRes = ImageWriteBlock(pHDD->imagehandle, pHDD->hd_diskblock, pHDD->hd_buf);
+								bool bRes = HD_CacheWrite(pHDD, pHDD->hd_diskblock, pHDD->hd_buf);
 
 								if (bRes)
 								{
@@ -750,6 +964,10 @@ void HD_SaveSnapshot(YamlSaveHelper& yamlSaveHelper)
 	if (!HD_CardIsEnabled())
 		return;
 
+	// The save-state only refers to the image files, so they must be up-to-date
+	HD_CacheFlush(&g_HardDisk[HARDDISK_1]);
+	HD_CacheFlush(&g_HardDisk[HARDDISK_2]);
+
 	YamlSaveHelper::Slot slot(yamlSaveHelper, HD_GetSnapshotCardName(), g_uSlot, 1);
 
 	YamlSaveHelper::Label state(yamlSaveHelper, "%s:\n", SS_YAML_KEY_STATE);
@@ -36,6 +36,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 	LPCTSTR HD_GetFullName(const int iDrive);
 	LPCTSTR HD_GetFullPathName(const int iDrive);
 	void HD_Reset(void);
+	void HD_UpdateDriveState(DWORD cycles);
 	void HD_Load_Rom(const LPBYTE pCxRomPeripheral, const UINT uSlot);
 	bool HD_Select(const int iDrive);
 	BOOL HD_Insert(const int iDrive, LPCTSTR pszImageFilename);
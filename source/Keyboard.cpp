@@ -505,6 +505,14 @@ BYTE KeybReadData (void)
 
 //===========================================================================
 
+// No key waiting & no clipboard paste: so reads of $C00x are constant until the next KeybQueueKeypress()
+bool KeybIsIdle (void)
+{
+	return !keywaiting && !g_bPasteFromClipboard && !g_bClipboardActive;
+}
+
+//===========================================================================
+
 BYTE KeybReadFlag (void)
 {
 	if (g_bPasteFromClipboard)
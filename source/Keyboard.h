@@ -19,5 +19,6 @@ void    KeybToggleP8ACapsLock ();
 void    KeybAnyKeyDown(UINT message, WPARAM wparam, bool bIsExtended);
 BYTE    KeybReadData (void);
 BYTE    KeybReadFlag (void);
+bool    KeybIsIdle (void);
 void    KeybSaveSnapshot(class YamlSaveHelper& yamlSaveHelper);
 void    KeybLoadSnapshot(class YamlLoadHelper& yamlLoadHelper, UINT version);
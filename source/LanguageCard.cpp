@@ -279,6 +279,8 @@ BYTE __stdcall Saturn128K::IO(WORD PC, WORD uAddr, BYTE bWrite, BYTE uValue, ULO
 
 	if (uAddr & (1<<2))
 	{
+		const UINT uLastSaturnActiveBank = pLC->m_uSaturnActiveBank;
+
 		pLC->m_uSaturnActiveBank = 0 // Saturn 128K Language Card Bank 0 .. 7
 			| (uAddr >> 1) & 4
 			| (uAddr >> 0) & 3;
@@ -288,12 +290,12 @@ BYTE __stdcall Saturn128K::IO(WORD PC, WORD uAddr, BYTE bWrite, BYTE uValue, ULO
 			// EG. Run RAMTEST128K tests on a Saturn 64K card
 			// TODO: Saturn::UpdatePaging() should deal with this case:
 			// . Technically read floating-bus, write to nothing
-			// . But the mem cache doesn't support floating-bus reads from non-I/O space
+			// . But memread[] doesn't support floating-bus reads from non-I/O space
 			pLC->m_uSaturnActiveBank = pLC->m_uSaturnTotalBanks-1;	// FIXME: just prevent crash for now!
 		}
 
 		SetMemMainLanguageCard( pLC->m_aSaturnBanks[ pLC->m_uSaturnActiveBank ] );
-		bBankChanged = true;
+		bBankChanged = (pLC->m_uSaturnActiveBank != uLastSaturnActiveBank);	// NB. Re-selecting the active bank is a no-op
 	}
 	else
 	{
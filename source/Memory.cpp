@@ -138,59 +138,39 @@ SOFT SWITCH STATUS FLAGS
 // Notes
 // -----
 //
-// memimage
-// - 64KB
-//
-// mem
-// (a pointer to memimage 64KB)
-// - a 64KB r/w memory cache
-// - reflects the current readable memory in the 6502's 64K address space
-//		. excludes $Cxxx I/O memory
-//		. could be a mix of RAM/ROM, main/aux, etc
-// - may also reflect the current writeable memory (on a 256-page granularity) if the write page addr == read page addr
-//		. for this case, the memdirty flag(s) are valid
-//		. when writes instead occur to backing-store, then memdirty flag(s) can be ignored
-//
 // memmain, memaux
 // - physical contiguous 64KB "backing-store" for main & aux respectively
 // - NB. 4K bank1 BSR is at $C000-$CFFF
 //
+// memread
+// - 1 pointer entry per 256-byte page
+// - used to read from a page: points directly to the page's current backing-store (RAM, ROM or $Cxxx firmware)
+//		. could be a mix of RAM/ROM, main/aux, etc
+//		. EG: if ALTZP=1, then:
+//			. memread[0] = &memaux[0x0000]
+//			. memread[1] = &memaux[0x0100]
+// - $Cxxx: the 6502 reads via IORead[], but IO_Cxxx() then reads the firmware via memread
+//
 // memwrite
 // - 1 pointer entry per 256-byte page
-// - used to write to a page
-// - if RD & WR point to the same 256-byte RAM page, then memwrite will point to the page in 'mem'
+// - used to write to a page: points directly to the page's current backing-store (or NULL for ROM & I/O)
+// - if RD & WR are the same 256-byte RAM page, then memwrite == memread
 //		. ie. when SW_AUXREAD==SW_AUXWRITE, or 4K-BSR is r/w, or 8K BSR is r/w, or SW_80STORE=1
-//		. So 'mem' remains correct for both r&w operations, but the physical 64K mem block becomes stale
-// - if RD & WR point to different 256-byte pages, then memwrite will point to the page in the physical 64K mem block
-//		. writes will still set the dirty flag (but can be ignored)
-//		. UpdatePaging() ignores this, as it only copies back to the physical 64K mem block when memshadow changes (for that 256-byte page)
+//
+// NB. Since there's no 64K memory cache, switching banks (UpdatePaging) just updates these pointers - no memory is copied.
 //
 // memdirty
 // - 1 byte entry per 256-byte page
-// - set when a write occurs to a 256-byte page
-// - indicates that 'mem' (ie. the cache) is out-of-sync with the "physical" 64K backing-store memory
-// - NB. a page's dirty flag is only useful(valid) when 'mem' is used for both read & write for the corresponding page
-//   When they differ, then writes go directly to the backing-store.
-//   . In this case, the dirty flag will just force a memcpy() to the same address in backing-store.
-//
-// memshadow
-// - 1 pointer entry per 256-byte page
-// - reflects how 'mem' is setup for read operations (at a 256-byte granularity)
-//		. EG: if ALTZP=1, then:
-//			. mem will have copies of memaux's ZP & stack
-//			. memshadow[0] = &memaux[0x0000]
-//			. memshadow[1] = &memaux[0x0100]
+// - set when a write occurs to a 256-byte page (see also MEMDIRTY_PREDECODE)
 //
 
-static LPBYTE  memshadow[0x100];
+LPBYTE         memread[0x100];
 LPBYTE         memwrite[0x100];
 
 iofunction		IORead[256];
 iofunction		IOWrite[256];
 static LPVOID	SlotParameters[NUM_SLOTS];
 
-LPBYTE         mem          = NULL;
-
 //
 
 static LPBYTE  memaux       = NULL;
@@ -199,8 +179,6 @@ static LPBYTE  memmain      = NULL;
 LPBYTE         memdirty     = NULL;
 static LPBYTE  memrom       = NULL;
 
-static LPBYTE  memimage     = NULL;
-
 static LPBYTE	pCxRomInternal		= NULL;
 static LPBYTE	pCxRomPeripheral	= NULL;
 
@@ -733,6 +711,18 @@ static bool IsCardInSlot(const UINT uSlot);
 // . Reset: On access to $CFFF or an MMU reset
 //
 
+// Map [$C800..$CFFF] to the peripheral or internal expansion ROM
+// . Called by UpdatePaging(), and by IO_Cxxx() which only needs to update these pages
+static void UpdatePagingExpansionRom(void)
+{
+	for (UINT loop = 0xC8; loop < 0xD0; loop++)
+	{
+		const UINT uRomOffset = (loop & 0x0f) * 0x100;
+		memread[loop] = (!SW_INTCXROM && !INTC8ROM)	? pCxRomPeripheral+uRomOffset			// C800..CFFF - Peripheral ROM (GH#486)
+													: pCxRomInternal+uRomOffset;			// C800..CFFF - Internal ROM
+	}
+}
+
 static BYTE __stdcall IO_Cxxx(WORD programcounter, WORD address, BYTE write, BYTE value, ULONG nExecutedCycles)
 {
 	if (address == 0xCFFF)
@@ -747,7 +737,7 @@ static BYTE __stdcall IO_Cxxx(WORD programcounter, WORD address, BYTE write, BYT
 		{
 			// NB. SW_INTCXROM==1 ensures that internal rom stays switched in
 			memset(pCxRomPeripheral+0x800, 0, FIRMWARE_EXPANSION_SIZE);
-			memset(mem+FIRMWARE_EXPANSION_BEGIN, 0, FIRMWARE_EXPANSION_SIZE);
+			UpdatePagingExpansionRom();
 			g_eExpansionRomType = eExpRomNull;
 		}
 
@@ -802,7 +792,7 @@ static BYTE __stdcall IO_Cxxx(WORD programcounter, WORD address, BYTE write, BYT
 			if (ExpansionRom[uSlot] && (g_uPeripheralRomSlot != uSlot))
 			{
 				memcpy(pCxRomPeripheral+0x800, ExpansionRom[uSlot], FIRMWARE_EXPANSION_SIZE);
-				memcpy(mem+FIRMWARE_EXPANSION_BEGIN, ExpansionRom[uSlot], FIRMWARE_EXPANSION_SIZE);
+				UpdatePagingExpansionRom();
 				g_eExpansionRomType = eExpRomPeripheral;
 				g_uPeripheralRomSlot = uSlot;
 			}
@@ -811,7 +801,7 @@ static BYTE __stdcall IO_Cxxx(WORD programcounter, WORD address, BYTE write, BYT
 		{
 			// Enable Internal ROM
 			// . Get this for PR#3
-			memcpy(mem+FIRMWARE_EXPANSION_BEGIN, pCxRomInternal+0x800, FIRMWARE_EXPANSION_SIZE);
+			UpdatePagingExpansionRom();
 			g_eExpansionRomType = eExpRomInternal;
 			g_uPeripheralRomSlot = 0;
 		}
@@ -851,7 +841,7 @@ static BYTE __stdcall IO_Cxxx(WORD programcounter, WORD address, BYTE write, BYT
 		if (INTC8ROM && (g_eExpansionRomType != eExpRomInternal))
 		{
 			// Enable Internal ROM
-			memcpy(mem+FIRMWARE_EXPANSION_BEGIN, pCxRomInternal+0x800, FIRMWARE_EXPANSION_SIZE);
+			UpdatePagingExpansionRom();
 			g_eExpansionRomType = eExpRomInternal;
 			g_uPeripheralRomSlot = 0;
 		}
@@ -875,7 +865,7 @@ static BYTE __stdcall IO_Cxxx(WORD programcounter, WORD address, BYTE write, BYT
 	if ((g_eExpansionRomType == eExpRomNull) && (address >= FIRMWARE_EXPANSION_BEGIN))
 		return IO_Null(programcounter, address, write, value, nExecutedCycles);
 
-	return mem[address];
+	return *(memread[address >> 8]+(address & 0xFF));
 }
 
 //===========================================================================
@@ -1067,122 +1057,89 @@ static void UpdatePaging(BOOL initialize)
 {
 	modechanging = 0;
 
-	// SAVE THE CURRENT PAGING SHADOW TABLE
-	LPBYTE oldshadow[256];
+	// SAVE THE CURRENT READ TABLE
+	LPBYTE oldread[256];
 	if (!initialize)
-		CopyMemory(oldshadow,memshadow,256*sizeof(LPBYTE));
+		CopyMemory(oldread,memread,256*sizeof(LPBYTE));
 
 	// UPDATE THE PAGING TABLES BASED ON THE NEW PAGING SWITCH VALUES
 	UINT loop;
-	if (initialize)
+	for (loop = 0x00; loop < 0x02; loop++)
 	{
-		for (loop = 0x00; loop < 0xC0; loop++)
-			memwrite[loop] = mem+(loop << 8);
-
-		for (loop = 0xC0; loop < 0xD0; loop++)
-			memwrite[loop] = NULL;
+		memread[loop]  = SW_ALTZP ? memaux+(loop << 8) : memmain+(loop << 8);
+		memwrite[loop] = memread[loop];
 	}
 
-	for (loop = 0x00; loop < 0x02; loop++)
-		memshadow[loop] = SW_ALTZP ? memaux+(loop << 8) : memmain+(loop << 8);
-
 	for (loop = 0x02; loop < 0xC0; loop++)
 	{
-		memshadow[loop] = SW_AUXREAD ? memaux+(loop << 8)
-			: memmain+(loop << 8);
+		memread[loop]  = SW_AUXREAD  ? memaux+(loop << 8)
+									 : memmain+(loop << 8);
 
-		memwrite[loop]  = ((SW_AUXREAD != 0) == (SW_AUXWRITE != 0))
-			? mem+(loop << 8)
-			: SW_AUXWRITE	? memaux+(loop << 8)
-							: memmain+(loop << 8);
+		memwrite[loop] = SW_AUXWRITE ? memaux+(loop << 8)
+									 : memmain+(loop << 8);
 	}
 
 	for (loop = 0xC0; loop < 0xC8; loop++)
 	{
-		memdirty[loop] = 0;	// mem(cache) can't be dirty for ROM (but STA $Csnn will set the dirty flag)
 		const UINT uSlotOffset = (loop & 0x0f) * 0x100;
 		if (loop == 0xC3)
-			memshadow[loop] = (SW_SLOTC3ROM && !SW_INTCXROM)	? pCxRomPeripheral+uSlotOffset	// C300..C3FF - Slot 3 ROM (all 0x00's)
-																: pCxRomInternal+uSlotOffset;	// C300..C3FF - Internal ROM
+			memread[loop] = (SW_SLOTC3ROM && !SW_INTCXROM)	? pCxRomPeripheral+uSlotOffset	// C300..C3FF - Slot 3 ROM (all 0x00's)
+															: pCxRomInternal+uSlotOffset;	// C300..C3FF - Internal ROM
 		else
-			memshadow[loop] = !SW_INTCXROM	? pCxRomPeripheral+uSlotOffset						// C000..C7FF - SSC/Disk][/etc
+			memread[loop] = !SW_INTCXROM	? pCxRomPeripheral+uSlotOffset						// C000..C7FF - SSC/Disk][/etc
 											: pCxRomInternal+uSlotOffset;						// C000..C7FF - Internal ROM
+		memwrite[loop] = NULL;
 	}
 
+	UpdatePagingExpansionRom();
+
 	for (loop = 0xC8; loop < 0xD0; loop++)
-	{
-		memdirty[loop] = 0;	// mem(cache) can't be dirty for ROM (but STA $Cnnn will set the dirty flag)
-		const UINT uRomOffset = (loop & 0x0f) * 0x100;
-		memshadow[loop] = (!SW_INTCXROM && !INTC8ROM)	? pCxRomPeripheral+uRomOffset			// C800..CFFF - Peripheral ROM (GH#486)
-														: pCxRomInternal+uRomOffset;			// C800..CFFF - Internal ROM
-	}
+		memwrite[loop] = NULL;
 
 	for (loop = 0xD0; loop < 0xE0; loop++)
 	{
 		int bankoffset = (SW_BANK2 ? 0 : 0x1000);
-		memshadow[loop] = SW_HIGHRAM ? SW_ALTZP	? memaux+(loop << 8)-bankoffset
-												: g_pMemMainLanguageCard+((loop-0xC0)<<8)-bankoffset
-									 : memrom+((loop-0xD0) * 0x100);
+		LPBYTE pRAM = SW_ALTZP	? memaux+(loop << 8)-bankoffset
+								: g_pMemMainLanguageCard+((loop-0xC0)<<8)-bankoffset;
 
-		memwrite[loop]  = SW_WRITERAM	? SW_HIGHRAM	? mem+(loop << 8)
-														: SW_ALTZP	? memaux+(loop << 8)-bankoffset
-																	: g_pMemMainLanguageCard+((loop-0xC0)<<8)-bankoffset
-										: NULL;
+		memread[loop]  = SW_HIGHRAM  ? pRAM : memrom+((loop-0xD0) * 0x100);
+		memwrite[loop] = SW_WRITERAM ? pRAM : NULL;
 	}
 
 	for (loop = 0xE0; loop < 0x100; loop++)
 	{
-		memshadow[loop] = SW_HIGHRAM	? SW_ALTZP	? memaux+(loop << 8)
-													: g_pMemMainLanguageCard+((loop-0xC0)<<8)
-										: memrom+((loop-0xD0) * 0x100);
+		LPBYTE pRAM = SW_ALTZP	? memaux+(loop << 8)
+								: g_pMemMainLanguageCard+((loop-0xC0)<<8);
 
-		memwrite[loop]  = SW_WRITERAM	? SW_HIGHRAM	? mem+(loop << 8)
-														: SW_ALTZP	? memaux+(loop << 8)
-																	: g_pMemMainLanguageCard+((loop-0xC0)<<8)
-										: NULL;
+		memread[loop]  = SW_HIGHRAM  ? pRAM : memrom+((loop-0xD0) * 0x100);
+		memwrite[loop] = SW_WRITERAM ? pRAM : NULL;
 	}
 
 	if (SW_80STORE)
 	{
 		for (loop = 0x04; loop < 0x08; loop++)
 		{
-			memshadow[loop] = SW_PAGE2	? memaux+(loop << 8)
+			memread[loop]  = SW_PAGE2	? memaux+(loop << 8)
 										: memmain+(loop << 8);
-			memwrite[loop]  = mem+(loop << 8);
+			memwrite[loop] = memread[loop];
 		}
 
 		if (SW_HIRES)
 		{
 			for (loop = 0x20; loop < 0x40; loop++)
 			{
-				memshadow[loop] = SW_PAGE2	? memaux+(loop << 8)
+				memread[loop]  = SW_PAGE2	? memaux+(loop << 8)
 											: memmain+(loop << 8);
-				memwrite[loop]  = mem+(loop << 8);
+				memwrite[loop] = memread[loop];
 			}
 		}
 	}
 
-	// MOVE MEMORY BACK AND FORTH AS NECESSARY BETWEEN THE SHADOW AREAS AND
-	// THE MAIN RAM IMAGE TO KEEP BOTH SETS OF MEMORY CONSISTENT WITH THE NEW
-	// PAGING SHADOW TABLE
-	//
-	// NB. the condition 'loop <= 1' is there because:
-	// . Page0 (ZP)    : memdirty[0] is set when the 6502 CPU does a ZP-write, but perhaps older versions didn't set this flag (eg. the asm version?).
-	// . Page1 (stack) : memdirty[1] is NOT set when the 6502 CPU writes to this page with JSR, etc.
-
+	// Pages now read from a different backing-store: the pre-decoded CPU core must discard its records for these pages
 	for (loop = 0x00; loop < 0x100; loop++)
 	{
-		if (initialize || (oldshadow[loop] != memshadow[loop]))
-		{
-			if (!initialize &&
-				((*(memdirty+loop) & 1) || (loop <= 1)))
-			{
-				*(memdirty+loop) &= ~1;
-				CopyMemory(oldshadow[loop],mem+(loop << 8),256);
-			}
-
-			CopyMemory(mem+(loop << 8),memshadow[loop],256);
-		}
+		if (initialize || (oldread[loop] != memread[loop]))
+			*(memdirty+loop) |= MEMDIRTY_PREDECODE;
 	}
 }
 
@@ -1198,7 +1155,6 @@ void MemDestroy()
 	VirtualFree(memmain ,0,MEM_RELEASE);
 	VirtualFree(memdirty,0,MEM_RELEASE);
 	VirtualFree(memrom  ,0,MEM_RELEASE);
-	VirtualFree(memimage,0,MEM_RELEASE);
 
 	VirtualFree(pCxRomInternal,0,MEM_RELEASE);
 	VirtualFree(pCxRomPeripheral,0,MEM_RELEASE);
@@ -1222,15 +1178,12 @@ void MemDestroy()
 	memmain  = NULL;
 	memdirty = NULL;
 	memrom   = NULL;
-	memimage = NULL;
 
 	pCxRomInternal		= NULL;
 	pCxRomPeripheral	= NULL;
 
-	mem      = NULL;
-
+	ZeroMemory(memread, sizeof(memread));
 	ZeroMemory(memwrite, sizeof(memwrite));
-	ZeroMemory(memshadow,sizeof(memshadow));
 }
 
 //===========================================================================
@@ -1247,42 +1200,13 @@ bool MemCheckINTCXROM()
 
 //===========================================================================
 
-static void BackMainImage(void)
-{
-	for (UINT loop = 0; loop < 256; loop++)
-	{
-		if (memshadow[loop] && ((*(memdirty+loop) & 1) || (loop <= 1)))
-			CopyMemory(memshadow[loop], mem+(loop << 8), 256);
-
-		*(memdirty+loop) &= ~1;
-	}
-}
-
-//===========================================================================
-
-static LPBYTE MemGetPtrBANK1(const WORD offset, const LPBYTE pMemBase)
-{
-	if ((offset & 0xF000) != 0xC000)	// Requesting RAM at physical addr $Cxxx (ie. 4K RAM BANK1)
-		return NULL;
-
-	// NB. This works for memaux when set to any RWpages[] value, ie. RamWork III "just works"
-	const BYTE bank1page = (offset >> 8) & 0xF;
-	return (memshadow[0xD0+bank1page] == pMemBase+(0xC0+bank1page)*256)
-		? mem+offset+0x1000				// Return ptr to $Dxxx address - 'mem' has (a potentially dirty) 4K RAM BANK1 mapped in at $D000
-		: pMemBase+offset;				// Else return ptr to $Cxxx address
-}
-
-//-------------------------------------
+// NB. There's no 64K mem(cache), so the backing-store is always up-to-date (see memread & memwrite)
+// . offset [$C000..$CFFF] is the 4K RAM BANK1
+// . this works for memaux when set to any RWpages[] value, ie. RamWork III "just works"
 
 LPBYTE MemGetAuxPtr(const WORD offset)
 {
-	LPBYTE lpMem = MemGetPtrBANK1(offset, memaux);
-	if (lpMem)
-		return lpMem;
-
-	lpMem = (memshadow[(offset >> 8)] == (memaux+(offset & 0xFF00)))
-			? mem+offset				// Return 'mem' copy if possible, as page could be dirty
-			: memaux+offset;
+	LPBYTE lpMem = memaux+offset;
 
 #ifdef RAMWORKS
 	// Video scanner (for 14M video modes) always fetches from 1st 64K aux bank (UTAIIe ref?)
@@ -1293,9 +1217,7 @@ LPBYTE MemGetAuxPtr(const WORD offset)
 			)
 		)
 	{
-		lpMem = (memshadow[(offset >> 8)] == (RWpages[0]+(offset & 0xFF00)))
-			? mem+offset
-			: RWpages[0]+offset;
+		lpMem = RWpages[0]+offset;
 	}
 #endif
 
@@ -1304,43 +1226,57 @@ LPBYTE MemGetAuxPtr(const WORD offset)
 
 //-------------------------------------
 
-// if memshadow == memmain
-//	  so RD memmain
-//	  case: RD == WR
-//		so RD(mem),WR(mem)
-//		so 64K memmain could be incorrect
-//		*therefore mem is correct
-//	  case: RD != WR
-//		so RD(mem),WR(memaux)
-//		doesn't matter since RD != WR, then it's guaranteed that memaux is correct
-//		*therefore either mem or memmain is correct
-// else ; memshadow != memmain
-//	  so RD memaux (or ROM)
-//	  case: RD == WR
-//		so RD(mem),WR(mem)
-//		so 64K memaux could be incorrect
-//		*therefore memmain is correct
-//	  case: RD != WR
-//		so RD(mem),WR(memmain)
-//		doesn't matter since RD != WR, then it's guaranteed that memmain is correct
-//		*therefore memmain is correct
-//
-// *OR*
-//
-// Is the mem(cache) setup to read (via memshadow) from memmain?
-// . if yes, then return the mem(cache) address as writes (via memwrite) may've made the mem(cache) dirty.
-// . if no, then return memmain, as the mem(cache) isn't involved in memmain (any writes will go directly to this backing-store).
-//
-
 LPBYTE MemGetMainPtr(const WORD offset)
 {
-	LPBYTE lpMem = MemGetPtrBANK1(offset, memmain);
-	if (lpMem)
-		return lpMem;
+	return memmain+offset;
+}
+
+//-------------------------------------
+
+// CPU's view of memory (ie. as currently paged in by the soft-switches)
+// . NB. No I/O side-effects: [$C000..$CFFF] is just the firmware (ROM)
+// . Used by the debugger & peripherals (instead of a 64K mem(cache)) - NB. read-only: to write use MemGetWritePtr()
+LPBYTE MemGetReadPtr(const WORD addr)
+{
+	return memread[addr >> 8]+(addr & 0xFF);
+}
+
+// CPU's view of memory for writing (ie. as currently paged in by the soft-switches)
+// . NULL if the page isn't writable: ROM (incl. $D000..$FFFF when LC RAM is write-protected) or [$C000..$CFFF]
+// . Marks the page as modified in memdirty[] (as a CPU write does), so the pre-decoded CPU core & NTSC video see the change
+LPBYTE MemGetWritePtr(const WORD addr)
+{
+	LPBYTE pPage = memwrite[addr >> 8];
+	if (!pPage)
+		return NULL;
 
-	return (memshadow[(offset >> 8)] == (memmain+(offset & 0xFF00)))
-			? mem+offset				// Return 'mem' copy if possible, as page could be dirty
-			: memmain+offset;
+	memdirty[addr >> 8] = 0xFF;
+	return pPage+(addr & 0xFF);
+}
+
+void MemWriteByte(const WORD addr, const BYTE value)
+{
+	LPBYTE pDst = MemGetWritePtr(addr);
+	if (pDst)
+		*pDst = value;
+}
+
+WORD MemReadWord(const WORD addr)
+{
+	return *MemGetReadPtr(addr) | (*MemGetReadPtr(addr+1) << 8);
+}
+
+// Copy a block to/from the CPU's view of memory (a block may span differently paged-in pages)
+void MemReadBlock(LPBYTE pDst, const WORD addr, const UINT length)
+{
+	for (UINT i = 0; i < length; i++)
+		pDst[i] = *MemGetReadPtr(addr+i);
+}
+
+void MemWriteBlock(const WORD addr, const BYTE* pSrc, const UINT length)
+{
+	for (UINT i = 0; i < length; i++)
+		MemWriteByte(addr+i, pSrc[i]);
 }
 
 //===========================================================================
@@ -1350,8 +1286,6 @@ LPBYTE MemGetMainPtr(const WORD offset)
 // . Debugger : CmdMemorySave(), CmdMemoryLoad()
 LPBYTE MemGetBankPtr(const UINT nBank)
 {
-	BackMainImage();	// Flush any dirty pages to back-buffer
-
 #ifdef RAMWORKS
 	if (nBank > g_uMaxExPages)
 		return NULL;
@@ -1427,15 +1361,13 @@ void MemInitialize()
 	memmain  = (LPBYTE)VirtualAlloc(NULL,_6502_MEM_END+1,MEM_COMMIT,PAGE_READWRITE);
 	memdirty = (LPBYTE)VirtualAlloc(NULL,0x100  ,MEM_COMMIT,PAGE_READWRITE);
 	memrom   = (LPBYTE)VirtualAlloc(NULL,0x5000 ,MEM_COMMIT,PAGE_READWRITE);
-	memimage = (LPBYTE)VirtualAlloc(NULL,_6502_MEM_END+1,MEM_RESERVE,PAGE_NOACCESS);
 
 	pCxRomInternal		= (LPBYTE) VirtualAlloc(NULL, CxRomSize, MEM_COMMIT, PAGE_READWRITE);
 	pCxRomPeripheral	= (LPBYTE) VirtualAlloc(NULL, CxRomSize, MEM_COMMIT, PAGE_READWRITE);
 
-	if (!memaux || !memdirty || !memimage || !memmain || !memrom || !pCxRomInternal || !pCxRomPeripheral)
+	if (!memaux || !memdirty || !memmain || !memrom || !pCxRomInternal || !pCxRomPeripheral)
 	{
-		MessageBox(
-			GetDesktopWindow(),
+		FrameMessageBox(
 			TEXT("The emulator was unable to allocate the memory it ")
 			TEXT("requires.  Further execution is not possible."),
 			g_pAppTitle,
@@ -1443,23 +1375,6 @@ void MemInitialize()
 		ExitProcess(1);
 	}
 
-	LPVOID newloc = VirtualAlloc(memimage,_6502_MEM_END+1,MEM_COMMIT,PAGE_READWRITE);
-	if (newloc != memimage)
-		MessageBox(
-			GetDesktopWindow(),
-			TEXT("The emulator has detected a bug in your operating ")
-			TEXT("system.  While changing the attributes of a memory ")
-			TEXT("object, the operating system also changed its ")
-			TEXT("location."),
-			g_pAppTitle,
-			MB_ICONEXCLAMATION | MB_SETFOREGROUND);
-
-	// memimage has been freed
-	// if we have come here we should use newloc
-	//
-	// this happens when running under valgrind
-	memimage = (LPBYTE)newloc;
-
 	//
 
 	RWpages[0] = memaux;
@@ -1532,8 +1447,7 @@ void MemInitializeROM(void)
 
 		LogFileOutput("%s\n", sText);
 
-		MessageBox(
-			GetDesktopWindow(),
+		FrameMessageBox(
 			sText,
 			g_pAppTitle,
 			MB_ICONSTOP | MB_SETFOREGROUND);
@@ -1596,7 +1510,7 @@ void MemInitializeCustomF8ROM(void)
 		}
 		catch (bool)
 		{
-			MessageBox( g_hFrameWindow, "Failed to read F8 (auto-start) ROM for language card in original Apple][", TEXT("AppleWin Error"), MB_OK );
+			FrameMessageBox( "Failed to read F8 (auto-start) ROM for language card in original Apple][", TEXT("AppleWin Error"), MB_OK );
 		}
 	}
 
@@ -1618,7 +1532,7 @@ void MemInitializeCustomF8ROM(void)
 
 		if (!bRes)
 		{
-			MessageBox( g_hFrameWindow, "Failed to read custom F8 rom", TEXT("AppleWin Error"), MB_OK );
+			FrameMessageBox( "Failed to read custom F8 rom", TEXT("AppleWin Error"), MB_OK );
 			CloseHandle(g_hCustomRomF8);
 			g_hCustomRomF8 = INVALID_HANDLE_VALUE;
 			// Failed, so use default rom...
@@ -1715,7 +1629,7 @@ void MemInitializeCardExpansionRomFromSnapshot(void)
 	_ASSERT(g_eExpansionRomType == eExpRomPeripheral);
 
 	memcpy(pCxRomPeripheral+0x800, ExpansionRom[uSlot], FIRMWARE_EXPANSION_SIZE);
-	// NB. Copied to /mem/ by UpdatePaging(TRUE)
+	// NB. Mapped into memread[] by UpdatePaging(TRUE)
 }
 
 inline DWORD getRandomTime()
@@ -1732,7 +1646,7 @@ inline DWORD getRandomTime()
 void MemReset()
 {
 	// INITIALIZE THE PAGING TABLES
-	ZeroMemory(memshadow,256*sizeof(LPBYTE));
+	ZeroMemory(memread  ,256*sizeof(LPBYTE));
 	ZeroMemory(memwrite ,256*sizeof(LPBYTE));
 
 	// INITIALIZE THE RAM IMAGES
@@ -1746,6 +1660,7 @@ void MemReset()
 	g_uPeripheralRomSlot = 0;
 
 	ZeroMemory(memdirty, 0x100);
+	NTSC_VideoInvalidateScanlines();
 
 	//
 
@@ -1869,14 +1784,11 @@ void MemReset()
 	memmain[ 0xBFFE ] = 0;
 	memmain[ 0xBFFF ] = 0;
 
-	// SET UP THE MEMORY IMAGE
-	mem = memimage;
-
-	// INITIALIZE PAGING, FILLING IN THE 64K MEMORY IMAGE
+	// INITIALIZE PAGING
 	ResetPaging(1);		// Initialize=1
 
 	// INITIALIZE & RESET THE CPU
-	// . Do this after ROM has been copied back to mem[], so that PC is correctly init'ed from 6502's reset vector
+	// . Do this after ROM has been mapped into memread[], so that PC is correctly init'ed from 6502's reset vector
 	CpuInitialize();
 	//Sets Caps Lock = false (Pravets 8A/C only)
 
@@ -1887,7 +1799,7 @@ void MemReset()
 
 BYTE MemReadFloatingBus(const ULONG uExecutedCycles)
 {
-	return mem[ NTSC_VideoGetScannerAddress(uExecutedCycles) ];		// OK: This does the 2-cycle adjust for ANSI STORY (End Credits)
+	return *MemGetReadPtr( NTSC_VideoGetScannerAddress(uExecutedCycles) );		// OK: This does the 2-cycle adjust for ANSI STORY (End Credits)
 }
 
 //===========================================================================
@@ -1964,11 +1876,12 @@ BYTE __stdcall MemSetPaging(WORD programcounter, WORD address, BYTE write, BYTE
 #ifdef RAMWORKS
 			case 0x71: // extended memory aux page number
 			case 0x73: // Ramworks III set aux page number
-				if ((value < g_uMaxExPages) && RWpages[value])
+				if ((value < g_uMaxExPages) && RWpages[value] && (value != g_uActiveBank))	// NB. Re-selecting the active bank is a no-op
 				{
 					g_uActiveBank = value;
 					memaux = RWpages[g_uActiveBank];
 					UpdatePaging(FALSE);	// Initialize=FALSE
+					NTSC_VideoInvalidateScanlines();	// Video scanner may fetch from the new aux bank
 				}
 				break;
 #endif
@@ -1993,7 +1906,6 @@ BYTE __stdcall MemSetPaging(WORD programcounter, WORD address, BYTE write, BYTE
 					// . Similar to $CFFF access
 					// . None of the peripheral cards can be driving the bus - so use the null ROM
 					memset(pCxRomPeripheral+0x800, 0, FIRMWARE_EXPANSION_SIZE);
-					memset(mem+FIRMWARE_EXPANSION_BEGIN, 0, FIRMWARE_EXPANSION_SIZE);
 					g_eExpansionRomType = eExpRomNull;
 					g_uPeripheralRomSlot = 0;
 				}
@@ -2002,7 +1914,7 @@ BYTE __stdcall MemSetPaging(WORD programcounter, WORD address, BYTE write, BYTE
 			else
 			{
 				// Enable Internal ROM
-				memcpy(mem+0xC800, pCxRomInternal+0x800, FIRMWARE_EXPANSION_SIZE);
+				// . [$C800..$CFFF] is re-mapped by UpdatePaging()
 				g_eExpansionRomType = eExpRomInternal;
 				g_uPeripheralRomSlot = 0;
 				IoHandlerCardsOut();
@@ -2025,6 +1937,10 @@ bool MemOptimizeForModeChanging(WORD programcounter, WORD address)
 {
 	if (IS_APPLE2E())
 	{
+		const DWORD uNextOpcodes = (DWORD)*MemGetReadPtr(programcounter)
+								| ((DWORD)*MemGetReadPtr(programcounter+1) << 8)
+								| ((DWORD)*MemGetReadPtr(programcounter+2) << 16);
+
 		// IF THE EMULATED PROGRAM HAS JUST UPDATED THE MEMORY WRITE MODE AND IS
 		// ABOUT TO UPDATE THE MEMORY READ MODE, HOLD OFF ON ANY PROCESSING UNTIL
 		// IT DOES SO.
@@ -2032,15 +1948,15 @@ bool MemOptimizeForModeChanging(WORD programcounter, WORD address)
 		// NB. A 6502 interrupt occurring between these memory write & read updates could lead to incorrect behaviour.
 		// - although any data-race is probably a bug in the 6502 code too.
 		if ((address >= 4) && (address <= 5) &&									// Now:  RAMWRTOFF or RAMWRTON
-			((*(LPDWORD)(mem+programcounter) & 0x00FFFEFF) == 0x00C0028D))		// Next: STA $C002(RAMRDOFF) or STA $C003(RAMRDON)
+			((uNextOpcodes & 0x00FFFEFF) == 0x00C0028D))		// Next: STA $C002(RAMRDOFF) or STA $C003(RAMRDON)
 		{
 				modechanging = 1;
 				return true;
 		}
 
 		if ((address >= 0x80) && (address <= 0x8F) && (programcounter < 0xC000) &&	// Now: LC
-			(((*(LPDWORD)(mem+programcounter) & 0x00FFFEFF) == 0x00C0048D) ||		// Next: STA $C004(RAMWRTOFF) or STA $C005(RAMWRTON)
-			 ((*(LPDWORD)(mem+programcounter) & 0x00FFFEFF) == 0x00C0028D)))		//    or STA $C002(RAMRDOFF)  or STA $C003(RAMRDON)
+			(((uNextOpcodes & 0x00FFFEFF) == 0x00C0048D) ||		// Next: STA $C004(RAMWRTOFF) or STA $C005(RAMWRTON)
+			 ((uNextOpcodes & 0x00FFFEFF) == 0x00C0028D)))		//    or STA $C002(RAMRDOFF)  or STA $C003(RAMRDON)
 		{
 				modechanging = 1;
 				return true;
@@ -2052,6 +1968,55 @@ bool MemOptimizeForModeChanging(WORD programcounter, WORD address)
 
 //===========================================================================
 
+// Bank-switch microbenchmark: returns the number of bank switches per second
+// . RamWorks III (with 2+ aux banks): alternate between aux banks 0 & 1 (ie. as $C073 does)
+// . //e: toggle RAMRD & RAMWRT (ie. as $C002..$C005 do)
+// . ][/][+: toggle the LC's BANK1/BANK2 (ie. as $C08x does)
+DWORD MemBenchmarkBankSwitch(const UINT uNumSwitches)
+{
+	const DWORD uOldMemMode = memmode;
+#ifdef RAMWORKS
+	const UINT uOldActiveBank = g_uActiveBank;
+	const bool bRamWorks = (g_uMaxExPages > 1) && RWpages[1];
+#endif
+
+	DWORD milliseconds = GetTickCount();
+	while (GetTickCount() == milliseconds) ;
+	milliseconds = GetTickCount();
+
+	for (UINT i = 0; i < uNumSwitches; i++)
+	{
+#ifdef RAMWORKS
+		if (bRamWorks)
+		{
+			g_uActiveBank = i & 1;
+			memaux = RWpages[g_uActiveBank];
+		}
+		else
+#endif
+		{
+			SetMemMode(memmode ^ (IS_APPLE2 ? MF_BANK2 : (MF_AUXREAD | MF_AUXWRITE)));
+		}
+
+		UpdatePaging(0);	// Initialize=0
+	}
+
+	DWORD elapsed = GetTickCount() - milliseconds;
+	if (elapsed == 0)
+		elapsed = 1;
+
+#ifdef RAMWORKS
+	g_uActiveBank = uOldActiveBank;
+	memaux = RWpages[g_uActiveBank];
+#endif
+	SetMemMode(uOldMemMode);
+	UpdatePaging(0);	// Initialize=0
+
+	return (DWORD) ((UINT64)uNumSwitches * 1000 / elapsed);
+}
+
+//===========================================================================
+
 LPVOID MemGetSlotParameters(UINT uSlot)
 {
 	_ASSERT(uSlot < NUM_SLOTS);
@@ -2230,6 +2195,7 @@ bool MemLoadSnapshot(YamlLoadHelper& yamlLoadHelper, UINT unitVersion)
 		memset(memmain+0xC000, 0, LanguageCardSlot0::kMemBankSize);
 	}
 	memset(memdirty, 0, 0x100);
+	NTSC_VideoInvalidateScanlines();
 
 	yamlLoadHelper.PopMap();
 
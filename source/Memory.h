@@ -46,10 +46,14 @@ typedef BYTE (__stdcall *iofunction)(WORD nPC, WORD nAddr, BYTE nWriteFlag, BYTE
 
 extern iofunction IORead[256];
 extern iofunction IOWrite[256];
+extern LPBYTE     memread[0x100];
 extern LPBYTE     memwrite[0x100];
-extern LPBYTE     mem;
 extern LPBYTE     memdirty;
 
+// memdirty[] bit0 = page has been written
+#define MEMDIRTY_PREDECODE	0x02	// Pre-decoded CPU core must discard its records for this page (see cpu_predecode.h)
+#define MEMDIRTY_VIDEO		0x04	// NTSC video must regenerate the scanlines fetched from this page (see NTSC.cpp)
+
 #ifdef RAMWORKS
 const UINT kMaxExMemoryBanks = 127;	// 127 * aux mem(64K) + main mem(64K) = 8MB
 extern UINT       g_uMaxExPages;	// user requested ram pages (from cmd line)
@@ -64,10 +68,17 @@ bool	MemCheckINTCXROM();
 LPBYTE  MemGetAuxPtr(const WORD);
 LPBYTE  MemGetMainPtr(const WORD);
 LPBYTE  MemGetBankPtr(const UINT nBank);
+LPBYTE  MemGetReadPtr(const WORD addr);
+LPBYTE  MemGetWritePtr(const WORD addr);
+void    MemWriteByte(const WORD addr, const BYTE value);
+WORD    MemReadWord(const WORD addr);
+void    MemReadBlock(LPBYTE pDst, const WORD addr, const UINT length);
+void    MemWriteBlock(const WORD addr, const BYTE* pSrc, const UINT length);
 LPBYTE  MemGetCxRomPeripheral();
 DWORD   GetMemMode(void);
 void    SetMemMode(DWORD memmode);
 bool	MemOptimizeForModeChanging(WORD programcounter, WORD address);
+DWORD   MemBenchmarkBankSwitch(const UINT uNumSwitches);
 bool    MemIsAddrCodeMemory(const USHORT addr);
 void    MemInitialize ();
 void    MemInitializeROM(void);
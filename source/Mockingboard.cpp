@@ -217,6 +217,7 @@ static CRITICAL_SECTION g_CriticalSection;	// To guard 6522's IFR
 static DWORD WINAPI SSI263Thread(LPVOID);
 static void Votrax_Write(BYTE nDevice, BYTE nValue);
 static double MB_GetFramePeriod(void);
+static void MB_ScheduleNextEvent(void);
 
 //---------------------------------------------------------------------------
 
@@ -428,7 +429,7 @@ static void SY6522_Write(BYTE nDevice, BYTE nReg, BYTE nValue)
 			pMB->sy6522.TIMER1_COUNTER.w = pMB->sy6522.TIMER1_LATCH.w;
 
 			StartTimer1(pMB);
-			CpuAdjustIrqCheck(pMB->sy6522.TIMER1_LATCH.w);	// Sync IRQ check timeout with 6522 counter underflow - GH#608
+			MB_ScheduleNextEvent();	// Sync next MB_UpdateCycles() with 6522 counter underflow - GH#608
 			break;
 		case 0x07:	// TIMER1H_LATCH
 			// Clear Timer1 Interrupt Flag.
@@ -446,7 +447,7 @@ static void SY6522_Write(BYTE nDevice, BYTE nReg, BYTE nValue)
 			pMB->sy6522.TIMER2_COUNTER.w = pMB->sy6522.TIMER2_LATCH.w;
 
 			StartTimer2(pMB);
-			CpuAdjustIrqCheck(pMB->sy6522.TIMER2_LATCH.w);	// Sync IRQ check timeout with 6522 counter underflow - GH#608
+			MB_ScheduleNextEvent();	// Sync next MB_UpdateCycles() with 6522 counter underflow - GH#608
 			break;
 		case 0x0a:	// SERIAL_SHIFT
 			break;
@@ -490,6 +491,7 @@ static void SY6522_Write(BYTE nDevice, BYTE nReg, BYTE nValue)
 				if (pMB->sy6522.IER & IxR_TIMER2)
 					StartTimer2(pMB);
 			}
+			MB_ScheduleNextEvent();
 			break;
 		case 0x0f:	// ORA_NO_HS
 			break;
@@ -1506,7 +1508,7 @@ static BYTE __stdcall MB_Read(WORD PC, WORD nAddr, BYTE bWrite, BYTE nValue, ULO
 	if(!IS_APPLE2 && MemCheckINTCXROM())
 	{
 		_ASSERT(0);	// Card ROM disabled, so IO_Cxxx() returns the internal ROM
-		return mem[nAddr];
+		return *MemGetReadPtr(nAddr);
 	}
 
 	if(g_SoundcardType == CT_Empty)
@@ -1724,6 +1726,7 @@ void MB_Demute()
 void MB_StartOfCpuExecute()
 {
 	g_uLastCumulativeCycles = g_nCumulativeCycles;
+	MB_ScheduleNextEvent();
 }
 
 // Called by ContinueExecution() at the end of every video frame
@@ -1738,6 +1741,15 @@ void MB_EndOfVideoFrame()
 
 //-----------------------------------------------------------------------------
 
+// Cycles until CheckTimerUnderflowAndIrq() will next see an underflow or IRQ
+static UINT GetCyclesUntilTimerUpdate(const USHORT timerCounter, const int timerIrqDelay)
+{
+	if (timerIrqDelay)
+		return timerIrqDelay;
+
+	return timerCounter ? timerCounter : 0x10000;
+}
+
 static bool CheckTimerUnderflowAndIrq(USHORT& timerCounter, int& timerIrqDelay, const USHORT nClocks, bool* pTimerUnderflow=NULL)
 {
 	int oldTimer = timerCounter;	// Catch the case for 0x0000 -> -ve, as this isn't an underflow
@@ -1773,7 +1785,7 @@ static bool CheckTimerUnderflowAndIrq(USHORT& timerCounter, int& timerIrqDelay,
 
 // Called by:
 // . CpuExecute() every ~1000 @ 1MHz
-// . CheckInterruptSources() every 128 cycles
+// . CpuServiceEvents() at the next scheduled 6522 timer underflow/IRQ (see MB_ScheduleNextEvent())
 // . MB_Read() / MB_Write()
 void MB_UpdateCycles(ULONG uExecutedCycles)
 {
@@ -1862,6 +1874,30 @@ void MB_UpdateCycles(ULONG uExecutedCycles)
 			}
 		}
 	}
+
+	MB_ScheduleNextEvent();
+}
+
+// Schedule the next MB_UpdateCycles() for the next Timer1 underflow or Timer2 IRQ
+// . Timer1 always counts (see Willy Byte in MB_UpdateCycles()), Timer2 only matters when active
+static void MB_ScheduleNextEvent(void)
+{
+	if (g_SoundcardType == CT_Empty)
+	{
+		CpuCancelEvent(CPU_EVENT_MOCKINGBOARD);
+		return;
+	}
+
+	UINT uCycles = 0x8000;	// MB_UpdateCycles() requires < 0x10000 cycles between updates
+	for (int i=0; i<NUM_SY6522; i++)
+	{
+		const SY6522_AY8910* pMB = &g_MB[i];
+		uCycles = MIN(uCycles, GetCyclesUntilTimerUpdate(pMB->sy6522.TIMER1_COUNTER.w, pMB->sy6522.timer1IrqDelay));
+		if (pMB->bTimer2Active)
+			uCycles = MIN(uCycles, GetCyclesUntilTimerUpdate(pMB->sy6522.TIMER2_COUNTER.w, pMB->sy6522.timer2IrqDelay));
+	}
+
+	CpuScheduleEvent(CPU_EVENT_MOCKINGBOARD, g_uLastCumulativeCycles + uCycles);
 }
 
 //-----------------------------------------------------------------------------
@@ -230,8 +230,6 @@ void CMouseInterface::SetSlotRom()
 
 	UINT uOffset = (m_by6821B << 7) & 0x0700;
 	memcpy(pCxRomPeripheral+m_uSlot*256, m_pSlotRom+uOffset, 256);
-	if (mem)
-		memcpy(mem+0xC000+m_uSlot*256, m_pSlotRom+uOffset, 256);
 }
 
 //===========================================================================
@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 	#include "Applewin.h"
 	#include "CPU.h"	// CpuGetCyclesThisVideoFrame()
 	#include "Frame.h"
+	#include "Log.h"
 	#include "Memory.h" // MemGetMainPtr() MemGetAuxPtr()
 	#include "Video.h"  // g_pFramebufferbits
 	#include "RGBMonitor.h"
@@ -31,6 +32,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 	#include "NTSC.h"
 	#include "NTSC_CharSet.h"
 
+	#include <emmintrin.h>	// SSE2
+
+#ifndef PF_XMMI64_INSTRUCTIONS_AVAILABLE
+	#define PF_XMMI64_INSTRUCTIONS_AVAILABLE 10
+#endif
+
 
 #define NTSC_REMOVE_WHITE_RINGING  1 // 0 = theoritical dimmed white has chroma, 1 = pure white without chroma tinting
 #define NTSC_REMOVE_BLACK_GHOSTING 1 // 1 = remove black smear/smudges carrying over
@@ -157,6 +164,18 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 	static UpdatePixelFunc_t g_pFuncUpdateBnWPixel = 0; //updatePixelBnWMonitorSingleScanline;
 	static UpdatePixelFunc_t g_pFuncUpdateHuePixel = 0; //updatePixelHueMonitorSingleScanline;
 
+	// SSE2 pixel kernel: equivalent to 14 calls of a g_pFuncUpdate*Pixel function (see updatePixelsSSE2())
+	enum PixelKernelType_e { PK_MONITOR_SINGLE, PK_MONITOR_DOUBLE, PK_COLORTV_SINGLE, PK_COLORTV_DOUBLE };
+	struct PixelKernel_t
+	{
+		PixelKernelType_e type;
+		const bgra_t*     pTable;	// [NTSC_NUM_SEQUENCES], or [NTSC_NUM_PHASES][NTSC_NUM_SEQUENCES] if bHue
+		bool              bHue;		// uses (and advances) g_nColorPhaseNTSC
+	};
+	static PixelKernel_t g_kernelBnWPixel;
+	static PixelKernel_t g_kernelHuePixel;
+	static bool g_bVideoSSE2 = false;	// CPU has SSE2 and the kernel matches the scalar pixel functions (see CheckPixelKernels())
+
 	static uint8_t  g_nTextFlashCounter = 0;
 	static uint16_t g_nTextFlashMask    = 0;
 
@@ -170,6 +189,72 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 	static int g_nColorPhaseNTSC = INITIAL_COLOR_PHASE;
 	static int g_nSignalBitsNTSC = 0;
 
+	// Dirty scanlines: a visible scanline is only regenerated if its inputs changed since it was last drawn,
+	// otherwise the previous frame's pixels are left in the framebuffer
+	// . inputs: the 256-byte page it fetches from (memdirty[] & MEMDIRTY_VIDEO), and the video mode/page/charset/colorburst/flash key
+	// . a page written mid-frame may already have been scanned, so pages written in the previous frame are also treated as dirty
+	// . the in-between (odd) framebuffer line blends adjacent scanlines, so a changed scanline also redraws its neighbours
+	static bool     g_bScanlineDirty = true;		// current scanline is being drawn (decided at VIDEO_SCANNER_HORZ_START)
+	static uint32_t g_uScanlineModeKey = 0;			// from NTSC_SetVideoMode()
+	static uint32_t g_aScanlineKey   [VIDEO_SCANNER_Y_DISPLAY];
+	static const uint32_t SCANLINE_KEY_INVALID = 0xFFFFFFFF;	// page $FF is never a video page
+	static bool     g_aScanlineRedraw[VIDEO_SCANNER_Y_DISPLAY];	// a neighbouring scanline changed, so draw this one on its next scan
+	static uint8_t  g_aVideoPageDirtyPrevFrame[0x100];
+
+	// Video memory & dirty pages: NULL = live (MemGet*Ptr() & memdirty[]), else a frame's snapshot (see NTSC_VideoPipelineSubmitFrame())
+	static uint8_t* g_pVideoMemMain   = NULL;
+	static uint8_t* g_pVideoMemAux    = NULL;
+	static uint8_t* g_pVideoPageDirty = NULL;
+
+	// Video pipeline (cmd-line: -video-thread)
+	// . the CPU thread logs each frame's video mode changes and 6502 stores to the video pages (cycle-stamped), then at the end
+	//   of the frame the render thread synthesizes that frame's scanlines from the log while the CPU emulates the next frame
+	// . the render thread starts from a copy of the video pages taken at the start of the frame, and replays the stores at their
+	//   cycles, so mid-frame writes (eg. beam racing) & mode changes (eg. split-screen) render as they do inline
+	// . memory changed other than by a 6502 store (eg. -fast-disk sector transfers, RamWorks bank switch) is seen from the next frame
+	// . not for VT_COLOR_MONITOR_RGB, as the RGB card's state isn't logged
+	struct VideoModeEvent_t
+	{
+		UINT     uCycle;			// cycles since the start of the frame
+		uint32_t uVideoModeFlags;
+		int      nCharSet;
+		int      nTextCols;			// 40 or 80
+		bool     bTextModeOnly;		// NTSC_SetVideoTextMode() isn't delayed by a cycle, so it can precede its video mode change
+	};
+
+	struct VideoWriteEvent_t
+	{
+		UINT     uCycle;			// cycles since the start of the frame
+		uint16_t addr;
+		uint8_t  value;
+		uint8_t  prevValue;			// to undo the store in a copy taken after it (see NTSC_VideoPipelineSubmitFrame())
+		bool     bAux;
+	};
+
+	struct VideoFrame_t
+	{
+		UINT    uStartCycle;		// video scanner's position when this frame's rendering starts
+		bool    bInvalidate;		// NTSC_VideoInvalidateScanlines() was called during the frame
+		std::vector<VideoModeEvent_t> events;
+		std::vector<VideoWriteEvent_t> writes;
+		uint8_t aMain[0x10000];		// video pages ($0400-$5FFF) at the start of the frame, then updated by the writes as it's rendered
+		uint8_t aAux [0x10000];
+		uint8_t aPageDirty[0x100];	// pages written during the frame (MEMDIRTY_VIDEO)
+		bool    aPageStale[0x100];	// pages written since this buffer's copy was taken (incl. by replaying its writes), so need copying
+		const uint8_t* apAuxSrc[0x100];	// MemGetAuxPtr() when copied (RamWorks: depends on the soft-switches)
+	};
+
+	static VideoFrame_t g_aVideoFrame[2];
+	static UINT   g_nVideoFrameCpu = 0;				// frame being logged by the CPU thread (the other one may be rendering)
+	static bool   g_bVideoPipelineActive = false;	// render state is owned by the pipeline: the CPU thread just logs
+	static bool   g_bVideoFrameRendering = false;	// a frame was submitted to the render thread and not yet waited for
+	static HANDLE g_hVideoThread     = NULL;
+	static HANDLE g_hVideoFrameEvent = NULL;		// CPU thread -> render thread: frame submitted
+	static HANDLE g_hVideoDoneEvent  = NULL;		// render thread -> CPU thread: frame rendered
+	static HANDLE g_hVideoQuitEvent  = NULL;
+	static UINT   g_nVideoFrameRender = 0;			// frame being rendered by the render thread
+	static int    g_nVideoPipelineTextCols = 40;	// CPU thread's latest NTSC_SetVideoTextMode()
+
 	#define NTSC_NUM_PHASES     4
 	#define NTSC_NUM_SEQUENCES  4096
 
@@ -186,6 +271,25 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 	static bgra_t g_aBnWMonitorCustom           [NTSC_NUM_SEQUENCES];
 	static bgra_t g_aBnWColorTVCustom           [NTSC_NUM_SEQUENCES];
 
+	// Pristine copy of the chroma tables (see initChromaTables())
+	struct ChromaTables_t
+	{
+		bgra_t aBnWMonitor                 [NTSC_NUM_SEQUENCES];
+		bgra_t aHueMonitor[NTSC_NUM_PHASES][NTSC_NUM_SEQUENCES];
+		bgra_t aBnwColorTV                 [NTSC_NUM_SEQUENCES];
+		bgra_t aHueColorTV[NTSC_NUM_PHASES][NTSC_NUM_SEQUENCES];
+	};
+
+	struct ChromaTablesFileHeader_t
+	{
+		char     szMagic[8];	// "AWCHROMA"
+		uint32_t uKey;			// getChromaTablesKey()
+		uint32_t uChecksum;		// of the ChromaTables_t that follows
+	};
+
+	static ChromaTables_t g_chromaTables;
+	static bool           g_bChromaTablesValid = false;
+
 	#define CHROMA_ZEROS 2
 	#define CHROMA_POLES 2
 	#define CHROMA_GAIN  7.438011255f // Should this be 7.15909 MHz ?
@@ -415,6 +519,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 	INLINE void      updateVideoScannerAddress();
 	INLINE uint16_t  getVideoScannerAddressTXT();
 	INLINE uint16_t  getVideoScannerAddressHGR();
+	static void      setVideoMode( uint32_t uVideoModeFlags, int nCharSet );
+	static void      videoPipelineStop();
 
 	static void initChromaPhaseTables();
 	static real initFilterChroma   (real z);
@@ -695,6 +801,99 @@ inline bool GetColorBurst( void )
 
 //===========================================================================
 
+INLINE uint8_t* getVideoMainPtr( uint16_t addr )
+{
+	return g_pVideoMemMain ? g_pVideoMemMain + addr : MemGetMainPtr(addr);
+}
+
+INLINE uint8_t* getVideoAuxPtr( uint16_t addr )
+{
+	return g_pVideoMemAux ? g_pVideoMemAux + addr : MemGetAuxPtr(addr);
+}
+
+INLINE uint8_t* getVideoPageDirty( void )
+{
+	return g_pVideoPageDirty ? g_pVideoPageDirty : memdirty;
+}
+
+//===========================================================================
+
+// Called at the start of each frame (ie. vertical wrap)
+static void updateVideoPagesDirty()
+{
+	uint8_t* pDirty = getVideoPageDirty();
+
+	// Text/lores: $0400-$0BFF, Hires: $2000-$5FFF
+	for (UINT page = 0x04; page < 0x60; page++)
+	{
+		g_aVideoPageDirtyPrevFrame[page] = pDirty[page] & MEMDIRTY_VIDEO;
+		pDirty[page] &= ~MEMDIRTY_VIDEO;
+	}
+}
+
+static bool checkScanlineDirty( uint16_t addr, bool bText )
+{
+	const UINT line = g_nVideoClockVert;
+	const UINT page = addr >> 8;
+
+	uint32_t key = g_uScanlineModeKey | (page << 24);
+	key |= (g_eVideoType << 16) | (g_VideoTVMode1_29_1_0 ? (1<<20) : 0) | (GetColorBurst() ? (1<<21) : 0);
+	if (bText && g_nTextFlashMask)
+		key |= (1<<22);
+
+	const bool bChanged = (key != g_aScanlineKey[line]) || ((getVideoPageDirty()[page] | g_aVideoPageDirtyPrevFrame[page]) & MEMDIRTY_VIDEO);
+
+	if (bChanged)
+	{
+		g_aScanlineKey[line] = key;
+
+		// Blending uses the previous scanline (TV 1.29 mode) or the next scanline's previous frame (other modes)
+		if (line > 0)
+			g_aScanlineRedraw[line-1] = true;
+		if (line < VIDEO_SCANNER_Y_DISPLAY-1)
+			g_aScanlineRedraw[line+1] = true;
+	}
+	else if (!g_aScanlineRedraw[line])
+	{
+		return false;
+	}
+
+	g_aScanlineRedraw[line] = false;
+	return true;
+}
+
+// Pre: addr = video scanner address for this cycle
+inline bool updateScanlineDirty( uint16_t addr, bool bText = false )
+{
+	if (g_nVideoClockHorz == VIDEO_SCANNER_HORZ_START)
+		g_bScanlineDirty = checkScanlineDirty(addr, bText);
+
+	return g_bScanlineDirty;
+}
+
+//===========================================================================
+static void invalidateScanlines( void )
+{
+	for (UINT line = 0; line < VIDEO_SCANNER_Y_DISPLAY; line++)
+		g_aScanlineKey[line] = SCANLINE_KEY_INVALID;
+}
+
+void NTSC_VideoInvalidateScanlines( void )
+{
+	if (g_bVideoPipelineActive)
+	{
+		// Video memory may have changed without setting memdirty[] (eg. RamWorks bank switch), so re-copy every page too
+		g_aVideoFrame[g_nVideoFrameCpu].bInvalidate = true;
+		for (UINT i = 0; i < 2; i++)
+			memset(g_aVideoFrame[i].aPageStale, true, sizeof(g_aVideoFrame[i].aPageStale));
+		return;
+	}
+
+	invalidateScanlines();
+}
+
+//===========================================================================
+
 void update7MonoPixels( uint16_t bits )
 {
 	g_pFuncUpdateBnWPixel(bits & 1); bits >>= 1;
@@ -708,11 +907,113 @@ void update7MonoPixels( uint16_t bits )
 
 //===========================================================================
 
+INLINE __m128i loadPixelsSSE2( const uint32_t* p, bool bHalf )
+{
+	return bHalf ? _mm_loadl_epi64((const __m128i*)p) : _mm_loadu_si128((const __m128i*)p);
+}
+
+INLINE void storePixelsSSE2( uint32_t* p, __m128i pixels, bool bHalf )
+{
+	if (bHalf)
+		_mm_storel_epi64((__m128i*)p, pixels);
+	else
+		_mm_storeu_si128((__m128i*)p, pixels);
+}
+
+// 14 pixels (ie. 1 cycle) at once: bit-exact with 14 calls to the kernel's scalar g_pFuncUpdate*Pixel function
+// . the 12-bit signal windows are sequential, so the table lookups stay scalar
+// . the current & in-between scanlines are then blended and written 4 pixels at a time
+static void updatePixelsSSE2( uint16_t bits, const PixelKernel_t& kernel )
+{
+	uint32_t aColor[16];
+	uint32_t signal = g_nSignalBitsNTSC;
+
+	if (kernel.bHue)
+	{
+		const uint32_t* pTable = (const uint32_t*) kernel.pTable;
+		const int phase = g_nColorPhaseNTSC;
+		for (int i = 0; i < 14; i++, bits >>= 1)
+		{
+			signal = ((signal << 1) | (bits & 1)) & 0xFFF;
+			aColor[i] = pTable[((phase + i) & 3) * NTSC_NUM_SEQUENCES + signal];
+		}
+		g_nColorPhaseNTSC = (phase + 14) & 3;
+	}
+	else
+	{
+		const uint32_t* pTable = (const uint32_t*) kernel.pTable;
+		for (int i = 0; i < 14; i++, bits >>= 1)
+		{
+			signal = ((signal << 1) | (bits & 1)) & 0xFFF;
+			aColor[i] = pTable[signal];
+		}
+	}
+
+	g_nSignalBitsNTSC = signal;
+
+	const bool bColorTV = kernel.type == PK_COLORTV_SINGLE || kernel.type == PK_COLORTV_DOUBLE;
+	const bool bPrevLines = bColorTV && g_VideoTVMode1_29_1_0;	// NB. TV mode uses previous 2 lines
+	uint32_t* pLine0Curr = getScanlineCurrent();
+	uint32_t* pLine1 = bPrevLines ? getScanlinePreviousInbetween() : getScanlineNextInbetween();
+	const uint32_t* pLine2 = bPrevLines ? getScanlinePrevious() : getScanlineNext();
+
+	const __m128i alpha = _mm_set1_epi32(ALPHA32_MASK);
+	const __m128i mask_fe = _mm_set1_epi32(0x00fefefe);
+	const __m128i mask_fc = _mm_set1_epi32(0x00fcfcfc);
+
+	for (int i = 0; i < 14; i += 4)
+	{
+		const bool bHalf = (i == 12);	// last 2 pixels
+		const __m128i color0 = loadPixelsSSE2(&aColor[i], bHalf);
+		__m128i color1;
+
+		switch (kernel.type)
+		{
+		case PK_MONITOR_SINGLE:
+			color1 = alpha;
+			break;
+		case PK_MONITOR_DOUBLE:
+			color1 = color0;
+			break;
+		default:	// PK_COLORTV_SINGLE, PK_COLORTV_DOUBLE
+			{
+				const __m128i color2 = loadPixelsSSE2(&pLine2[i], bHalf);
+				if (kernel.type == PK_COLORTV_SINGLE && bPrevLines)
+				{
+					// Saturating subtract: same as the scalar clamp-to-0 on underflow
+					color1 = _mm_subs_epu8(color0, _mm_srli_epi32(_mm_and_si128(color2, mask_fc), 2));
+				}
+				else
+				{
+					// 50% Blend
+					color1 = _mm_add_epi32(_mm_srli_epi32(_mm_and_si128(color0, mask_fe), 1), _mm_srli_epi32(_mm_and_si128(color2, mask_fe), 1));
+					if (kernel.type == PK_COLORTV_SINGLE)
+						color1 = _mm_srli_epi32(_mm_and_si128(color1, mask_fe), 1);	// ... then 50% brightness for inbetween line
+				}
+				color1 = _mm_or_si128(color1, alpha);
+			}
+			break;
+		}
+
+		storePixelsSSE2(&pLine1[i], color1, bHalf);
+		storePixelsSSE2(&pLine0Curr[i], color0, bHalf);
+	}
+
+	g_pVideoAddress += 14;
+}
+
+//===========================================================================
+
 // NB. g_nLastColumnPixelNTSC = bits.b13 will be superseded by these parent funcs which use bits.b14:
 // . updateScreenDoubleHires80(), updateScreenDoubleLores80(), updateScreenText80()
 inline void updatePixels( uint16_t bits )
 {
-	if (!GetColorBurst())
+	if (g_bVideoSSE2)
+	{
+		updatePixelsSSE2(bits, GetColorBurst() ? g_kernelHuePixel : g_kernelBnWPixel);
+		g_nLastColumnPixelNTSC = (bits >> 13) & 1;
+	}
+	else if (!GetColorBurst())
 	{ 
 		/* #1 of 7 */
 		g_pFuncUpdateBnWPixel(bits & 1); bits >>= 1;
@@ -777,6 +1078,7 @@ inline void updateVideoScannerHorzEOLSimple()
 			g_nVideoClockVert = 0;
 
 			updateFlashRate();
+			updateVideoPagesDirty();
 		}
 
 		if (g_nVideoClockVert < VIDEO_SCANNER_Y_DISPLAY)
@@ -791,7 +1093,7 @@ inline void updateVideoScannerHorzEOL()
 {
 	if (VIDEO_SCANNER_MAX_HORZ == ++g_nVideoClockHorz)
 	{
-		if (g_nVideoClockVert < VIDEO_SCANNER_Y_DISPLAY)
+		if (g_nVideoClockVert < VIDEO_SCANNER_Y_DISPLAY && g_bScanlineDirty)
 		{
 			if (!GetColorBurst())
 			{
@@ -815,6 +1117,7 @@ inline void updateVideoScannerHorzEOL()
 			g_nVideoClockVert = 0;
 
 			updateFlashRate();
+			updateVideoPagesDirty();
 		}
 
 		if (g_nVideoClockVert < VIDEO_SCANNER_Y_DISPLAY)
@@ -851,21 +1154,32 @@ inline void updateVideoScannerAddress()
 	g_nColorPhaseNTSC      = INITIAL_COLOR_PHASE;
 	g_nLastColumnPixelNTSC = 0;
 	g_nSignalBitsNTSC      = 0;
+	g_bScanlineDirty       = true;	// until updateScanlineDirty() at VIDEO_SCANNER_HORZ_START
 }
 
 //===========================================================================
+INLINE uint16_t getVideoScannerAddressTXT( uint16_t vert, uint16_t horz, int page )
+{
+	return (g_aClockVertOffsetsTXT[vert/8] + 
+		g_pHorzClockOffset         [vert/64][horz] + (page * 0x400));
+}
+
 INLINE uint16_t getVideoScannerAddressTXT()
 {
-	return (g_aClockVertOffsetsTXT[g_nVideoClockVert/8] + 
-		g_pHorzClockOffset         [g_nVideoClockVert/64][g_nVideoClockHorz] + (g_nTextPage  *  0x400));
+	return getVideoScannerAddressTXT(g_nVideoClockVert, g_nVideoClockHorz, g_nTextPage);
 }
 
 //===========================================================================
-INLINE uint16_t getVideoScannerAddressHGR()
+INLINE uint16_t getVideoScannerAddressHGR( uint16_t vert, uint16_t horz, int page )
 {
 	// NB. For both A2 and //e use APPLE_IIE_HORZ_CLOCK_OFFSET - see VideoGetScannerAddress() where only TEXT mode adds $1000
-	return (g_aClockVertOffsetsHGR[g_nVideoClockVert  ] + 
-		APPLE_IIE_HORZ_CLOCK_OFFSET[g_nVideoClockVert/64][g_nVideoClockHorz] + (g_nHiresPage * 0x2000));
+	return (g_aClockVertOffsetsHGR[vert  ] + 
+		APPLE_IIE_HORZ_CLOCK_OFFSET[vert/64][horz] + (page * 0x2000));
+}
+
+INLINE uint16_t getVideoScannerAddressHGR()
+{
+	return getVideoScannerAddressHGR(g_nVideoClockVert, g_nVideoClockHorz, g_nHiresPage);
 }
 
 
@@ -1037,6 +1351,177 @@ static void initChromaPhaseTables (void)
 
 }
 
+// FNV-1a
+//===========================================================================
+static uint32_t hashChromaBytes (uint32_t hash, const void* pData, size_t uSize)
+{
+	const uint8_t* p = (const uint8_t*) pData;
+	for (size_t i = 0; i < uSize; i++)
+	{
+		hash ^= p[i];
+		hash *= 16777619;
+	}
+	return hash;
+}
+
+// Anything that could change the generated tables:
+// . this build: the AppleWin version, the build time, the compiler version & debug/release (ie. its floating-point code), and the word size
+// . the filter constants & table options
+//===========================================================================
+static uint32_t getChromaTablesKey (void)
+{
+#ifdef _MSC_FULL_VER
+	const unsigned int uCompilerVersion = _MSC_FULL_VER;
+#else
+	const unsigned int uCompilerVersion = 0;
+#endif
+#ifdef _DEBUG
+	const int bDebug = 1;
+#else
+	const int bDebug = 0;
+#endif
+
+	char szKey[256];
+	StringCbPrintf(szKey, sizeof(szKey), "%s/%s %s/%u/%d/%u/%u/%d%d%d%d%d", VERSIONSTRING, __DATE__, __TIME__, uCompilerVersion, bDebug,
+		(UINT)sizeof(void*), (UINT)sizeof(ChromaTables_t),
+		NTSC_REMOVE_WHITE_RINGING, NTSC_REMOVE_BLACK_GHOSTING, NTSC_REMOVE_GRAY_CHROMA, DEBUG_PHASE_ZERO, ALT_TABLE);
+
+	const real aFilterConstants[] =
+	{
+		CHROMA_GAIN, CHROMA_0, CHROMA_1,
+		LUMA_GAIN, LUMA_0, LUMA_1,
+		SIGNAL_GAIN, SIGNAL_0, SIGNAL_1,
+		CYCLESTART, RAD_45, RAD_90
+	};
+
+	const uint32_t hash = hashChromaBytes(2166136261u, szKey, strlen(szKey));
+	return hashChromaBytes(hash, aFilterConstants, sizeof(aFilterConstants));
+}
+
+// One file for all builds: a file from another build (or a corrupt one) is rejected by the header's key & checksum, then overwritten
+//===========================================================================
+static void getChromaTablesFilename (char* pszFilename, size_t uSize, char* pszTempPath, size_t uTempPathSize)
+{
+	if (!GetTempPath(uTempPathSize, pszTempPath))
+		pszTempPath[0] = 0;
+	StringCbPrintf(pszFilename, uSize, "%sAppleWin-NTSC.bin", pszTempPath);
+}
+
+// Delete the files left by older versions (which had a file per key) and the temp files of instances that exited before renaming them
+// . NB. a temp file that another instance is still writing is open, so DeleteFile() fails for it
+//===========================================================================
+static void deleteStaleChromaTablesFiles (const char* pszTempPath)
+{
+	const char* aPatterns[] = { "AppleWin-NTSC-*.bin", "AppleWin-NTSC.bin.*" };
+
+	for (UINT i = 0; i < sizeof(aPatterns)/sizeof(aPatterns[0]); i++)
+	{
+		char szPattern[MAX_PATH];
+		StringCbPrintf(szPattern, sizeof(szPattern), "%s%s", pszTempPath, aPatterns[i]);
+
+		WIN32_FIND_DATA fd;
+		HANDLE hFind = FindFirstFile(szPattern, &fd);
+		if (hFind == INVALID_HANDLE_VALUE)
+			continue;
+
+		do
+		{
+			char szFilename[MAX_PATH];
+			StringCbPrintf(szFilename, sizeof(szFilename), "%s%s", pszTempPath, fd.cFileName);
+			DeleteFile(szFilename);
+		}
+		while (FindNextFile(hFind, &fd));
+
+		FindClose(hFind);
+	}
+}
+
+//===========================================================================
+static bool loadChromaTables (ChromaTables_t& tables)
+{
+	const uint32_t uKey = getChromaTablesKey();
+	char szFilename[MAX_PATH];
+	char szTempPath[MAX_PATH];
+	getChromaTablesFilename(szFilename, sizeof(szFilename), szTempPath, sizeof(szTempPath));
+
+	FILE* pFile = fopen(szFilename, "rb");
+	if (!pFile)
+		return false;
+
+	ChromaTablesFileHeader_t header;
+	bool bRes = fread(&header, sizeof(header), 1, pFile) == 1
+		&& memcmp(header.szMagic, "AWCHROMA", sizeof(header.szMagic)) == 0
+		&& header.uKey == uKey
+		&& fread(&tables, sizeof(tables), 1, pFile) == 1
+		&& header.uChecksum == hashChromaBytes(2166136261u, &tables, sizeof(tables));
+
+	fclose(pFile);
+	return bRes;
+}
+
+// Write to a per-process temp file, then rename it: so concurrent instances never see a partially written file
+//===========================================================================
+static void saveChromaTables (const ChromaTables_t& tables)
+{
+	ChromaTablesFileHeader_t header;
+	memcpy(header.szMagic, "AWCHROMA", sizeof(header.szMagic));
+	header.uKey = getChromaTablesKey();
+	header.uChecksum = hashChromaBytes(2166136261u, &tables, sizeof(tables));
+
+	char szFilename[MAX_PATH];
+	char szTempPath[MAX_PATH];
+	char szTempFilename[MAX_PATH];
+	getChromaTablesFilename(szFilename, sizeof(szFilename), szTempPath, sizeof(szTempPath));
+	deleteStaleChromaTablesFiles(szTempPath);
+	StringCbPrintf(szTempFilename, sizeof(szTempFilename), "%s.%u", szFilename, (UINT)GetCurrentProcessId());
+
+	FILE* pFile = fopen(szTempFilename, "wb");
+	if (!pFile)
+		return;
+
+	bool bRes = fwrite(&header, sizeof(header), 1, pFile) == 1
+		&& fwrite(&tables, sizeof(tables), 1, pFile) == 1;
+	bRes = (fclose(pFile) == 0) && bRes;
+
+	if (!bRes || !MoveFileEx(szTempFilename, szFilename, MOVEFILE_REPLACE_EXISTING))
+		DeleteFile(szTempFilename);
+}
+
+// initChromaPhaseTables() runs 4 Butterworth filters in double precision for every phase & sequence, which is slow. So:
+// . the tables are only generated once per process, and restored from a pristine copy after that (eg. after the debugger has modified them)
+// . and they're cached in a file in the temp dir, so that other instances (of the same build) just load them
+//===========================================================================
+static void initChromaTables (void)
+{
+	if (!g_bChromaTablesValid)
+	{
+		if (loadChromaTables(g_chromaTables))
+		{
+			LogFileOutput("NTSC: loaded chroma tables from cache\n");
+		}
+		else
+		{
+			initChromaPhaseTables();
+
+			memcpy(g_chromaTables.aBnWMonitor, g_aBnWMonitor, sizeof(g_aBnWMonitor));
+			memcpy(g_chromaTables.aHueMonitor, g_aHueMonitor, sizeof(g_aHueMonitor));
+			memcpy(g_chromaTables.aBnwColorTV, g_aBnwColorTV, sizeof(g_aBnwColorTV));
+			memcpy(g_chromaTables.aHueColorTV, g_aHueColorTV, sizeof(g_aHueColorTV));
+			g_bChromaTablesValid = true;
+
+			saveChromaTables(g_chromaTables);
+			return;
+		}
+
+		g_bChromaTablesValid = true;
+	}
+
+	memcpy(g_aBnWMonitor, g_chromaTables.aBnWMonitor, sizeof(g_aBnWMonitor));
+	memcpy(g_aHueMonitor, g_chromaTables.aHueMonitor, sizeof(g_aHueMonitor));
+	memcpy(g_aBnwColorTV, g_chromaTables.aBnwColorTV, sizeof(g_aBnwColorTV));
+	memcpy(g_aHueColorTV, g_chromaTables.aHueColorTV, sizeof(g_aHueColorTV));
+}
+
 /*
 http://www-users.cs.york.ac.uk/~fisher/mkfilter/trad.html
 Sample Rate: ???
@@ -1210,6 +1695,32 @@ static void updatePixelHueMonitorDoubleScanline (uint16_t compositeSignal)
 	updateColorPhase();
 }
 
+//===========================================================================
+static PixelKernel_t getPixelKernel (UpdatePixelFunc_t pFuncUpdatePixel)
+{
+	PixelKernel_t kernel;
+	kernel.bHue = false;
+
+	if (pFuncUpdatePixel == updatePixelBnWMonitorSingleScanline)
+		{ kernel.type = PK_MONITOR_SINGLE; kernel.pTable = g_aBnWMonitorCustom; }
+	else if (pFuncUpdatePixel == updatePixelBnWMonitorDoubleScanline)
+		{ kernel.type = PK_MONITOR_DOUBLE; kernel.pTable = g_aBnWMonitorCustom; }
+	else if (pFuncUpdatePixel == updatePixelBnWColorTVSingleScanline)
+		{ kernel.type = PK_COLORTV_SINGLE; kernel.pTable = g_aBnWColorTVCustom; }
+	else if (pFuncUpdatePixel == updatePixelBnWColorTVDoubleScanline)
+		{ kernel.type = PK_COLORTV_DOUBLE; kernel.pTable = g_aBnWColorTVCustom; }
+	else if (pFuncUpdatePixel == updatePixelHueColorTVSingleScanline)
+		{ kernel.type = PK_COLORTV_SINGLE; kernel.pTable = g_aHueColorTV[0]; kernel.bHue = true; }
+	else if (pFuncUpdatePixel == updatePixelHueColorTVDoubleScanline)
+		{ kernel.type = PK_COLORTV_DOUBLE; kernel.pTable = g_aHueColorTV[0]; kernel.bHue = true; }
+	else if (pFuncUpdatePixel == updatePixelHueMonitorSingleScanline)
+		{ kernel.type = PK_MONITOR_SINGLE; kernel.pTable = g_aHueMonitor[0]; kernel.bHue = true; }
+	else // updatePixelHueMonitorDoubleScanline
+		{ kernel.type = PK_MONITOR_DOUBLE; kernel.pTable = g_aHueMonitor[0]; kernel.bHue = true; }
+
+	return kernel;
+}
+
 //===========================================================================
 void updateScreenDoubleHires40 (long cycles6502) // wsUpdateVideoHires0
 {
@@ -1229,9 +1740,9 @@ void updateScreenDoubleHires40 (long cycles6502) // wsUpdateVideoHires0
 			{
 				g_nColorBurstPixels = 1024;
 			}
-			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
+			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START && updateScanlineDirty(addr))
 			{
-				uint8_t *pMain = MemGetMainPtr(addr);
+				uint8_t *pMain = getVideoMainPtr(addr);
 				uint8_t  m     = pMain[0];
 				uint16_t bits  = g_aPixelDoubleMaskHGR[m & 0x7F]; // Optimization: hgrbits second 128 entries are mirror of first 128
 				updatePixels( bits );
@@ -1262,11 +1773,11 @@ void updateScreenDoubleHires80Simplified (long cycles6502 ) // wsUpdateVideoDblH
 			{
 				g_nColorBurstPixels = 1024;
 			}
-			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
+			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START && updateScanlineDirty(addr))
 			{
 				uint16_t addr = getVideoScannerAddressHGR();
-				uint8_t a = *MemGetAuxPtr(addr);
-				uint8_t m = *MemGetMainPtr(addr);
+				uint8_t a = *getVideoAuxPtr(addr);
+				uint8_t m = *getVideoMainPtr(addr);
 
 				if (RGB_IsMixModeInvertBit7())	// Invert high bit? (GH#633)
 				{
@@ -1328,10 +1839,10 @@ void updateScreenDoubleHires80 (long cycles6502 ) // wsUpdateVideoDblHires
 			{
 				g_nColorBurstPixels = 1024;
 			}
-			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
+			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START && updateScanlineDirty(addr))
 			{
-				uint8_t  *pMain = MemGetMainPtr(addr);
-				uint8_t  *pAux  = MemGetAuxPtr (addr);
+				uint8_t  *pMain = getVideoMainPtr(addr);
+				uint8_t  *pAux  = getVideoAuxPtr (addr);
 
 				uint8_t m = pMain[0];
 				uint8_t a = pAux [0];
@@ -1365,9 +1876,9 @@ void updateScreenDoubleLores40 (long cycles6502) // wsUpdateVideo7MLores
 			{
 				g_nColorBurstPixels = 1024;
 			}
-			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
+			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START && updateScanlineDirty(addr))
 			{
-				uint8_t *pMain = MemGetMainPtr(addr);
+				uint8_t *pMain = getVideoMainPtr(addr);
 				uint8_t  m     = pMain[0];
 				uint16_t lo    = getLoResBits( m ); 
 				uint16_t bits  = g_aPixelDoubleMaskHGR[(0xFF & lo >> ((1 - (g_nVideoClockHorz & 1)) * 2)) & 0x7F]; // Optimization: hgrbits
@@ -1399,7 +1910,7 @@ static void updateScreenDoubleLores80Simplified (long cycles6502) // wsUpdateVid
 			{
 				g_nColorBurstPixels = 1024;
 			}
-			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
+			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START && updateScanlineDirty(addr))
 			{
 				uint16_t addr = getVideoScannerAddressTXT();
 				UpdateDLoResCell(g_nVideoClockHorz-VIDEO_SCANNER_HORZ_START, g_nVideoClockVert, addr, g_pVideoAddress);
@@ -1428,10 +1939,10 @@ void updateScreenDoubleLores80 (long cycles6502) // wsUpdateVideoDblLores
 			{
 				g_nColorBurstPixels = 1024;
 			}
-			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
+			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START && updateScanlineDirty(addr))
 			{
-				uint8_t *pMain = MemGetMainPtr(addr);
-				uint8_t *pAux  = MemGetAuxPtr (addr);
+				uint8_t *pMain = getVideoMainPtr(addr);
+				uint8_t *pAux  = getVideoAuxPtr (addr);
 
 				uint8_t m = pMain[0];
 				uint8_t a = pAux [0];
@@ -1461,16 +1972,16 @@ static void updateScreenSingleHires40Simplified (long cycles6502)
 
 	for (; cycles6502 > 0; --cycles6502)
 	{
+		uint16_t addr = getVideoScannerAddressHGR();
+
 		if (g_nVideoClockVert < VIDEO_SCANNER_Y_DISPLAY)
 		{
 			if ((g_nVideoClockHorz < VIDEO_SCANNER_HORZ_COLORBURST_END) && (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_COLORBURST_BEG))
 			{
 				g_nColorBurstPixels = 1024;
 			}
-			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
+			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START && updateScanlineDirty(addr))
 			{
-				uint16_t addr = getVideoScannerAddressHGR();
-
 				if (!RGB_Is560Mode())
 				{
 					UpdateHiResCell(g_nVideoClockHorz-VIDEO_SCANNER_HORZ_START, g_nVideoClockVert, addr, g_pVideoAddress);
@@ -1478,7 +1989,7 @@ static void updateScreenSingleHires40Simplified (long cycles6502)
 				}
 				else	// Color Burst is off - duplicate code from updateScreenSingleHires40() (GH#631)
 				{
-					uint8_t *pMain = MemGetMainPtr(addr);
+					uint8_t *pMain = getVideoMainPtr(addr);
 					uint8_t  m     = pMain[0];
 					uint16_t bits  = g_aPixelDoubleMaskHGR[m & 0x7F]; // Optimization: hgrbits second 128 entries are mirror of first 128
 					if (m & 0x80)
@@ -1512,9 +2023,9 @@ void updateScreenSingleHires40 (long cycles6502)
 			{
 				g_nColorBurstPixels = 1024;
 			}
-			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
+			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START && updateScanlineDirty(addr))
 			{
-				uint8_t *pMain = MemGetMainPtr(addr);
+				uint8_t *pMain = getVideoMainPtr(addr);
 				uint8_t  m     = pMain[0];
 				uint16_t bits  = g_aPixelDoubleMaskHGR[m & 0x7F]; // Optimization: hgrbits second 128 entries are mirror of first 128
 				if (m & 0x80)
@@ -1553,7 +2064,7 @@ static void updateScreenSingleLores40Simplified (long cycles6502)
 			{
 				g_nColorBurstPixels = 1024;
 			}
-			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
+			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START && updateScanlineDirty(addr))
 			{
 				uint16_t addr = getVideoScannerAddressTXT();
 				UpdateLoResCell(g_nVideoClockHorz-VIDEO_SCANNER_HORZ_START, g_nVideoClockVert, addr, g_pVideoAddress);
@@ -1582,9 +2093,9 @@ void updateScreenSingleLores40 (long cycles6502)
 			{
 				g_nColorBurstPixels = 1024;
 			}
-			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
+			else if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START && updateScanlineDirty(addr))
 			{
-				uint8_t *pMain = MemGetMainPtr(addr);
+				uint8_t *pMain = getVideoMainPtr(addr);
 				uint8_t  m     = pMain[0];
 				uint16_t lo    = getLoResBits( m ); 
 				uint16_t bits  = lo >> ((1 - (g_nVideoClockHorz & 1)) * 2);
@@ -1609,9 +2120,9 @@ void updateScreenText40 (long cycles6502)
 		}
 		else if (g_nVideoClockVert < VIDEO_SCANNER_Y_DISPLAY)
 		{
-			if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
+			if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START && updateScanlineDirty(addr, true))
 			{
-				uint8_t *pMain = MemGetMainPtr(addr);
+				uint8_t *pMain = getVideoMainPtr(addr);
 				uint8_t  m     = pMain[0];
 				uint8_t  c     = getCharSetBits(m);
 				uint16_t bits  = g_aPixelDoubleMaskHGR[c & 0x7F]; // Optimization: hgrbits second 128 entries are mirror of first 128
@@ -1641,10 +2152,10 @@ void updateScreenText80 (long cycles6502)
 		}
 		else if (g_nVideoClockVert < VIDEO_SCANNER_Y_DISPLAY)
 		{
-			if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START)
+			if (g_nVideoClockHorz >= VIDEO_SCANNER_HORZ_START && updateScanlineDirty(addr, true))
 			{
-				uint8_t *pMain = MemGetMainPtr(addr);
-				uint8_t *pAux  = MemGetAuxPtr (addr);
+				uint8_t *pMain = getVideoMainPtr(addr);
+				uint8_t *pAux  = getVideoAuxPtr (addr);
 
 				uint8_t m = pMain[0];
 				uint8_t a = pAux [0];
@@ -1699,6 +2210,8 @@ uint32_t*NTSC_VideoGetChromaTable( bool bHueTypeMonochrome, bool bMonitorTypeCol
 //===========================================================================
 void NTSC_VideoClockResync(const DWORD dwCyclesThisFrame)
 {
+	videoPipelineStop();
+
 	g_nVideoClockVert = (uint16_t)(dwCyclesThisFrame / VIDEO_SCANNER_MAX_HORZ) % g_videoScannerMaxVert;
 	g_nVideoClockHorz = (uint16_t)(dwCyclesThisFrame % VIDEO_SCANNER_MAX_HORZ);
 }
@@ -1706,6 +2219,19 @@ void NTSC_VideoClockResync(const DWORD dwCyclesThisFrame)
 //===========================================================================
 uint16_t NTSC_VideoGetScannerAddress ( const ULONG uExecutedCycles )
 {
+	if (g_bVideoPipelineActive)
+	{
+		// The render thread owns the video scanner, so derive it from the CPU's cycles (and 1 cycle earlier, as below)
+		const UINT uCycles = (CpuGetCyclesThisVideoFrame(uExecutedCycles) + g_videoScanner6502Cycles - 1) % g_videoScanner6502Cycles;
+		const uint16_t vert = (uint16_t)(uCycles / VIDEO_SCANNER_MAX_HORZ);
+		const uint16_t horz = (uint16_t)(uCycles % VIDEO_SCANNER_MAX_HORZ);
+		const int page = ((g_uVideoMode & (VF_PAGE2|VF_80STORE)) == VF_PAGE2) ? 2 : 1;
+
+		if ((g_uVideoMode & VF_HIRES) && !(g_uVideoMode & VF_TEXT))
+			return getVideoScannerAddressHGR(vert, horz, page);
+		return getVideoScannerAddressTXT(vert, horz, page);
+	}
+
 	if (g_bFullSpeed)
 	{
 		// Ensure that NTSC video-scanner gets updated during full-speed, so video-dependent Apple II code doesn't hang
@@ -1739,7 +2265,7 @@ uint16_t NTSC_VideoGetScannerAddress ( const ULONG uExecutedCycles )
 }
 
 //===========================================================================
-void NTSC_SetVideoTextMode( int cols )
+static void setVideoTextMode( int cols )
 {
 	if( cols == 40 )
 		g_pFuncUpdateTextScreen = updateScreenText40;
@@ -1747,9 +2273,22 @@ void NTSC_SetVideoTextMode( int cols )
 		g_pFuncUpdateTextScreen = updateScreenText80;
 }
 
+void NTSC_SetVideoTextMode( int cols )
+{
+	if (g_bVideoPipelineActive)
+	{
+		g_nVideoPipelineTextCols = cols;	// Logged with the next video mode (see NTSC_VideoPipelineSetVideoMode())
+		return;
+	}
+
+	setVideoTextMode(cols);
+}
+
 //===========================================================================
 void NTSC_SetVideoMode( uint32_t uVideoModeFlags, bool bDelay/*=false*/ )
 {
+	videoPipelineStop();
+
 	if (bDelay && !g_bFullSpeed)
 	{
 		// (GH#670) NB. if g_bFullSpeed then NTSC_VideoUpdateCycles() won't be called on the next 6502 opcode.
@@ -1759,8 +2298,27 @@ void NTSC_SetVideoMode( uint32_t uVideoModeFlags, bool bDelay/*=false*/ )
 		return;
 	}
 
+	setVideoMode( uVideoModeFlags, VideoGetSWAltCharSet() ? 1 : 0 );
+}
+
+static void setVideoMode( uint32_t uVideoModeFlags, int nCharSet )
+{
 	g_nVideoMixed   = uVideoModeFlags & VF_MIXED;
-	g_nVideoCharSet = VideoGetSWAltCharSet() ? 1 : 0;
+	g_nVideoCharSet = nCharSet;
+
+	const uint32_t uOldScanlineModeKey = g_uScanlineModeKey;
+	g_uScanlineModeKey = (uVideoModeFlags & 0x7F)
+		| (g_nVideoCharSet << 7)
+		| ((g_pFuncUpdateTextScreen == updateScreenText80) ? (1<<8) : 0)
+		| (RGB_Is140Mode() ? (1<<9) : 0) | (RGB_Is160Mode() ? (1<<10) : 0) | (RGB_IsMixMode() ? (1<<11) : 0)
+		| (RGB_Is560Mode() ? (1<<12) : 0) | (RGB_IsMixModeInvertBit7() ? (1<<13) : 0);
+
+	// Mode changed part-way through a scanline: so it's a changed scanline on the next frame too
+	if (g_uScanlineModeKey != uOldScanlineModeKey &&
+		g_nVideoClockVert < VIDEO_SCANNER_Y_DISPLAY && g_nVideoClockHorz > VIDEO_SCANNER_HORZ_START)
+	{
+		g_aScanlineKey[g_nVideoClockVert] = SCANLINE_KEY_INVALID;
+	}
 
 	g_nTextPage  = 1;
 	g_nHiresPage = 1;
@@ -1836,6 +2394,8 @@ void NTSC_SetVideoMode( uint32_t uVideoModeFlags, bool bDelay/*=false*/ )
 
 void NTSC_SetVideoStyle() // (int v, int s)
 {
+	videoPipelineStop();
+
     int half = IsVideoStyle(VS_HALF_SCANLINES);
 	uint8_t r, g, b;
 
@@ -1928,19 +2488,28 @@ _mono:
 			}
 			break;
 		}
+
+	g_kernelBnWPixel = getPixelKernel(g_pFuncUpdateBnWPixel);
+	g_kernelHuePixel = getPixelKernel(g_pFuncUpdateHuePixel);
+
+	NTSC_VideoInvalidateScanlines();
 }
 
 //===========================================================================
 void GenerateVideoTables( void );
 void GenerateBaseColors(baseColors_t pBaseNtscColors);
+static void CheckPixelKernels( void );
 
 void NTSC_VideoInit( uint8_t* pFramebuffer ) // wsVideoInit
 {
+	videoPipelineStop();
+
 	make_csbits();
 	GenerateVideoTables();
 	initPixelDoubleMasks();
-	initChromaPhaseTables();
+	initChromaTables();
 	updateMonochromeTables( 0xFF, 0xFF, 0xFF );
+	CheckPixelKernels();	// Pre: chroma & monochrome tables
 
 	for (int y = 0; y < (VIDEO_SCANNER_Y_DISPLAY*2); y++)
 	{
@@ -2018,6 +2587,8 @@ void NTSC_VideoInit( uint8_t* pFramebuffer ) // wsVideoInit
 //===========================================================================
 void NTSC_VideoReinitialize( DWORD cyclesThisFrame, bool bInitVideoScannerAddress )
 {
+	videoPipelineStop();
+
 	_ASSERT(cyclesThisFrame < g_videoScanner6502Cycles);
 	if (cyclesThisFrame >= g_videoScanner6502Cycles) cyclesThisFrame = 0;	// error
 	g_nVideoClockVert = (uint16_t) (cyclesThisFrame / VIDEO_SCANNER_MAX_HORZ);
@@ -2030,6 +2601,8 @@ void NTSC_VideoReinitialize( DWORD cyclesThisFrame, bool bInitVideoScannerAddres
 //===========================================================================
 void NTSC_VideoInitAppleType ()
 {
+	videoPipelineStop();
+
 	int model = GetApple2Type();
 
 	// anything other than low bit set means not II/II+ (TC: include Pravets machines too?)
@@ -2039,12 +2612,16 @@ void NTSC_VideoInitAppleType ()
 		g_pHorzClockOffset = APPLE_IIP_HORZ_CLOCK_OFFSET;
 
 	set_csbits();
+	NTSC_VideoInvalidateScanlines();
 }
 
 //===========================================================================
 void NTSC_VideoInitChroma()
 {
-	initChromaPhaseTables();
+	videoPipelineStop();
+
+	initChromaTables();
+	NTSC_VideoInvalidateScanlines();
 }
 
 //===========================================================================
@@ -2102,6 +2679,7 @@ static void VideoUpdateCycles( int cyclesLeftToUpdate )
 void NTSC_VideoUpdateCycles( UINT cycles6502 )
 {
 	_ASSERT(cycles6502 && cycles6502 < g_videoScanner6502Cycles);	// Use NTSC_VideoRedrawWholeScreen() instead
+	_ASSERT(!g_bVideoPipelineActive);								// The render thread owns the video scanner
 
 	if (g_bDelayVideoMode)
 	{
@@ -2121,11 +2699,17 @@ void NTSC_VideoUpdateCycles( UINT cycles6502 )
 //===========================================================================
 void NTSC_VideoRedrawWholeScreen( void )
 {
+	videoPipelineStop();
+
 #ifdef _DEBUG
 	const uint16_t currVideoClockVert = g_nVideoClockVert;
 	const uint16_t currVideoClockHorz = g_nVideoClockHorz;
 #endif
 
+	// Not running (eg. debugger, logo): video memory may have been modified without setting memdirty[]
+	if (g_nAppMode != MODE_RUNNING)
+		NTSC_VideoInvalidateScanlines();
+
 	// (GH#405) For full-speed: whole screen updates will occur periodically
 	// . The V/H pos will have been recalc'ed, so won't be continuous from previous (whole screen) update
 	// . So the redraw must start at H-pos=0 & with the usual reinit for the start of a new line
@@ -2145,6 +2729,333 @@ void NTSC_VideoRedrawWholeScreen( void )
 
 //===========================================================================
 
+// Render a logged frame's scanlines from its start up to uEndCycle, from its copy of the video pages,
+// applying the mode changes & writes at their cycles
+static void videoPipelineRenderFrame( VideoFrame_t& frame, const UINT uEndCycle )
+{
+	g_pVideoMemMain   = frame.aMain;
+	g_pVideoMemAux    = frame.aAux;
+	g_pVideoPageDirty = frame.aPageDirty;
+
+	if (frame.bInvalidate)
+		invalidateScanlines();
+
+	UINT uCycle = frame.uStartCycle;
+	UINT iEvent = 0;
+	UINT iWrite = 0;
+	const UINT nEvents = frame.events.size();
+	const UINT nWrites = frame.writes.size();
+
+	while (iEvent < nEvents || iWrite < nWrites)
+	{
+		const UINT uEventCycle = (iEvent < nEvents) ? frame.events[iEvent].uCycle : 0xFFFFFFFF;
+		const UINT uWriteCycle = (iWrite < nWrites) ? frame.writes[iWrite].uCycle : 0xFFFFFFFF;
+		const UINT uNextCycle = min(uEventCycle, uWriteCycle);
+		if (uNextCycle > uCycle)
+		{
+			VideoUpdateCycles(uNextCycle - uCycle);
+			uCycle = uNextCycle;
+		}
+
+		if (uWriteCycle == uNextCycle)
+		{
+			const VideoWriteEvent_t& write = frame.writes[iWrite++];
+			(write.bAux ? frame.aAux : frame.aMain)[write.addr] = write.value;
+		}
+		else
+		{
+			const VideoModeEvent_t& event = frame.events[iEvent++];
+			setVideoTextMode(event.nTextCols);
+			if (!event.bTextModeOnly)
+				setVideoMode(event.uVideoModeFlags, event.nCharSet);
+		}
+	}
+
+	if (uEndCycle > uCycle)
+		VideoUpdateCycles(uEndCycle - uCycle);
+
+	g_pVideoMemMain   = NULL;
+	g_pVideoMemAux    = NULL;
+	g_pVideoPageDirty = NULL;
+}
+
+static DWORD WINAPI VideoRenderThread(LPVOID lpParameter)
+{
+	HANDLE hEvents[2] = {g_hVideoQuitEvent, g_hVideoFrameEvent};
+
+	while (WaitForMultipleObjects(2, hEvents, FALSE, INFINITE) == WAIT_OBJECT_0+1)
+	{
+		videoPipelineRenderFrame(g_aVideoFrame[g_nVideoFrameRender], g_videoScanner6502Cycles);
+		SetEvent(g_hVideoDoneEvent);
+	}
+
+	return 0;
+}
+
+static bool videoPipelineCreateThread()
+{
+	static bool bFailed = false;
+	if (bFailed)
+		return false;
+
+	g_hVideoFrameEvent = CreateEvent(NULL, FALSE, FALSE, NULL);	// Auto-reset
+	g_hVideoDoneEvent  = CreateEvent(NULL, FALSE, FALSE, NULL);	// Auto-reset
+	g_hVideoQuitEvent  = CreateEvent(NULL, TRUE, FALSE, NULL);	// Manual-reset
+
+	DWORD dwThreadId;
+	g_hVideoThread = CreateThread(NULL,				// lpThreadAttributes
+									0,				// dwStackSize
+									VideoRenderThread,
+									NULL,			// lpParameter
+									0,				// dwCreationFlags : 0 = Run immediately
+									&dwThreadId);	// lpThreadId
+
+	if (!g_hVideoThread)
+	{
+		LogFileOutput("NTSC: CreateThread() failed, video will be rendered by the CPU thread\n");
+		bFailed = true;
+		return false;
+	}
+
+	return true;
+}
+
+// Hand the render state back to the CPU thread: wait for the render thread, then render what's been logged of the current frame
+// so the video scanner is back at the CPU's position, and inline rendering (NTSC_VideoUpdateCycles()) can continue
+// Pre: not in CpuExecute(), so g_dwCyclesThisFrame is the CPU's position in the frame
+static void videoPipelineStop()
+{
+	if (!g_bVideoPipelineActive)
+		return;
+
+	NTSC_VideoPipelineWaitFrame();
+	g_bVideoPipelineActive = false;
+
+	VideoFrame_t& frame = g_aVideoFrame[g_nVideoFrameCpu];
+	for (UINT page = 0x04; page < 0x60; page++)
+		frame.aPageDirty[page] = memdirty[page] & MEMDIRTY_VIDEO;	// NB. Left set in memdirty[] for inline rendering
+
+	videoPipelineRenderFrame(frame, g_dwCyclesThisFrame);
+	frame.events.clear();
+	frame.writes.clear();
+	frame.bInvalidate = false;
+
+	setVideoTextMode(g_nVideoPipelineTextCols);
+}
+
+// Copy the video pages that have changed since this buffer last copied them, ie. it's then the start of a frame
+static void videoPipelineCopyPages( VideoFrame_t& frame )
+{
+	for (UINT page = 0x04; page < 0x60; page++)
+	{
+		const WORD addr = page << 8;
+		const uint8_t* pAux = MemGetAuxPtr(addr);
+
+		if (frame.aPageStale[page] || frame.apAuxSrc[page] != pAux)
+		{
+			memcpy(&frame.aMain[addr], MemGetMainPtr(addr), 0x100);
+			memcpy(&frame.aAux [addr], pAux, 0x100);
+			frame.aPageStale[page] = false;
+			frame.apAuxSrc[page] = pAux;
+		}
+	}
+}
+
+//===========================================================================
+
+// Called by the CPU thread before each CpuExecute(): returns true if the video pipeline is rendering (so no NTSC_VideoUpdateCycles())
+bool NTSC_VideoPipelineSetActive( bool bActive )
+{
+	if (g_eVideoType == VT_COLOR_MONITOR_RGB)
+		bActive = false;	// The RGB card's state isn't logged
+
+	if (bActive == g_bVideoPipelineActive)
+		return bActive;
+
+	if (!bActive)
+	{
+		videoPipelineStop();
+		return false;
+	}
+
+	if (!g_hVideoThread && !videoPipelineCreateThread())
+		return false;
+
+	// Memory may have been written since the copies were taken, without leaving MEMDIRTY_VIDEO set
+	for (UINT i = 0; i < 2; i++)
+		memset(g_aVideoFrame[i].aPageStale, true, sizeof(g_aVideoFrame[i].aPageStale));
+
+	VideoFrame_t& frame = g_aVideoFrame[g_nVideoFrameCpu];
+	videoPipelineCopyPages(frame);
+	frame.uStartCycle = g_dwCyclesThisFrame;
+	frame.bInvalidate = false;
+	frame.events.clear();
+	frame.writes.clear();
+
+	g_nVideoPipelineTextCols = (g_pFuncUpdateTextScreen == updateScreenText80) ? 80 : 40;
+	g_bVideoPipelineActive = true;
+
+	if (g_bDelayVideoMode)
+	{
+		g_bDelayVideoMode = false;
+		VideoModeEvent_t event = {g_dwCyclesThisFrame+1, g_uNewVideoModeFlags, VideoGetSWAltCharSet() ? 1 : 0, g_nVideoPipelineTextCols, false};
+		frame.events.push_back(event);
+	}
+
+	return true;
+}
+
+bool NTSC_VideoPipelineIsActive( void )
+{
+	return g_bVideoPipelineActive;
+}
+
+// Log a video mode change (instead of NTSC_SetVideoMode()) at the CPU's cycle in the frame
+void NTSC_VideoPipelineSetVideoMode( uint32_t uVideoModeFlags, bool bDelay, ULONG uExecutedCycles )
+{
+	_ASSERT(g_bVideoPipelineActive);
+	std::vector<VideoModeEvent_t>& events = g_aVideoFrame[g_nVideoFrameCpu].events;
+
+	VideoModeEvent_t event;
+	event.uCycle = CpuGetCyclesThisVideoFrame(uExecutedCycles);
+	event.uVideoModeFlags = uVideoModeFlags;
+	event.nCharSet = VideoGetSWAltCharSet() ? 1 : 0;
+	event.nTextCols = g_nVideoPipelineTextCols;
+	event.bTextModeOnly = bDelay;
+
+	if (bDelay)
+	{
+		events.push_back(event);
+		event.uCycle++;		// Video mode change is delayed by 1 cycle
+		event.bTextModeOnly = false;
+	}
+
+	events.push_back(event);
+}
+
+// Log a 6502 store to a video page ($0400-$0BFF or $2000-$5FFF) at its cycle in the frame
+// . called by the CPU's WRITE before the store, as pPage is memwrite[] for the page, ie. main or aux memory
+void NTSC_VideoPipelineWrite( uint16_t addr, uint8_t value, const uint8_t* pPage, UINT uCycle )
+{
+	_ASSERT(g_bVideoPipelineActive);
+
+	VideoWriteEvent_t write;
+	write.uCycle = uCycle;
+	write.addr = addr;
+	write.value = value;
+	write.prevValue = pPage[addr & 0xFF];
+	write.bAux = pPage != MemGetMainPtr(addr & 0xFF00);
+
+	g_aVideoFrame[g_nVideoFrameCpu].writes.push_back(write);
+}
+
+// Wait for the render thread to finish the last submitted frame, ie. it's now in the framebuffer
+void NTSC_VideoPipelineWaitFrame( void )
+{
+	if (!g_bVideoFrameRendering)
+		return;
+
+	WaitForSingleObject(g_hVideoDoneEvent, INFINITE);
+	g_bVideoFrameRendering = false;
+}
+
+// End of frame: have the render thread render this frame while the CPU emulates the next one,
+// and copy the video pages for the start of the next frame
+// Pre: NTSC_VideoPipelineWaitFrame()
+void NTSC_VideoPipelineSubmitFrame( void )
+{
+	_ASSERT(g_bVideoPipelineActive && !g_bVideoFrameRendering);
+
+	VideoFrame_t& frame = g_aVideoFrame[g_nVideoFrameCpu];
+	VideoFrame_t& next  = g_aVideoFrame[g_nVideoFrameCpu ^ 1];
+
+	// A page is only copied if it's changed since that buffer last copied it:
+	// . pages written this frame: in memory, and in this frame's copy when its writes are replayed
+	for (UINT page = 0x04; page < 0x60; page++)
+	{
+		const uint8_t dirty = memdirty[page] & MEMDIRTY_VIDEO;
+		memdirty[page] &= ~MEMDIRTY_VIDEO;
+
+		frame.aPageDirty[page] = dirty;
+		if (dirty)
+		{
+			frame.aPageStale[page] = true;
+			next.aPageStale[page] = true;
+		}
+	}
+
+	videoPipelineCopyPages(next);
+
+	// Mode changes & writes logged after the end of this frame (ie. during the last CpuExecute()) belong to the next frame
+	next.uStartCycle = 0;
+	next.bInvalidate = false;
+	next.events.clear();
+	next.writes.clear();
+
+	UINT i = 0;
+	while (i < frame.events.size() && frame.events[i].uCycle < g_videoScanner6502Cycles)
+		i++;
+
+	for (UINT j = i; j < frame.events.size(); j++)
+	{
+		next.events.push_back(frame.events[j]);
+		next.events.back().uCycle -= g_videoScanner6502Cycles;
+	}
+
+	frame.events.resize(i);
+
+	i = 0;
+	while (i < frame.writes.size() && frame.writes[i].uCycle < g_videoScanner6502Cycles)
+		i++;
+
+	for (UINT j = i; j < frame.writes.size(); j++)
+	{
+		next.writes.push_back(frame.writes[j]);
+		next.writes.back().uCycle -= g_videoScanner6502Cycles;
+	}
+
+	// The next frame's copy was taken after these writes, so undo them (last first) to get the start of the frame
+	for (UINT j = frame.writes.size(); j > i; j--)
+	{
+		const VideoWriteEvent_t& write = frame.writes[j-1];
+		(write.bAux ? next.aAux : next.aMain)[write.addr] = write.prevValue;
+	}
+
+	frame.writes.resize(i);
+
+	g_nVideoFrameRender = g_nVideoFrameCpu;
+	g_nVideoFrameCpu ^= 1;
+	g_bVideoFrameRendering = true;
+	SetEvent(g_hVideoFrameEvent);
+}
+
+void NTSC_VideoPipelineDestroy( void )
+{
+	// NB. Don't videoPipelineStop(), as memory may already have been freed
+	NTSC_VideoPipelineWaitFrame();
+	g_bVideoPipelineActive = false;
+
+	if (g_hVideoThread)
+	{
+		SetEvent(g_hVideoQuitEvent);
+		WaitForSingleObject(g_hVideoThread, INFINITE);
+		CloseHandle(g_hVideoThread);
+		g_hVideoThread = NULL;
+	}
+
+	HANDLE* aEvents[3] = {&g_hVideoFrameEvent, &g_hVideoDoneEvent, &g_hVideoQuitEvent};
+	for (UINT i = 0; i < 3; i++)
+	{
+		if (*aEvents[i])
+		{
+			CloseHandle(*aEvents[i]);
+			*aEvents[i] = NULL;
+		}
+	}
+}
+
+//===========================================================================
+
 static bool CheckVideoTables2( eApple2Type type, uint32_t mode )
 {
 	SetApple2Type(type);
@@ -2188,6 +3099,90 @@ static void CheckVideoTables( void )
 	CheckVideoTables2(A2TYPE_APPLE2E,    VF_TEXT);
 }
 
+//===========================================================================
+
+// Golden-image check: 14 pixels per cycle from the SSE2 kernel must match the scalar pixel function bit-exactly
+// (both the current & in-between scanlines, and the state carried to the next cycle)
+static bool CheckPixelKernels2( UpdatePixelFunc_t pFuncUpdatePixel, bool bTVMode1_29_1_0 )
+{
+	const UINT kNumRows = 5;	// previous, previous-inbetween, current, next-inbetween, next
+	const UINT kNumCycles = 40;
+	std::vector<uint32_t> frame[2];
+	int state[2][4];
+
+	g_VideoTVMode1_29_1_0 = bTVMode1_29_1_0;
+	g_pFuncUpdateBnWPixel = g_pFuncUpdateHuePixel = pFuncUpdatePixel;
+	g_kernelBnWPixel = g_kernelHuePixel = getPixelKernel(pFuncUpdatePixel);
+	g_nColorBurstPixels = 1024;
+
+	for (UINT pass = 0; pass < 2; pass++)	// 0=scalar, 1=SSE2
+	{
+		uint32_t seed = 0x12345678;
+		frame[pass].resize(kNumRows * g_kFrameBufferWidth);
+		for (UINT i = 0; i < frame[pass].size(); i++)
+		{
+			seed = seed * 1103515245 + 12345;
+			frame[pass][i] = seed;	// same "previous frame" for both passes
+		}
+
+		g_bVideoSSE2 = (pass == 1);
+		g_pVideoAddress = (bgra_t*) &frame[pass][2 * g_kFrameBufferWidth + 2];
+		g_nColorPhaseNTSC = INITIAL_COLOR_PHASE;
+		g_nSignalBitsNTSC = 0;
+		g_nLastColumnPixelNTSC = 0;
+
+		for (UINT cycle = 0; cycle < kNumCycles; cycle++)
+		{
+			seed = seed * 1103515245 + 12345;
+			updatePixels( (uint16_t)(seed >> 16) );
+		}
+
+		state[pass][0] = g_nColorPhaseNTSC;
+		state[pass][1] = g_nSignalBitsNTSC;
+		state[pass][2] = g_nLastColumnPixelNTSC;
+		state[pass][3] = (int) (g_pVideoAddress - (bgra_t*) &frame[pass][0]);
+	}
+
+	return frame[0] == frame[1] && memcmp(state[0], state[1], sizeof(state[0])) == 0;
+}
+
+static void CheckPixelKernels( void )
+{
+	g_bVideoSSE2 = false;
+	if (!IsProcessorFeaturePresent(PF_XMMI64_INSTRUCTIONS_AVAILABLE))
+		return;
+
+	const UpdatePixelFunc_t pFuncUpdatePixel[] =
+	{
+		updatePixelBnWMonitorSingleScanline, updatePixelBnWMonitorDoubleScanline,
+		updatePixelBnWColorTVSingleScanline, updatePixelBnWColorTVDoubleScanline,
+		updatePixelHueColorTVSingleScanline, updatePixelHueColorTVDoubleScanline,
+		updatePixelHueMonitorSingleScanline, updatePixelHueMonitorDoubleScanline,
+	};
+
+	const bool bTVMode1_29_1_0 = g_VideoTVMode1_29_1_0;
+	const int nColorBurstPixels = g_nColorBurstPixels;
+	bool bMatch = true;
+
+	for (UINT i = 0; i < sizeof(pFuncUpdatePixel)/sizeof(pFuncUpdatePixel[0]); i++)
+	{
+		bMatch &= CheckPixelKernels2(pFuncUpdatePixel[i], false);
+		bMatch &= CheckPixelKernels2(pFuncUpdatePixel[i], true);
+	}
+
+	_ASSERT(bMatch);
+	if (!bMatch)
+		LogFileOutput("NTSC: SSE2 pixel kernel doesn't match the scalar pixel functions - using scalar\n");
+
+	g_bVideoSSE2 = bMatch;
+	g_VideoTVMode1_29_1_0 = bTVMode1_29_1_0;
+
+	g_nColorBurstPixels = nColorBurstPixels;
+	g_nColorPhaseNTSC = INITIAL_COLOR_PHASE;
+	g_nSignalBitsNTSC = 0;
+	g_nLastColumnPixelNTSC = 0;
+}
+
 static bool IsNTSC(void)
 {
 	return g_videoScannerMaxVert == VIDEO_SCANNER_MAX_VERT;
@@ -2272,7 +3267,9 @@ static void GenerateVideoTables( void )
 
 	//
 
-	CheckVideoTables();
+#ifdef _DEBUG
+	CheckVideoTables();	// Only _ASSERTs: so don't spend the time in release builds (this runs at startup & on each NTSC/PAL switch)
+#endif
 
 //	VideoResetState();
 
@@ -2314,6 +3311,8 @@ static void GenerateBaseColors(baseColors_t pBaseNtscColors)
 
 void NTSC_SetRefreshRate(VideoRefreshRate_e rate)
 {
+	videoPipelineStop();
+
 	if (rate == VR_50HZ)
 	{
 		g_videoScannerMaxVert = VIDEO_SCANNER_MAX_VERT_PAL;
@@ -14,8 +14,16 @@
 	extern void     NTSC_VideoReinitialize( DWORD cyclesThisFrame, bool bInitVideoScannerAddress );
 	extern void     NTSC_VideoInitAppleType();
 	extern void     NTSC_VideoInitChroma();
+	extern void     NTSC_VideoInvalidateScanlines( void );
 	extern void     NTSC_VideoUpdateCycles( UINT cycles6502 );
 	extern void     NTSC_VideoRedrawWholeScreen( void );
+	extern bool     NTSC_VideoPipelineSetActive( bool bActive );
+	extern bool     NTSC_VideoPipelineIsActive( void );
+	extern void     NTSC_VideoPipelineSetVideoMode( uint32_t uVideoModeFlags, bool bDelay, ULONG uExecutedCycles );
+	extern void     NTSC_VideoPipelineWrite( uint16_t addr, uint8_t value, const uint8_t* pPage, UINT uCycle );
+	extern void     NTSC_VideoPipelineWaitFrame( void );
+	extern void     NTSC_VideoPipelineSubmitFrame( void );
+	extern void     NTSC_VideoPipelineDestroy( void );
 
 	enum VideoRefreshRate_e;
 	void NTSC_SetRefreshRate(VideoRefreshRate_e rate);
@@ -249,7 +249,7 @@ void Printer_SetFilename(char* prtFilename)
 		int nLen = sizeof(g_szPrintFilename) - strlen(g_szPrintFilename) - (sizeof(DEFAULT_PRINT_FILENAME)-1) - 1;
 		if (nLen < 0)
 		{
-			MessageBox(g_hFrameWindow, "Printer - SetFilename(): folder too deep", "Warning", MB_ICONWARNING | MB_OK);
+			FrameMessageBox("Printer - SetFilename(): folder too deep", "Warning", MB_ICONWARNING | MB_OK);
 			return;
 		}
 
@@ -117,5 +117,7 @@ void Clock_Util_ConvertTimeToProdos( tm *pTime, unsigned char *pProDosBytes4_ )
 void Clock_Generic_UpdateProDos()
 {
 	tm* pTime = Clock_Util_GetTime();
-	Clock_Util_ConvertTimeToProdos( pTime, &mem[ 0xBF90 ] ); // ProDos date/time buffer
+	LPBYTE pProDosDateTime = MemGetWritePtr( 0xBF90 ); // ProDos date/time buffer (NB. $BF90..$BF93 are within the same page)
+	if (pProDosDateTime)
+		Clock_Util_ConvertTimeToProdos( pTime, pProDosDateTime );
 }
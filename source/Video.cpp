@@ -98,6 +98,11 @@ static LPDIRECTDRAW g_lpDD = NULL;
 
 bool g_VideoTVMode1_29_1_0 = false;
 
+// Full-speed render-rate policy (see VideoRedrawScreenDuringFullSpeed())
+static UINT g_uFullSpeedMaxFps = 60;		// Redraw at most this many times per realtime second (0 = not until full-speed ends)
+static UINT g_uFullSpeedFrameInterval = 0;	// If non-zero: instead redraw every Nth emulated video frame
+static UINT g_uFullSpeedFramesSkipped = 0;	// Emulated video frames not redrawn since full-speed was entered
+
 //-------------------------------------
 
 	// NOTE: KEEP IN SYNC: VideoType_e g_aVideoChoices g_apVideoModeDesc
@@ -177,7 +182,8 @@ void VideoBenchmark () {
   // PREPARE TWO DIFFERENT FRAME BUFFERS, EACH OF WHICH HAVE HALF OF THE
   // BYTES SET TO 0x14 AND THE OTHER HALF SET TO 0xAA
   int     loop;
-  LPDWORD mem32 = (LPDWORD)mem;
+  LPBYTE  pMem  = MemGetMainPtr(0);	// Main RAM (the benchmark runs with main RAM paged in)
+  LPDWORD mem32 = (LPDWORD)pMem;
   for (loop = 4096; loop < 6144; loop++)
     *(mem32+loop) = ((loop & 1) ^ ((loop & 0x40) >> 6)) ? 0x14141414
                                                         : 0xAAAAAAAA;
@@ -191,7 +197,7 @@ void VideoBenchmark () {
   DWORD totaltextfps = 0;
 
   g_uVideoMode            = VF_TEXT;
-  FillMemory(mem+0x400,0x400,0x14);
+  FillMemory(pMem+0x400,0x400,0x14);
   VideoRedrawScreen();
   DWORD milliseconds = GetTickCount();
   while (GetTickCount() == milliseconds) ;
@@ -199,9 +205,9 @@ void VideoBenchmark () {
   DWORD cycle = 0;
   do {
     if (cycle & 1)
-      FillMemory(mem+0x400,0x400,0x14);
+      FillMemory(pMem+0x400,0x400,0x14);
     else
-      CopyMemory(mem+0x400,mem+((cycle & 2) ? 0x4000 : 0x6000),0x400);
+      CopyMemory(pMem+0x400,pMem+((cycle & 2) ? 0x4000 : 0x6000),0x400);
     VideoRefreshScreen();
     if (cycle++ >= 3)
       cycle = 0;
@@ -213,7 +219,7 @@ void VideoBenchmark () {
   // SIMULATE THE ACTIVITY OF AN AVERAGE GAME
   DWORD totalhiresfps = 0;
   g_uVideoMode             = VF_HIRES;
-  FillMemory(mem+0x2000,0x2000,0x14);
+  FillMemory(pMem+0x2000,0x2000,0x14);
   VideoRedrawScreen();
   milliseconds = GetTickCount();
   while (GetTickCount() == milliseconds) ;
@@ -221,9 +227,9 @@ void VideoBenchmark () {
   cycle = 0;
   do {
     if (cycle & 1)
-      FillMemory(mem+0x2000,0x2000,0x14);
+      FillMemory(pMem+0x2000,0x2000,0x14);
     else
-      CopyMemory(mem+0x2000,mem+((cycle & 2) ? 0x4000 : 0x6000),0x2000);
+      CopyMemory(pMem+0x2000,pMem+((cycle & 2) ? 0x4000 : 0x6000),0x2000);
     VideoRefreshScreen();
     if (cycle++ >= 3)
       cycle = 0;
@@ -245,6 +251,10 @@ void VideoBenchmark () {
 	  } while (GetTickCount() - milliseconds < 1000);
   }
 
+  // DETERMINE HOW MANY MEMORY BANK SWITCHES (RAMRD/RAMWRT, RAMWORKS III OR
+  // LANGUAGE CARD) WE CAN DO PER SECOND
+  const DWORD totalbankswitches = MemBenchmarkBankSwitch(1000000);
+
   // IF THE PROGRAM COUNTER IS NOT IN THE EXPECTED RANGE AT THE END OF THE
   // CPU BENCHMARK, REPORT AN ERROR AND OPTIONALLY TRACK IT DOWN
   if ((regs.pc < 0x300) || (regs.pc > 0x400))
@@ -297,7 +307,7 @@ void VideoBenchmark () {
   // WITH FULL EMULATION OF THE CPU, JOYSTICK, AND DISK HAPPENING AT
   // THE SAME TIME
   DWORD realisticfps = 0;
-  FillMemory(mem+0x2000,0x2000,0xAA);
+  FillMemory(pMem+0x2000,0x2000,0xAA);
   VideoRedrawScreen();
   milliseconds = GetTickCount();
   while (GetTickCount() == milliseconds) ;
@@ -314,9 +324,9 @@ void VideoBenchmark () {
 	  }
     }
     if (cycle & 1)
-      FillMemory(mem+0x2000,0x2000,0xAA);
+      FillMemory(pMem+0x2000,0x2000,0xAA);
     else
-      CopyMemory(mem+0x2000,mem+((cycle & 2) ? 0x4000 : 0x6000),0x2000);
+      CopyMemory(pMem+0x2000,pMem+((cycle & 2) ? 0x4000 : 0x6000),0x2000);
     VideoRedrawScreen();
     if (cycle++ >= 3)
       cycle = 0;
@@ -329,13 +339,15 @@ void VideoBenchmark () {
   wsprintf(outstr,
            TEXT("Pure Video FPS:\t%u hires, %u text\n")
            TEXT("Pure CPU MHz:\t%u.%u%s (video update)\n")
-           TEXT("Pure CPU MHz:\t%u.%u%s (full-speed)\n\n")
+           TEXT("Pure CPU MHz:\t%u.%u%s (full-speed)\n")
+           TEXT("Bank switches/sec:\t%u\n\n")
            TEXT("EXPECTED AVERAGE VIDEO GAME\n")
            TEXT("PERFORMANCE: %u FPS"),
            (unsigned)totalhiresfps,
            (unsigned)totaltextfps,
            (unsigned)(totalmhz10[0] / 10), (unsigned)(totalmhz10[0] % 10), (LPCTSTR)(IS_APPLE2 ? TEXT(" (6502)") : TEXT("")),
            (unsigned)(totalmhz10[1] / 10), (unsigned)(totalmhz10[1] % 10), (LPCTSTR)(IS_APPLE2 ? TEXT(" (6502)") : TEXT("")),
+           (unsigned)totalbankswitches,
            (unsigned)realisticfps);
   MessageBox(g_hFrameWindow,
              outstr,
@@ -369,6 +381,8 @@ void VideoChooseMonochromeColor ()
 //===========================================================================
 void VideoDestroy () {
 
+  NTSC_VideoPipelineDestroy();	// Render thread writes to the frame buffer
+
   // DESTROY BUFFERS
   VirtualFree(g_pFramebufferinfo,0,MEM_RELEASE);
   g_pFramebufferinfo = NULL;
@@ -482,6 +496,7 @@ void VideoDisplayLogo ()
 void VideoRedrawScreenDuringFullSpeed(DWORD dwCyclesThisFrame, bool bInit /*=false*/)
 {
 	static DWORD dwFullSpeedStartTime = 0;
+	static UINT uFullSpeedFrames = 0;
 //	static bool bValid = false;
 
 	if (bInit)
@@ -489,14 +504,39 @@ void VideoRedrawScreenDuringFullSpeed(DWORD dwCyclesThisFrame, bool bInit /*=fal
 		// Just entered full-speed mode
 //		bValid = false;
 		dwFullSpeedStartTime = GetTickCount();
+		uFullSpeedFrames = 0;
+		g_uFullSpeedFramesSkipped = 0;
 		return;
 	}
 
-	DWORD dwFullSpeedDuration = GetTickCount() - dwFullSpeedStartTime;
-	if (dwFullSpeedDuration <= 16)	// Only update after every realtime ~17ms of *continuous* full-speed
-		return;
+	if (g_uFullSpeedFrameInterval)
+	{
+		// Emulated-time policy: independent of how fast the host is
+		if (++uFullSpeedFrames < g_uFullSpeedFrameInterval)
+		{
+			g_uFullSpeedFramesSkipped++;
+			return;
+		}
 
-	dwFullSpeedStartTime += dwFullSpeedDuration;
+		uFullSpeedFrames = 0;
+	}
+	else
+	{
+		if (g_uFullSpeedMaxFps == 0)	// Video is only redrawn when full-speed ends
+		{
+			g_uFullSpeedFramesSkipped++;
+			return;
+		}
+
+		DWORD dwFullSpeedDuration = GetTickCount() - dwFullSpeedStartTime;
+		if (dwFullSpeedDuration <= 1000 / g_uFullSpeedMaxFps)	// Only update after every realtime ~17ms (default) of *continuous* full-speed
+		{
+			g_uFullSpeedFramesSkipped++;
+			return;
+		}
+
+		dwFullSpeedStartTime += dwFullSpeedDuration;
+	}
 
 	//
 
@@ -545,6 +585,23 @@ void VideoRedrawScreenDuringFullSpeed(DWORD dwCyclesThisFrame, bool bInit /*=fal
 
 //===========================================================================
 
+void VideoSetFullSpeedMaxFps(const UINT uMaxFps)
+{
+	g_uFullSpeedMaxFps = uMaxFps;
+}
+
+void VideoSetFullSpeedFrameInterval(const UINT uFrameInterval)
+{
+	g_uFullSpeedFrameInterval = uFrameInterval;
+}
+
+UINT VideoGetFullSpeedFramesSkipped(void)
+{
+	return g_uFullSpeedFramesSkipped;
+}
+
+//===========================================================================
+
 void VideoRedrawScreenAfterFullSpeed(DWORD dwCyclesThisFrame)
 {
 	NTSC_VideoClockResync(dwCyclesThisFrame);
@@ -683,7 +740,10 @@ BYTE VideoSetMode(WORD, WORD address, BYTE write, BYTE, ULONG uExecutedCycles)
 	if ((oldVideoMode ^ g_uVideoMode) & VF_PAGE2)
 		delay = false;	// PAGE2 flag changed state, so no 1 cycle delay (GH#656)
 
-	NTSC_SetVideoMode( g_uVideoMode, delay );
+	if (NTSC_VideoPipelineIsActive())
+		NTSC_VideoPipelineSetVideoMode( g_uVideoMode, delay, uExecutedCycles );	// Rendered later, by the render thread
+	else
+		NTSC_SetVideoMode( g_uVideoMode, delay );
 
 	return MemReadFloatingBus(uExecutedCycles);
 }
@@ -907,6 +967,20 @@ bool VideoGetVblBar(const DWORD uExecutedCycles)
 	return nCycles < kVDisplayableScanLines * kHClocks;
 }
 
+// Used to schedule the next VBL' edge (instead of polling VideoGetVblBar())
+DWORD VideoGetCyclesUntilVblChange(const DWORD uExecutedCycles)
+{
+	int nCycles = CpuGetCyclesThisVideoFrame(uExecutedCycles);
+
+	const int kScanLines  = g_bVideoScannerNTSC ? kNTSCScanLines : kPALScanLines;
+	const int kScanCycles = kScanLines * kHClocks;
+	const int kVblCycle   = kVDisplayableScanLines * kHClocks;
+	nCycles %= kScanCycles;
+
+	return (nCycles < kVblCycle) ? kVblCycle - nCycles		// VBL' -> VBL
+								 : kScanCycles - nCycles;	// VBL -> VBL'
+}
+
 //===========================================================================
 
 #define MAX_DRAW_DEVICES 10
@@ -1031,7 +1105,7 @@ void Video_TakeScreenShot( const VideoScreenShot_e ScreenShotType )
 		{
 			TCHAR msg[512];
 			StringCbPrintf( msg, 512, "You have more then %d screenshot filenames!  They will no longer be saved.\n\nEither move some of your screenshots or increase the maximum in video.cpp\n", nMaxScreenShot );
-			MessageBox( g_hFrameWindow, msg, "Warning", MB_OK );
+			FrameMessageBox( msg, "Warning", MB_OK );
 			g_nLastScreenShot = 0;
 			return;
 		}
@@ -1228,7 +1302,7 @@ static void Video_SaveScreenShot( const VideoScreenShot_e ScreenShotType, const
 
 	if( g_bDisplayPrintScreenFileName )
 	{
-		MessageBox( g_hFrameWindow, pScreenShotFileName, "Screen Captured", MB_OK );
+		FrameMessageBox( pScreenShotFileName, "Screen Captured", MB_OK );
 	}
 }
 
@@ -182,6 +182,9 @@ void    VideoDisplayLogo ();
 void    VideoInitialize ();
 void    VideoRedrawScreenDuringFullSpeed(DWORD dwCyclesThisFrame, bool bInit = false);
 void    VideoRedrawScreenAfterFullSpeed(DWORD dwCyclesThisFrame);
+void    VideoSetFullSpeedMaxFps(const UINT uMaxFps);
+void    VideoSetFullSpeedFrameInterval(const UINT uFrameInterval);
+UINT    VideoGetFullSpeedFramesSkipped(void);
 void    VideoRedrawScreen (void);
 void    VideoRefreshScreen (uint32_t uRedrawWholeScreenVideoMode = 0, bool bRedrawWholeScreen = false);
 void    VideoReinitialize (bool bInitVideoScannerAddress = true);
@@ -189,6 +192,7 @@ void    VideoResetState ();
 enum VideoScanner_e {VS_FullAddr, VS_PartialAddrV, VS_PartialAddrH};
 WORD    VideoGetScannerAddress(DWORD nCycles, VideoScanner_e videoScannerAddr = VS_FullAddr);
 bool    VideoGetVblBar(DWORD uExecutedCycles);
+DWORD   VideoGetCyclesUntilVblChange(DWORD uExecutedCycles);
 
 bool    VideoGetSW80COL(void);
 bool    VideoGetSWDHIRES(void);
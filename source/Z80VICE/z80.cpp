@@ -6392,7 +6392,7 @@ BYTE z80_RDMEM(WORD Addr)
 			}
 			else
 			{
-				return *(mem+addr);
+				return *MemGetReadPtr(addr);
 			}
 		break;
 
@@ -9,8 +9,9 @@ bool g_bFullSpeed = false;
 enum AppMode_e g_nAppMode = MODE_RUNNING;
 
 // From Memory.cpp
+LPBYTE         memread[0x100];		// TODO: Init
 LPBYTE         memwrite[0x100];		// TODO: Init
-LPBYTE         mem          = NULL;	// TODO: Init
+LPBYTE         mem          = NULL;	// Flat 64K RAM: memread[] & memwrite[] both map to this
 LPBYTE         memdirty     = NULL;	// TODO: Init
 iofunction		IORead[256] = {0};	// TODO: Init
 iofunction		IOWrite[256] = {0};	// TODO: Init
@@ -54,7 +55,7 @@ static __forceinline void DoIrqProfiling(DWORD uCycles)
 {
 }
 
-static __forceinline void CheckInterruptSources(ULONG uExecutedCycles, const bool bVideoUpdate)
+static __forceinline void CheckInterruptSources(ULONG uExecutedCycles)
 {
 }
 
@@ -66,6 +67,47 @@ static __forceinline void IRQ(ULONG& uExecutedCycles, BOOL& flagc, BOOL& flagn,
 {
 }
 
+static __forceinline bool IsFastDiskTrap(const WORD pc)
+{
+	return false;
+}
+
+static bool CpuFastDiskTrap(ULONG& uExecutedCycles, BOOL& flagc, BOOL& flagn, BOOL& flagz)
+{
+	return false;
+}
+
+static __forceinline void CpuDiskAccel(ULONG& uExecutedCycles, const ULONG uPreviousCycles, const WORD uOpcodePC)
+{
+}
+
+// From CPU.cpp (for cpu_general.inl)
+static bool g_bCpuVideoLog = false;
+
+// From CPU.cpp (for cpu_idleloop.inl)
+static bool g_bIdleLoopSkip = false;
+static ULONG g_uIdleLoopEndCycle = 0;
+static ULONG g_uNextEventCycle = 0;
+static UINT32 g_bmIRQ = 0;
+static BOOL g_bNmiFlank = FALSE;
+
+// From Applewin.cpp
+eApple2Type g_Apple2Type = A2TYPE_APPLE2EENHANCED;
+
+// From Keyboard.cpp
+bool KeybIsIdle(void)
+{
+	return true;
+}
+
+// From Video.cpp
+static ULONG g_uTestVblChangeCycle = 0;
+
+DWORD VideoGetCyclesUntilVblChange(DWORD uExecutedCycles)
+{
+	return (uExecutedCycles < g_uTestVblChangeCycle) ? g_uTestVblChangeCycle - uExecutedCycles : 17030;
+}
+
 // From z80.cpp
 DWORD z80_mainloop(ULONG uTotalCycles, ULONG uExecutedCycles)
 {
@@ -77,19 +119,46 @@ void NTSC_VideoUpdateCycles( long cycles6502 )
 {
 }
 
+struct VideoLogWrite_t
+{
+	WORD addr;
+	BYTE value;
+	BYTE prevValue;
+	UINT uCycle;
+};
+
+static const UINT kMaxVideoLogWrites = 16;
+static VideoLogWrite_t g_aVideoLogWrites[kMaxVideoLogWrites];
+static UINT g_uVideoLogWrites = 0;
+
+void NTSC_VideoPipelineWrite( WORD addr, BYTE value, const BYTE* pPage, UINT uCycle )
+{
+	if (g_uVideoLogWrites == kMaxVideoLogWrites)
+		return;
+
+	VideoLogWrite_t& write = g_aVideoLogWrites[g_uVideoLogWrites++];
+	write.addr = addr;
+	write.value = value;
+	write.prevValue = pPage[addr & 0xFF];
+	write.uCycle = uCycle;
+}
+
 //-------------------------------------
 
 #include "../../source/CPU/cpu_general.inl"
 #include "../../source/CPU/cpu_instructions.inl"
+#include "../../source/CPU/cpu_idleloop.inl"
+#include "../../source/CPU/cpu_core.h"  // Policy-based 6502 & 65C02 core
 #include "../../source/CPU/cpu6502.h"  // MOS 6502
 #include "../../source/CPU/cpu65C02.h"  // WDC 65C02
+#include "../../source/CPU/cpu_predecode.h"  // Pre-decoded 6502 & 65C02
 
 void init(void)
 {
 	mem = (LPBYTE)VirtualAlloc(NULL,64*1024,MEM_COMMIT,PAGE_READWRITE);
 
 	for (UINT i=0; i<256; i++)
-		memwrite[i] = mem+i*256;
+		memread[i] = memwrite[i] = mem+i*256;
 
 	memdirty = new BYTE[256];
 }
@@ -1094,6 +1163,215 @@ int GH292_test(void)
 
 //-------------------------------------
 
+// Pre-decoded core must match the switch core: cycles, registers & memory
+// . includes page-crossing, an uncached opcode ($03FF) and self-modifying code
+
+const BYTE g_predecode_code[] =
+{
+// org $0300
+0xA2, 0x20,			//   ldx #$20
+0xA0, 0xF0,			//   ldy #$F0
+0xF8,				//   sed
+0x18,				// l1: clc
+0xBD, 0xF0, 0x03,	//   lda $03f0,x	; page-cross when x >= $10
+0x71, 0x80,			//   adc ($80),y	; page-cross
+0x9D, 0x00, 0x05,	//   sta $0500,x
+0x8D, 0x12, 0x03,	//   sta l2+1		; modify the very next opcode's operand
+0x69, 0x00,			// l2: adc #0
+0x20, 0xFD, 0x03,	//   jsr $03fd
+0xC8,				//   iny
+0xCA,				//   dex
+0xD0, 0xEB,			//   bne l1
+0xD8,				//   cld
+0x4C, 0x1B, 0x03	// l3: jmp l3
+};
+
+const BYTE g_predecode_sub[] =
+{
+// org $03fd
+0xE6, 0x81,			//   inc $81
+0xEA,				//   nop
+0x60				//   rts
+};
+
+void predecode_init(void)
+{
+	reset();
+	memset(mem, 0, 64*1024);
+	for (UINT i=0x0401; i<0x2500; i++)
+		mem[i] = (BYTE) (i*13);
+
+	memcpy(mem+0x0300, g_predecode_code, sizeof(g_predecode_code));
+	memcpy(mem+0x03FD, g_predecode_sub, sizeof(g_predecode_sub));
+	mem[0x80] = 0xF0;
+	mem[0x81] = 0x04;
+
+	memset(memdirty, 0, 256);
+	PredecodeInvalidateAll();
+}
+
+int predecode_compare(DWORD (*pfnCpu)(DWORD), const PredecodeHandler* pHandlers)
+{
+	const DWORD kCycles = 5000;
+	LPBYTE pMemExpected = new BYTE[64*1024];
+
+	predecode_init();
+	const DWORD cyclesExpected = pfnCpu(kCycles);
+	const regsrec regsExpected = regs;
+	memcpy(pMemExpected, mem, 64*1024);
+
+	predecode_init();
+	const DWORD cycles = CpuPredecoded(kCycles, true, pHandlers);
+
+	int res = 0;
+	if (cycles != cyclesExpected) res = 1;
+	if (regs.a != regsExpected.a || regs.x != regsExpected.x || regs.y != regsExpected.y) res = 1;
+	if (regs.ps != regsExpected.ps || regs.pc != regsExpected.pc || regs.sp != regsExpected.sp) res = 1;
+	if (memcmp(pMemExpected, mem, 64*1024) != 0) res = 1;
+
+	delete [] pMemExpected;
+	return res;
+}
+
+int Predecode_test(void)
+{
+	if (predecode_compare(TestCpu6502, Predecode6502::g_aHandlers)) return 1;
+	if (predecode_compare(TestCpu65C02, Predecode65C02::g_aHandlers)) return 1;
+
+	// Cached records must be discarded when mem[] is modified
+	predecode_init();
+	mem[0x0400] = 0xEA;	// nop
+	mem[0x0401] = 0x00;	// brk
+	regs.pc = 0x0400;
+	if (CpuPredecoded(0, true, Predecode65C02::g_aHandlers) != 2 || regs.pc != 0x0401) return 1;
+
+	mem[0x0400] = 0xE8;	// inx (without setting memdirty[]: record is stale)
+	regs.pc = 0x0400;
+	CpuPredecoded(0, true, Predecode65C02::g_aHandlers);
+	if (regs.x != 0) return 1;
+
+	memdirty[0x04] |= MEMDIRTY_PREDECODE;
+	regs.pc = 0x0400;
+	CpuPredecoded(0, true, Predecode65C02::g_aHandlers);
+	if (regs.x != 1) return 1;
+
+	reset();
+	return 0;
+}
+
+// Basic blocks: no interrupts, so same end state (but may overrun the requested cycles by up to a block)
+int predecode_blocks_compare(DWORD (*pfnCpu)(DWORD), const PredecodeHandler* pHandlers)
+{
+	const DWORD kCycles = 5000;
+	LPBYTE pMemExpected = new BYTE[64*1024];
+
+	predecode_init();
+	pfnCpu(kCycles);
+	const regsrec regsExpected = regs;
+	memcpy(pMemExpected, mem, 64*1024);
+
+	predecode_init();
+	const DWORD cycles = CpuPredecodedBlocks(kCycles, pHandlers);
+
+	int res = 0;
+	if (cycles < kCycles) res = 1;
+	if (regs.a != regsExpected.a || regs.x != regsExpected.x || regs.y != regsExpected.y) res = 1;
+	if (regs.ps != regsExpected.ps || regs.pc != regsExpected.pc || regs.sp != regsExpected.sp) res = 1;
+	if (memcmp(pMemExpected, mem, 64*1024) != 0) res = 1;
+
+	delete [] pMemExpected;
+	return res;
+}
+
+int PredecodeBlocks_test(void)
+{
+	if (predecode_blocks_compare(TestCpu6502, Predecode6502::g_aHandlers)) return 1;
+	if (predecode_blocks_compare(TestCpu65C02, Predecode65C02::g_aHandlers)) return 1;
+
+	// Block ends at a control-flow opcode
+	predecode_init();
+	mem[0x0400] = 0xE8;	// inx
+	mem[0x0401] = 0xE8;	// inx
+	mem[0x0402] = 0xC8;	// iny
+	mem[0x0403] = 0x4C; mem[0x0404] = 0x00; mem[0x0405] = 0x04;	// jmp $0400
+	regs.pc = 0x0400;
+	if (CpuPredecodedBlocks(0, Predecode65C02::g_aHandlers) != 2+2+2+3 || regs.pc != 0x0400) return 1;	// record
+	if (g_aBlockLength[0x0400] != 4) return 1;
+	if (CpuPredecodedBlocks(0, Predecode65C02::g_aHandlers) != 2+2+2+3 || regs.x != 4 || regs.y != 2) return 1;	// replay
+
+	// Block exits early on an I/O access
+	IORead[0] = fn_C000;
+	const int count = g_fn_C000_count;
+	predecode_init();
+	mem[0x0400] = 0xAD; mem[0x0401] = 0x00; mem[0x0402] = 0xC0;	// lda $c000
+	mem[0x0403] = 0xEA;	// nop
+	mem[0x0404] = 0x00;	// brk
+	regs.pc = 0x0400;
+	if (CpuPredecodedBlocks(0, Predecode65C02::g_aHandlers) != 4 || regs.pc != 0x0403 || regs.a != 42) return 1;
+	if (g_fn_C000_count != count+1) return 1;
+	IORead[0] = NULL;
+
+	reset();
+	return 0;
+}
+
+//-------------------------------------
+
+const BYTE g_videolog_code[] =
+{
+// org $0300
+0xA9, 0x41,			// lda #$41
+0x8D, 0x00, 0x04,	// sta $0400	; text page
+0x8D, 0x00, 0x03,	// sta $0300
+0x8D, 0x00, 0x20,	// sta $2000	; hires page
+0x8D, 0x00, 0x60,	// sta $6000
+0x00				// brk
+};
+
+void videolog_init(void)
+{
+	reset();
+	memcpy(&mem[regs.pc], g_videolog_code, sizeof(g_videolog_code));
+	mem[0x0400] = 0x11;
+	mem[0x2000] = 0x22;
+	g_uVideoLogWrites = 0;
+}
+
+int VideoLog_test(void)
+{
+	const DWORD kCycles = 2+4+4+4+4-1;	// stop before the brk
+
+	// Only stores to the video pages are logged, before the store & with the opcode's frame-relative cycle
+	g_dwCyclesThisFrame = 100;
+	videolog_init();
+	if (CpuCore<CPU_65C02, false, true, false, false, true>(kCycles) != kCycles+1) return 1;
+	if (g_uVideoLogWrites != 2) return 1;
+	if (g_aVideoLogWrites[0].addr != 0x0400 || g_aVideoLogWrites[0].value != 0x41 || g_aVideoLogWrites[0].prevValue != 0x11) return 1;
+	if (g_aVideoLogWrites[1].addr != 0x2000 || g_aVideoLogWrites[1].value != 0x41 || g_aVideoLogWrites[1].prevValue != 0x22) return 1;
+	if (g_aVideoLogWrites[0].uCycle != 100+2 || g_aVideoLogWrites[1].uCycle != 100+2+4+4) return 1;
+	if (mem[0x0400] != 0x41 || mem[0x2000] != 0x41) return 1;
+	g_dwCyclesThisFrame = 0;
+
+	// Not logged by the other cores, unless enabled at run-time
+	videolog_init();
+	TestCpu65C02(kCycles);
+	if (g_uVideoLogWrites != 0) return 1;
+
+	g_bCpuVideoLog = true;
+	videolog_init();
+	memset(memdirty, 0, 256);
+	PredecodeInvalidateAll();
+	CpuPredecoded(kCycles, false, Predecode6502::g_aHandlers);
+	g_bCpuVideoLog = false;
+	if (g_uVideoLogWrites != 2) return 1;
+	if (g_aVideoLogWrites[0].uCycle != 2 || g_aVideoLogWrites[1].uCycle != 2+4+4) return 1;
+
+	reset();
+	return 0;
+}
+
+//-------------------------------------
+
 const BYTE g_GH321_code[] =
 {
 // org $f156
@@ -1240,6 +1518,254 @@ int GH321_test()
 	return mem[0x000a] == 0 ? 1 : 0;
 }
 
+//-------------------------------------
+// Lazy N & Z flags (see LAZY_FLAGS): check the flags seen by PHP/BRK/IRQ (EF_TO_AF) and by the branches
+
+void flags_run(DWORD (*pfnCpu)(DWORD), BYTE op, BYTE a, BYTE m, BYTE ps)
+{
+	reset();
+	mem[regs.pc+0] = op;	// OPCODE #imm
+	mem[regs.pc+1] = m;
+	regs.a = a;
+	regs.ps = ps;
+	pfnCpu(0);
+}
+
+// Checksum of A & P after ADC #imm & SBC #imm, for all A, operand, carry & decimal mode
+UINT flags_adc_sbc_checksum(DWORD (*pfnCpu)(DWORD))
+{
+	const BYTE op[] = {0x69,0xE9};	// ADC #imm, SBC #imm
+	UINT checksum = 0;
+
+	for (UINT i = 0; i<sizeof(op); i++)
+		for (UINT ps = 0; ps < 4; ps++)
+			for (UINT a = 0; a < 256; a++)
+				for (UINT m = 0; m < 256; m++)
+				{
+					flags_run(pfnCpu, op[i], a, m, ((ps & 1) ? AF_CARRY : 0) | ((ps & 2) ? AF_DECIMAL : 0));
+					checksum = checksum * 31 + ((regs.a << 8) | regs.ps);
+				}
+
+	return checksum;
+}
+
+int Flags_test(void)
+{
+	const BYTE kNZ = AF_SIGN | AF_ZERO;
+
+	// Decimal mode: NMOS N & Z are from the binary result, CMOS N & Z are from the decimal result
+	flags_run(TestCpu6502, 0x69, 0x99, 0x01, AF_DECIMAL);	// ADC #$01
+	if (regs.a != 0x00 || (regs.ps & (kNZ|AF_CARRY)) != (AF_SIGN|AF_CARRY)) return 1;
+
+	flags_run(TestCpu65C02, 0x69, 0x99, 0x01, AF_DECIMAL);
+	if (regs.a != 0x00 || (regs.ps & (kNZ|AF_CARRY)) != (AF_ZERO|AF_CARRY)) return 1;
+
+	flags_run(TestCpu6502, 0xE9, 0x00, 0x01, AF_DECIMAL|AF_CARRY);	// SBC #$01
+	if (regs.a != 0x99 || (regs.ps & AF_CARRY)) return 1;
+
+	flags_run(TestCpu65C02, 0xE9, 0x00, 0x01, AF_DECIMAL|AF_CARRY);
+	if (regs.a != 0x99 || (regs.ps & AF_CARRY)) return 1;
+
+	// Same results as eager N & Z flags (checksums generated with LAZY_FLAGS disabled)
+	if (flags_adc_sbc_checksum(TestCpu6502) != 0x2CFA19A4) return 1;
+	if (flags_adc_sbc_checksum(TestCpu65C02) != 0xECC93B42) return 1;
+
+	// BIT: N & Z are set independently (N=1 & Z=1 can't be the result of a single value)
+	reset();
+	mem[0x0300] = 0x24;	// bit $f0
+	mem[0x0301] = 0xf0;
+	mem[0x0302] = 0x30;	// bmi +1
+	mem[0x0303] = 0x01;
+	mem[0x0304] = 0x00;	// brk
+	mem[0x0305] = 0xf0;	// beq +1
+	mem[0x0306] = 0x01;
+	mem[0x0307] = 0x00;	// brk
+	mem[0x0308] = 0xea;	// nop
+	mem[0x00f0] = 0xc0;
+	TestCpu6502(0);
+	if ((regs.ps & (kNZ|AF_OVERFLOW)) != (kNZ|AF_OVERFLOW)) return 1;
+	TestCpu6502(0);
+	TestCpu6502(0);
+	if (regs.pc != 0x0308) return 1;
+
+	// PLP then branch: flags restored from P (AF_TO_EF)
+	reset();
+	mem[0x01ff] = AF_ZERO;
+	regs.sp = 0x1fe;
+	mem[0x0300] = 0x28;	// plp
+	mem[0x0301] = 0xd0;	// bne +1 (not taken)
+	mem[0x0302] = 0x01;
+	mem[0x0303] = 0x10;	// bpl +1 (taken)
+	mem[0x0304] = 0x01;
+	mem[0x0305] = 0x00;	// brk
+	mem[0x0306] = 0xea;	// nop
+	TestCpu65C02(0);
+	TestCpu65C02(0);
+	TestCpu65C02(0);
+	if (regs.pc != 0x0306) return 1;
+
+	reset();
+	return 0;
+}
+
+//-------------------------------------
+// Idle-loop skipping must exit the loop at the same cycle, with the same registers, flags & memory, as emulating every iteration
+
+const ULONG kIdleLoopChangeCycle = 5000;	// Cycle at which the polled soft switch changes
+const ULONG kIdleLoopTotalCycles = 6000;
+
+UINT  g_uIdleLoopReads = 0;
+ULONG g_uIdleLoopLastReadCycle = 0;
+
+// $C000: key arrives at kIdleLoopChangeCycle (which is also the next scheduled event)
+BYTE __stdcall fn_IdleLoop_C000(WORD, WORD, BYTE, BYTE, ULONG uExecutedCycles)
+{
+	g_uIdleLoopReads++;
+	g_uIdleLoopLastReadCycle = uExecutedCycles;
+	return (uExecutedCycles >= kIdleLoopChangeCycle) ? 0xC1 : 0x41;
+}
+
+// $C019: VBL' (bit 7) changes at kIdleLoopChangeCycle, but the floating bus (bits 0-6) changes earlier
+BYTE __stdcall fn_IdleLoop_C019(WORD, WORD nAddr, BYTE, BYTE, ULONG uExecutedCycles)
+{
+	if (nAddr != 0xC019)
+		return 0;
+
+	g_uIdleLoopReads++;
+	g_uIdleLoopLastReadCycle = uExecutedCycles;
+	const BYTE floatingBus = (uExecutedCycles >= kIdleLoopChangeCycle/2) ? 0x40 : (BYTE)(uExecutedCycles & 0x3F);
+	return ((uExecutedCycles >= kIdleLoopChangeCycle) ? 0x80 : 0x00) | floatingBus;
+}
+
+struct IdleLoopResult
+{
+	DWORD uCycles;
+	UINT  uReads;
+	ULONG uLastReadCycle;
+	regsrec regs;
+	BYTE  zp[2];
+};
+
+void idleloop_run(DWORD (*pfnCpu)(DWORD), const BYTE* pCode, UINT uCodeSize, bool bSkip, IdleLoopResult& res)
+{
+	reset();
+	memset(mem, 0, 64*1024);
+	memcpy(mem+0x0300, pCode, uCodeSize);
+	mem[0x4E] = 0xF0;	// RNDL: wraps during the loop
+	mem[0x4F] = 0x12;	// RNDH
+
+	IORead[0] = fn_IdleLoop_C000;
+	IORead[1] = fn_IdleLoop_C019;
+	g_uIdleLoopReads = 0;
+	g_uIdleLoopLastReadCycle = 0;
+
+	g_bIdleLoopSkip = bSkip;
+	g_uIdleLoopEndCycle = kIdleLoopTotalCycles;
+	g_uNextEventCycle = kIdleLoopChangeCycle;
+	g_uTestVblChangeCycle = kIdleLoopChangeCycle;
+
+	res.uCycles = pfnCpu(kIdleLoopTotalCycles);
+	res.uReads = g_uIdleLoopReads;
+	res.uLastReadCycle = g_uIdleLoopLastReadCycle;
+	res.regs = regs;
+	res.zp[0] = mem[0x4E];
+	res.zp[1] = mem[0x4F];
+
+	IORead[0] = NULL;
+	IORead[1] = NULL;
+	g_bIdleLoopSkip = false;
+}
+
+// Returns: 0 = same as full emulation, and iterations were skipped (or not, if !bExpectSkip)
+int idleloop_compare(const BYTE* pCode, UINT uCodeSize, bool bExpectSkip)
+{
+	DWORD (*pfnCpus[])(DWORD) = { TestCpu6502, TestCpu65C02 };
+
+	for (UINT i=0; i<sizeof(pfnCpus)/sizeof(pfnCpus[0]); i++)
+	{
+		IdleLoopResult full, skip;
+		idleloop_run(pfnCpus[i], pCode, uCodeSize, false, full);
+		idleloop_run(pfnCpus[i], pCode, uCodeSize, true, skip);
+
+		if (full.uLastReadCycle < kIdleLoopChangeCycle/2) return 1;	// Loop must have run for a while
+		if (skip.uCycles != full.uCycles) return 1;
+		if (skip.uLastReadCycle != full.uLastReadCycle) return 1;
+		if (skip.regs.a != full.regs.a || skip.regs.x != full.regs.x || skip.regs.y != full.regs.y) return 1;
+		if (skip.regs.ps != full.regs.ps || skip.regs.pc != full.regs.pc || skip.regs.sp != full.regs.sp) return 1;
+		if (skip.zp[0] != full.zp[0] || skip.zp[1] != full.zp[1]) return 1;
+
+		if (bExpectSkip ? (skip.uReads >= full.uReads) : (skip.uReads != full.uReads)) return 1;
+	}
+
+	return 0;
+}
+
+const BYTE g_idleloop_kbd[] =
+{
+// org $0300
+0xAD, 0x00, 0xC0,	// l1: lda $c000
+0x10, 0xFB,			//   bpl l1
+0x4C, 0x05, 0x03	// l2: jmp l2
+};
+
+const BYTE g_idleloop_keyin[] =
+{
+// org $0300 (Monitor's KEYIN)
+0xE6, 0x4E,			// l1: inc $4e
+0xD0, 0x02,			//   bne l2
+0xE6, 0x4F,			//   inc $4f
+0x2C, 0x00, 0xC0,	// l2: bit $c000
+0x10, 0xF5,			//   bpl l1
+0x4C, 0x0B, 0x03	// l3: jmp l3
+};
+
+const BYTE g_idleloop_vbl_bpl[] =
+{
+// org $0300
+0x2C, 0x19, 0xC0,	// l1: bit $c019
+0x10, 0xFB,			//   bpl l1
+0x4C, 0x05, 0x03	// l2: jmp l2
+};
+
+const BYTE g_idleloop_vbl_bvc[] =
+{
+// org $0300
+0x2C, 0x19, 0xC0,	// l1: bit $c019
+0x50, 0xFB,			//   bvc l1		; bit 6 is the floating bus
+0x4C, 0x05, 0x03	// l2: jmp l2
+};
+
+int IdleLoop_test(void)
+{
+	int res = idleloop_compare(g_idleloop_kbd, sizeof(g_idleloop_kbd), true);
+	if (res) return res;
+
+	res = idleloop_compare(g_idleloop_keyin, sizeof(g_idleloop_keyin), true);
+	if (res) return res;
+
+	res = idleloop_compare(g_idleloop_vbl_bpl, sizeof(g_idleloop_vbl_bpl), true);
+	if (res) return res;
+
+	// Floating bus: mustn't be skipped
+	res = idleloop_compare(g_idleloop_vbl_bvc, sizeof(g_idleloop_vbl_bvc), false);
+	if (res) return res;
+
+	// Apple II: $C019 isn't VBL'
+	g_Apple2Type = A2TYPE_APPLE2PLUS;
+	res = idleloop_compare(g_idleloop_vbl_bpl, sizeof(g_idleloop_vbl_bpl), false);
+	g_Apple2Type = A2TYPE_APPLE2EENHANCED;
+	if (res) return res;
+
+	// IRQ pending (and enabled): mustn't be skipped
+	g_bmIRQ = 1;
+	res = idleloop_compare(g_idleloop_kbd, sizeof(g_idleloop_kbd), false);
+	g_bmIRQ = 0;
+	if (res) return res;
+
+	reset();
+	return 0;
+}
+
 //-------------------------------------
 
 int _tmain(int argc, _TCHAR* argv[])
@@ -1266,5 +1792,20 @@ int _tmain(int argc, _TCHAR* argv[])
 	res = GH292_test();
 	if (res) return res;
 
+	res = Predecode_test();
+	if (res) return res;
+
+	res = PredecodeBlocks_test();
+	if (res) return res;
+
+	res = VideoLog_test();
+	if (res) return res;
+
+	res = Flags_test();
+	if (res) return res;
+
+	res = IdleLoop_test();
+	if (res) return res;
+
 	return 0;
 }
@@ -16,9 +16,19 @@ regsrec regs;
 HWND   g_hFrameWindow   = (HWND)0;
 
 // From Memory.cpp
-LPBYTE         mem          = NULL;	// TODO: Init
+LPBYTE         mem          = NULL;	// Flat RAM: the CPU's view of memory
 LPBYTE         memdirty     = NULL;	// TODO: Init
 
+LPBYTE MemGetReadPtr(const WORD addr)
+{
+	return mem+addr;
+}
+
+WORD MemReadWord(const WORD addr)
+{
+	return *MemGetReadPtr(addr) | (*MemGetReadPtr(addr+1) << 8);
+}
+
 //-------------------------------------
 
 // From Debugger_Console.cpp